@@ -20,6 +20,8 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/io/WKTReader.h>
 #include <geos/geom/Geometry.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/PackedCoordinateSequence.h>
 #include <geos/geomgraph/DirectedEdge.h>
 #include <geos/geomgraph/EdgeEnd.h>
 #include <geos/geomgraph/PlanarGraph.h>
@@ -37,6 +39,8 @@ using namespace geos;
 int
 main()
 {
+    check(geom::CoordinateArraySequence);
+    check(geom::PackedCoordinateSequence);
     check(geomgraph::PlanarGraph);
     check(geomgraph::EdgeEnd);
     check(geomgraph::DirectedEdge);
@@ -0,0 +1,194 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares the double-double predicates of CGAlgorithmsDD with the
+ * ttmath bigfloat arithmetic they replaced, on nearly-collinear input
+ * that always defeats the double-precision orientation filter.
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/CGAlgorithmsDD.h>
+#include <geos/algorithm/ttmath/ttmath.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/math/DD.h>
+#include <geos/profiler.h>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+using geos::algorithm::CGAlgorithmsDD;
+using geos::geom::Coordinate;
+
+namespace {
+
+// The extended precision type formerly used by CGAlgorithmsDD
+typedef ttmath::Big<TTMATH_BITS(32), TTMATH_BITS(128)> BigDD;
+
+int
+orientationIndexTTMath(const Coordinate& p1, const Coordinate& p2, const Coordinate& q)
+{
+    BigDD dx1 = BigDD(p2.x) + BigDD(-p1.x);
+    BigDD dy1 = BigDD(p2.y) + BigDD(-p1.y);
+    BigDD dx2 = BigDD(q.x) + BigDD(-p2.x);
+    BigDD dy2 = BigDD(q.y) + BigDD(-p2.y);
+
+    BigDD d = (dx1 * dy2) - (dy1 * dx2);
+    static BigDD const zero(0.0);
+    if(d < zero) {
+        return -1;
+    }
+    if(d > zero) {
+        return 1;
+    }
+    return 0;
+}
+
+int
+orientationIndexDD(const Coordinate& p1, const Coordinate& p2, const Coordinate& q)
+{
+    using geos::math::DD;
+    DD dx1 = DD(p2.x) + -p1.x;
+    DD dy1 = DD(p2.y) + -p1.y;
+    DD dx2 = DD(q.x) + -p2.x;
+    DD dy2 = DD(q.y) + -p2.y;
+    return DD::determinant(dx1, dy1, dx2, dy2).signum();
+}
+
+void
+intersectionTTMath(const Coordinate& p1, const Coordinate& p2,
+                   const Coordinate& q1, const Coordinate& q2,
+                   Coordinate& rv)
+{
+    BigDD qdy = BigDD(q2.y) - BigDD(q1.y);
+    BigDD qdx = BigDD(q2.x) - BigDD(q1.x);
+    BigDD pdy = BigDD(p2.y) - BigDD(p1.y);
+    BigDD pdx = BigDD(p2.x) - BigDD(p1.x);
+
+    BigDD denom = (qdy * pdx) - (qdx * pdy);
+
+    BigDD numx = qdx * (BigDD(p1.y) - BigDD(q1.y)) - qdy * (BigDD(p1.x) - BigDD(q1.x));
+    BigDD x = BigDD(p1.x) + pdx * (numx / denom);
+
+    BigDD numy = pdx * (BigDD(p1.y) - BigDD(q1.y)) - pdy * (BigDD(p1.x) - BigDD(q1.x));
+    BigDD y = BigDD(q1.y) + qdy * (numy / denom);
+
+    rv.x = x.ToDouble();
+    rv.y = y.ToDouble();
+}
+
+struct Triple {
+    Coordinate p1, p2, q;
+};
+
+}
+
+class CGAlgorithmsDDPerfTest {
+
+public:
+    void test(std::size_t n)
+    {
+        std::default_random_engine e(12345);
+        std::uniform_real_distribution<> dis(-1e6, 1e6);
+        std::uniform_real_distribution<> frac(0, 1);
+
+        // Points on (or within an ulp or two of) a random line, far
+        // from the origin, so that the fast filter cannot decide.
+        std::vector<Triple> triples;
+        triples.reserve(n);
+        while(triples.size() < n) {
+            Coordinate p1(dis(e), dis(e));
+            Coordinate p2(dis(e), dis(e));
+            double f = frac(e);
+            Coordinate q(p1.x + f * (p2.x - p1.x), p1.y + f * (p2.y - p1.y));
+            if(CGAlgorithmsDD::orientationIndexFilter(p1, p2, q) <= 1) {
+                continue;
+            }
+            triples.push_back(Triple{p1, p2, q});
+        }
+
+        std::cout << "Orientation index of " << n << " nearly-collinear triples" << std::endl;
+
+        int sumTT = 0;
+        geos::util::Profile swTT("ttmath");
+        swTT.start();
+        for(const auto& t : triples) {
+            sumTT += orientationIndexTTMath(t.p1, t.p2, t.q);
+        }
+        swTT.stop();
+        report(swTT, sumTT);
+
+        int sumDD = 0;
+        geos::util::Profile swDD("DD");
+        swDD.start();
+        for(const auto& t : triples) {
+            sumDD += orientationIndexDD(t.p1, t.p2, t.q);
+        }
+        swDD.stop();
+        report(swDD, sumDD);
+
+        int sumAlg = 0;
+        geos::util::Profile swAlg("CGAlgorithmsDD::orientationIndex");
+        swAlg.start();
+        for(const auto& t : triples) {
+            sumAlg += CGAlgorithmsDD::orientationIndex(t.p1, t.p2, t.q);
+        }
+        swAlg.stop();
+        report(swAlg, sumAlg);
+
+        std::size_t mismatches = 0;
+        for(const auto& t : triples) {
+            if(orientationIndexTTMath(t.p1, t.p2, t.q) != orientationIndexDD(t.p1, t.p2, t.q)) {
+                mismatches++;
+            }
+        }
+        std::cout << "orientation mismatches: " << mismatches << std::endl;
+
+        std::cout << "Intersection of " << n << " segment pairs" << std::endl;
+
+        Coordinate rv;
+        double sumX = 0;
+        geos::util::Profile swTTi("ttmath");
+        swTTi.start();
+        for(std::size_t i = 1; i < triples.size(); i++) {
+            intersectionTTMath(triples[i - 1].p1, triples[i - 1].p2, triples[i].p1, triples[i].p2, rv);
+            sumX += rv.x;
+        }
+        swTTi.stop();
+        std::cout << swTTi.name << ": " << sumX << ": " << swTTi.getTotFormatted() << std::endl;
+
+        sumX = 0;
+        geos::util::Profile swDDi("CGAlgorithmsDD::intersection");
+        swDDi.start();
+        for(std::size_t i = 1; i < triples.size(); i++) {
+            CGAlgorithmsDD::intersection(triples[i - 1].p1, triples[i - 1].p2, triples[i].p1, triples[i].p2, rv);
+            sumX += rv.x;
+        }
+        swDDi.stop();
+        std::cout << swDDi.name << ": " << sumX << ": " << swDDi.getTotFormatted() << std::endl;
+
+        std::cout << std::endl;
+    }
+
+private:
+    void report(const geos::util::Profile& sw, int sum)
+    {
+        std::cout << sw.name << ": " << sum << ": " << sw.getTotFormatted() << std::endl;
+    }
+};
+
+int main() {
+    CGAlgorithmsDDPerfTest tester;
+
+    tester.test(100000);
+    tester.test(1000000);
+}
@@ -0,0 +1,123 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares coordinate loops (Length, Area, envelope expansion and
+ * monotone chain building) over CoordinateArraySequence and
+ * PackedCoordinateSequence.
+ *
+ **********************************************************************/
+
+#include <geos/algorithm/Area.h>
+#include <geos/algorithm/Length.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/index/chain/MonotoneChain.h>
+#include <geos/index/chain/MonotoneChainBuilder.h>
+#include <geos/profiler.h>
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace geos::geom;
+
+class PackedCoordinateSequencePerfTest {
+
+public:
+    void test(std::size_t num_points, int iterations)
+    {
+        std::default_random_engine e(12345);
+        std::uniform_real_distribution<> dis(-1, 1);
+
+        // a closed random walk
+        std::vector<Coordinate> coords;
+        coords.reserve(num_points + 1);
+        double x = 0, y = 0;
+        for(std::size_t i = 0; i < num_points; i++) {
+            x += dis(e);
+            y += dis(e);
+            coords.emplace_back(x, y);
+        }
+        coords.push_back(coords.front());
+
+        CoordinateArraySequence array(new std::vector<Coordinate>(coords));
+        PackedCoordinateSequence packed(coords);
+
+        std::cout << num_points << " points, " << iterations << " iterations" << std::endl;
+        run("CoordinateArraySequence", array, iterations);
+        run("PackedCoordinateSequence", packed, iterations);
+        std::cout << std::endl;
+    }
+
+private:
+    void run(const std::string& name, const CoordinateSequence& seq, int iterations)
+    {
+        using geos::algorithm::Area;
+        using geos::algorithm::Length;
+        using geos::index::chain::MonotoneChainBuilder;
+
+        double sum = 0;
+        geos::util::Profile swLength(name + " Length::ofLine");
+        swLength.start();
+        for(int i = 0; i < iterations; i++) {
+            sum += Length::ofLine(&seq);
+        }
+        swLength.stop();
+        report(swLength, sum);
+
+        sum = 0;
+        geos::util::Profile swArea(name + " Area::ofRingSigned");
+        swArea.start();
+        for(int i = 0; i < iterations; i++) {
+            sum += Area::ofRingSigned(&seq);
+        }
+        swArea.stop();
+        report(swArea, sum);
+
+        sum = 0;
+        geos::util::Profile swEnv(name + " expandEnvelope");
+        swEnv.start();
+        for(int i = 0; i < iterations; i++) {
+            Envelope env;
+            seq.expandEnvelope(env);
+            sum += env.getWidth();
+        }
+        swEnv.stop();
+        report(swEnv, sum);
+
+        sum = 0;
+        geos::util::Profile swChains(name + " getChainStartIndices");
+        swChains.start();
+        for(int i = 0; i < iterations; i++) {
+            std::vector<std::size_t> startIndex;
+            MonotoneChainBuilder::getChainStartIndices(seq, startIndex);
+            sum += static_cast<double>(startIndex.size());
+        }
+        swChains.stop();
+        report(swChains, sum);
+    }
+
+    void report(const geos::util::Profile& sw, double result)
+    {
+        std::cout << sw.name << ": " << result << ": " << sw.getTotFormatted() << std::endl;
+    }
+};
+
+int main() {
+    PackedCoordinateSequencePerfTest tester;
+
+    tester.test(1000, 10000);
+    tester.test(1000000, 10);
+}
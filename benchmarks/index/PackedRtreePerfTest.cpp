@@ -0,0 +1,184 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares bulk load time, memory per item and query throughput of
+ * STRtree and of PackedRtree with STR and Hilbert packing.
+ *
+ * Usage: perf_packed_rtree [num_items [num_queries]]
+ *
+ **********************************************************************/
+
+#include <geos/geom/Envelope.h>
+#include <geos/index/strtree/PackedRtree.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/profiler.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using geos::geom::Envelope;
+using geos::index::strtree::PackedRtree;
+using geos::index::strtree::STRtree;
+
+// Track the bytes currently allocated, to measure index memory use.
+// Each block is prefixed with its size.
+static std::size_t liveBytes = 0;
+static const std::size_t headerSize = 16;
+
+void*
+operator new(std::size_t size)
+{
+    char* p = static_cast<char*>(std::malloc(size + headerSize));
+    if(!p) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t*>(p) = size;
+    liveBytes += size;
+    return p + headerSize;
+}
+
+void
+operator delete(void* p) noexcept
+{
+    if(!p) {
+        return;
+    }
+    char* block = static_cast<char*>(p) - headerSize;
+    liveBytes -= *reinterpret_cast<std::size_t*>(block);
+    std::free(block);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+class PackedRtreePerfTest {
+
+public:
+    PackedRtreePerfTest(std::size_t num_items, std::size_t num_queries)
+    {
+        std::default_random_engine e(12345);
+        std::uniform_real_distribution<> pos(0, 1000);
+        std::uniform_real_distribution<> extent(0, 1);
+
+        items.reserve(num_items);
+        for(std::size_t i = 0; i < num_items; i++) {
+            double x = pos(e);
+            double y = pos(e);
+            items.emplace_back(x, x + extent(e), y, y + extent(e));
+        }
+        queries.reserve(num_queries);
+        for(std::size_t i = 0; i < num_queries; i++) {
+            double x = pos(e);
+            double y = pos(e);
+            queries.emplace_back(x, x + 5, y, y + 5);
+        }
+
+        std::cout << num_items << " items, " << num_queries << " queries" << std::endl;
+    }
+
+    void
+    testSTRtree()
+    {
+        std::size_t before = liveBytes;
+        geos::util::Profile swLoad("STRtree load");
+        swLoad.start();
+        STRtree tree;
+        for(auto& env : items) {
+            tree.insert(&env, &env);
+        }
+        tree.build();
+        swLoad.stop();
+        std::size_t bytes = liveBytes - before;
+
+        std::size_t hits = 0;
+        std::vector<void*> found;
+        geos::util::Profile swQuery("STRtree query");
+        swQuery.start();
+        for(auto& q : queries) {
+            found.clear();
+            tree.query(&q, found);
+            hits += found.size();
+        }
+        swQuery.stop();
+
+        report(swLoad, swQuery, bytes, hits);
+    }
+
+    void
+    testPacked(const std::string& name, PackedRtree::Packing packing)
+    {
+        std::size_t before = liveBytes;
+        geos::util::Profile swLoad(name + " load");
+        swLoad.start();
+        PackedRtree tree(10, packing);
+        for(auto& env : items) {
+            tree.insert(&env, &env);
+        }
+        tree.build();
+        swLoad.stop();
+        std::size_t bytes = liveBytes - before;
+
+        std::size_t hits = 0;
+        std::vector<void*> found;
+        geos::util::Profile swQuery(name + " query");
+        swQuery.start();
+        for(auto& q : queries) {
+            found.clear();
+            tree.query(q, found);
+            hits += found.size();
+        }
+        swQuery.stop();
+
+        report(swLoad, swQuery, bytes, hits);
+    }
+
+private:
+    std::vector<Envelope> items;
+    std::vector<Envelope> queries;
+
+    void
+    report(const geos::util::Profile& load, const geos::util::Profile& query,
+           std::size_t bytes, std::size_t hits)
+    {
+        double seconds = query.getTot() / 1e6;
+        std::cout << load.name << ": " << load.getTotFormatted() << std::endl;
+        std::cout << "  bytes per item: "
+                  << static_cast<double>(bytes) / static_cast<double>(items.size()) << std::endl;
+        std::cout << query.name << ": " << hits << " hits: " << query.getTotFormatted()
+                  << " (" << static_cast<double>(queries.size()) / seconds << " queries/s)" << std::endl;
+    }
+};
+
+int
+main(int argc, char** argv)
+{
+    std::size_t num_items = 1000000;
+    std::size_t num_queries = 100000;
+    if(argc > 1) {
+        num_items = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+    if(argc > 2) {
+        num_queries = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+    }
+
+    PackedRtreePerfTest tester(num_items, num_queries);
+    tester.testSTRtree();
+    tester.testPacked("PackedRtree (STR)", PackedRtree::SORT_TILE_RECURSIVE);
+    tester.testPacked("PackedRtree (Hilbert)", PackedRtree::HILBERT);
+}
@@ -0,0 +1,136 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Measures the cost of Geometry::getEnvelopeInternal() as seen by
+ * callers that touch many small geometries: bulk loading an STRtree
+ * and filtering candidate pairs by envelope before running a predicate.
+ *
+ * Usage: perf_strtree_envelope [num_geometries]
+ *
+ * The default of 1M points runs in seconds. Pass 10000000 to measure at
+ * the scale of large tree builds; it needs about 3 GB of memory.
+ *
+ **********************************************************************/
+
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Point.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/profiler.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace geos::geom;
+using geos::index::strtree::STRtree;
+
+class STRtreeEnvelopePerfTest {
+
+public:
+    STRtreeEnvelopePerfTest()
+        : factory(GeometryFactory::create())
+    {}
+
+    void test(std::size_t num_geoms)
+    {
+        std::default_random_engine e(12345);
+        std::uniform_real_distribution<> dis(0, 1000);
+
+        std::vector<std::unique_ptr<Geometry>> points;
+        points.reserve(num_geoms);
+        for(std::size_t i = 0; i < num_geoms; i++) {
+            points.emplace_back(factory->createPoint(Coordinate(dis(e), dis(e))));
+        }
+
+        std::cout << num_geoms << " points" << std::endl;
+
+        geos::util::Profile swEnv("first getEnvelopeInternal");
+        swEnv.start();
+        double sum = 0;
+        for(const auto& g : points) {
+            sum += g->getEnvelopeInternal()->getMinX();
+        }
+        swEnv.stop();
+        report(swEnv, sum);
+
+        STRtree tree;
+        geos::util::Profile swLoad("STRtree insert + build");
+        swLoad.start();
+        for(const auto& g : points) {
+            tree.insert(g->getEnvelopeInternal(), g.get());
+        }
+        tree.build();
+        swLoad.stop();
+        report(swLoad, static_cast<double>(points.size()));
+
+        // Query each point with a small window and keep the hits whose
+        // envelope intersects the query geometry, as predicate
+        // short-circuits do.
+        std::size_t hits = 0;
+        geos::util::Profile swQuery("STRtree query + envelope filter");
+        swQuery.start();
+        std::vector<void*> found;
+        for(std::size_t i = 0; i < num_geoms; i += 100) {
+            const Envelope* qe = points[i]->getEnvelopeInternal();
+            Envelope search(qe->getMinX() - 1, qe->getMaxX() + 1,
+                            qe->getMinY() - 1, qe->getMaxY() + 1);
+            found.clear();
+            tree.query(&search, found);
+            for(void* item : found) {
+                const Geometry* g = static_cast<const Geometry*>(item);
+                if(search.intersects(g->getEnvelopeInternal())) {
+                    hits++;
+                }
+            }
+        }
+        swQuery.stop();
+        report(swQuery, static_cast<double>(hits));
+
+        std::size_t pairs = 0;
+        geos::util::Profile swPred("envelope-rejected intersects");
+        swPred.start();
+        for(std::size_t i = 1; i < num_geoms; i++) {
+            if(points[i - 1]->intersects(points[i].get())) {
+                pairs++;
+            }
+        }
+        swPred.stop();
+        report(swPred, static_cast<double>(pairs));
+
+        std::cout << std::endl;
+    }
+
+private:
+    GeometryFactory::Ptr factory;
+
+    void report(const geos::util::Profile& sw, double result)
+    {
+        std::cout << sw.name << ": " << result << ": " << sw.getTotFormatted() << std::endl;
+    }
+};
+
+int
+main(int argc, char** argv)
+{
+    std::size_t n = 1000000;
+    if(argc > 1) {
+        n = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    STRtreeEnvelopePerfTest tester;
+    tester.test(n);
+}
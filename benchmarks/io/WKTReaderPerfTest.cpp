@@ -0,0 +1,140 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Measures WKTReader throughput on a synthetic corpus of multipolygons,
+ * once with coordinates printed at a fixed number of decimals (as CSV
+ * exports usually carry them) and once as written by WKTWriter.
+ *
+ * Usage: perf_wktreader [num_multipolygons]
+ *
+ **********************************************************************/
+
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/io/WKTReader.h>
+#include <geos/io/WKTWriter.h>
+#include <geos/profiler.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace geos::geom;
+
+class WKTReaderPerfTest {
+
+public:
+    WKTReaderPerfTest()
+        : factory(GeometryFactory::create())
+    {}
+
+    void test(std::size_t num_geoms)
+    {
+        std::vector<std::string> corpus = makeCorpus(num_geoms);
+        run("WKTReader, 7 decimals", corpus);
+
+        // Round trip through WKTWriter to get its full precision output
+        geos::io::WKTReader reader(*factory);
+        geos::io::WKTWriter writer;
+        for(std::string& wkt : corpus) {
+            std::unique_ptr<Geometry> g(reader.read(wkt));
+            wkt = writer.write(g.get());
+        }
+        run("WKTReader, WKTWriter output", corpus);
+
+        std::cout << std::endl;
+    }
+
+private:
+    GeometryFactory::Ptr factory;
+
+    std::vector<std::string> makeCorpus(std::size_t num_geoms)
+    {
+        std::default_random_engine e(12345);
+        std::uniform_real_distribution<> centre(-180, 180);
+        std::uniform_real_distribution<> radius(0.001, 0.1);
+
+        const int polysPerGeom = 4;
+        const int ptsPerRing = 64;
+        const double pi = 3.14159265358979323846;
+
+        std::vector<std::string> corpus;
+        corpus.reserve(num_geoms);
+        char buf[64];
+        for(std::size_t i = 0; i < num_geoms; i++) {
+            std::string wkt = "MULTIPOLYGON (";
+            for(int p = 0; p < polysPerGeom; p++) {
+                double cx = centre(e);
+                double cy = centre(e) / 2;
+                wkt += p ? ", ((" : "((";
+                double x0 = 0, y0 = 0;
+                for(int k = 0; k < ptsPerRing; k++) {
+                    double a = 2 * pi * k / ptsPerRing;
+                    double r = radius(e);
+                    double x = cx + r * std::cos(a);
+                    double y = cy + r * std::sin(a);
+                    if(k == 0) {
+                        x0 = x;
+                        y0 = y;
+                    }
+                    std::snprintf(buf, sizeof(buf), "%.7f %.7f, ", x, y);
+                    wkt += buf;
+                }
+                std::snprintf(buf, sizeof(buf), "%.7f %.7f))", x0, y0);
+                wkt += buf;
+            }
+            wkt += ")";
+            corpus.push_back(wkt);
+        }
+        return corpus;
+    }
+
+    void run(const std::string& label, const std::vector<std::string>& corpus)
+    {
+        std::size_t bytes = 0;
+        for(const std::string& wkt : corpus) {
+            bytes += wkt.size();
+        }
+
+        geos::io::WKTReader reader(*factory);
+        std::size_t points = 0;
+        geos::util::Profile sw(label);
+        sw.start();
+        for(const std::string& wkt : corpus) {
+            std::unique_ptr<Geometry> g(reader.read(wkt));
+            points += g->getNumPoints();
+        }
+        sw.stop();
+
+        double secs = sw.getTot() / 1e6;
+        std::cout << sw.name << ": " << points << " points, "
+                  << static_cast<double>(bytes) / (1024 * 1024) / secs << " MB/s: "
+                  << sw.getTotFormatted() << std::endl;
+    }
+};
+
+int
+main(int argc, char** argv)
+{
+    std::size_t n = 20000;
+    if(argc > 1) {
+        n = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));
+    }
+
+    WKTReaderPerfTest tester;
+    tester.test(n);
+}
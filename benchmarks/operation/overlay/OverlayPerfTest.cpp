@@ -0,0 +1,129 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Times overlays of 2D polygons, which compute no Z, and of the same
+ * polygons with Z values.
+ *
+ * Usage: perf_overlay [num_points [num_iterations]]
+ *
+ **********************************************************************/
+
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/util/SineStarFactory.h>
+#include <geos/profiler.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using geos::geom::Coordinate;
+using geos::geom::Geometry;
+using geos::geom::GeometryFactory;
+using geos::geom::Polygon;
+
+// Gives every coordinate a Z value
+class SetZFilter: public geos::geom::CoordinateFilter {
+public:
+    void
+    filter_rw(Coordinate* c) const override
+    {
+        c->z = c->x + c->y;
+    }
+};
+
+class OverlayPerfTest {
+
+public:
+    OverlayPerfTest(int num_points, int num_iterations)
+        :
+        fact(GeometryFactory::create()),
+        iterations(num_iterations)
+    {
+        a = createSineStar(Coordinate(0, 0), num_points);
+        b = createSineStar(Coordinate(30, 20), num_points);
+
+        a3d = createSineStar(Coordinate(0, 0), num_points);
+        b3d = createSineStar(Coordinate(30, 20), num_points);
+        SetZFilter setZ;
+        a3d->apply_rw(&setZ);
+        b3d->apply_rw(&setZ);
+
+        std::cout << num_points << " points per polygon, "
+                  << iterations << " iterations" << std::endl;
+    }
+
+    void
+    test()
+    {
+        test("2D", *a, *b);
+        test("3D", *a3d, *b3d);
+    }
+
+private:
+    GeometryFactory::Ptr fact;
+    int iterations;
+    std::unique_ptr<Polygon> a;
+    std::unique_ptr<Polygon> b;
+    std::unique_ptr<Polygon> a3d;
+    std::unique_ptr<Polygon> b3d;
+
+    void
+    test(const std::string& name, const Geometry& g0, const Geometry& g1)
+    {
+        std::size_t numPoints = 0;
+        geos::util::Profile sw(name + " intersection/union");
+        sw.start();
+        for(int i = 0; i < iterations; i++) {
+            numPoints += g0.intersection(&g1)->getNumPoints();
+            numPoints += g0.Union(&g1)->getNumPoints();
+        }
+        sw.stop();
+
+        std::cout << sw.name << " (coordinate dimension "
+                  << g0.getCoordinateDimension() << "): "
+                  << numPoints << " result points: "
+                  << sw.getTotFormatted() << std::endl;
+    }
+
+    std::unique_ptr<Polygon>
+    createSineStar(const Coordinate& origin, int nPts)
+    {
+        geos::geom::util::SineStarFactory gsf(fact.get());
+        gsf.setCentre(origin);
+        gsf.setSize(100);
+        gsf.setNumPoints(nPts);
+        gsf.setArmLengthRatio(0.3);
+        gsf.setNumArms(20);
+        return gsf.createSineStar();
+    }
+};
+
+int
+main(int argc, char** argv)
+{
+    int num_points = 1000;
+    int num_iterations = 200;
+    if(argc > 1) {
+        num_points = std::atoi(argv[1]);
+    }
+    if(argc > 2) {
+        num_iterations = std::atoi(argv[2]);
+    }
+
+    OverlayPerfTest tester(num_points, num_iterations);
+    tester.test();
+}
@@ -210,6 +210,13 @@ extern "C" {
         return GEOSRelatePattern_r(handle, g1, g2, pat);
     }
 
+    int
+    GEOSRelatePatternMany(const Geometry** g1, const Geometry** g2, size_t n,
+                          const char* pat, char* out, unsigned int numThreads)
+    {
+        return GEOSRelatePatternMany_r(handle, g1, g2, n, pat, out, numThreads);
+    }
+
     char
     GEOSRelatePatternMatch(const char* mat, const char* pat)
     {
@@ -499,12 +506,42 @@ extern "C" {
         return GEOSUnion_r(handle, g1, g2);
     }
 
+    Geometry*
+    GEOSIntersectionPrec(const Geometry* g1, const Geometry* g2, double gridSize)
+    {
+        return GEOSIntersectionPrec_r(handle, g1, g2, gridSize);
+    }
+
+    Geometry*
+    GEOSDifferencePrec(const Geometry* g1, const Geometry* g2, double gridSize)
+    {
+        return GEOSDifferencePrec_r(handle, g1, g2, gridSize);
+    }
+
+    Geometry*
+    GEOSSymDifferencePrec(const Geometry* g1, const Geometry* g2, double gridSize)
+    {
+        return GEOSSymDifferencePrec_r(handle, g1, g2, gridSize);
+    }
+
+    Geometry*
+    GEOSUnionPrec(const Geometry* g1, const Geometry* g2, double gridSize)
+    {
+        return GEOSUnionPrec_r(handle, g1, g2, gridSize);
+    }
+
     Geometry*
     GEOSUnaryUnion(const Geometry* g)
     {
         return GEOSUnaryUnion_r(handle, g);
     }
 
+    Geometry*
+    GEOSUnaryUnionParallel(const Geometry* g, unsigned int numThreads)
+    {
+        return GEOSUnaryUnionParallel_r(handle, g, numThreads);
+    }
+
     Geometry*
     GEOSCoverageUnion(const Geometry* g)
     {
@@ -517,6 +554,12 @@ extern "C" {
         return GEOSNode_r(handle, g);
     }
 
+    Geometry*
+    GEOSNodeParallel(const Geometry* g, unsigned int numThreads)
+    {
+        return GEOSNodeParallel_r(handle, g, numThreads);
+    }
+
     Geometry*
     GEOSUnionCascaded(const Geometry* g)
     {
@@ -821,6 +864,31 @@ extern "C" {
         return GEOSCoordSeq_create_r(handle, size, dims);
     }
 
+    CoordinateSequence*
+    GEOSCoordSeq_copyFromBuffer(const double* buf, unsigned int size, int hasZ)
+    {
+        return GEOSCoordSeq_copyFromBuffer_r(handle, buf, size, hasZ);
+    }
+
+    CoordinateSequence*
+    GEOSCoordSeq_copyFromArrays(const double* x, const double* y, const double* z,
+                                unsigned int size)
+    {
+        return GEOSCoordSeq_copyFromArrays_r(handle, x, y, z, size);
+    }
+
+    int
+    GEOSCoordSeq_copyToBuffer(const CoordinateSequence* s, double* buf, int hasZ)
+    {
+        return GEOSCoordSeq_copyToBuffer_r(handle, s, buf, hasZ);
+    }
+
+    int
+    GEOSCoordSeq_copyToArrays(const CoordinateSequence* s, double* x, double* y, double* z)
+    {
+        return GEOSCoordSeq_copyToArrays_r(handle, s, x, y, z);
+    }
+
     int
     GEOSCoordSeq_setOrdinate(CoordinateSequence* s, unsigned int idx, unsigned int dim, double val)
     {
@@ -923,6 +991,25 @@ extern "C" {
         return GEOSGeom_createLineString_r(handle, cs);
     }
 
+    Geometry*
+    GEOSGeom_createLineStringFromBuffer(const double* buf, unsigned int size, int hasZ)
+    {
+        return GEOSGeom_createLineStringFromBuffer_r(handle, buf, size, hasZ);
+    }
+
+    Geometry*
+    GEOSGeom_createLinearRingFromBuffer(const double* buf, unsigned int size, int hasZ)
+    {
+        return GEOSGeom_createLinearRingFromBuffer_r(handle, buf, size, hasZ);
+    }
+
+    Geometry*
+    GEOSGeom_createPolygonFromBuffer(const double* buf, const unsigned int* ringSizes,
+                                     unsigned int nrings, int hasZ)
+    {
+        return GEOSGeom_createPolygonFromBuffer_r(handle, buf, ringSizes, nrings, hasZ);
+    }
+
     Geometry*
     GEOSGeom_createPolygon(Geometry* shell, Geometry** holes, unsigned int nholes)
     {
@@ -1115,6 +1202,13 @@ extern "C" {
         return GEOSWKBWriter_writeHEX_r(handle, writer, geom, size);
     }
 
+    size_t
+    GEOSWKBWriter_writeToBuffer(WKBWriter* writer, const Geometry* geom,
+                                unsigned char* buf, size_t bufSize)
+    {
+        return GEOSWKBWriter_writeToBuffer_r(handle, writer, geom, buf, bufSize);
+    }
+
     int
     GEOSWKBWriter_getOutputDimension(const GEOSWKBWriter* writer)
     {
@@ -1228,6 +1322,86 @@ extern "C" {
         return GEOSPreparedWithin_r(handle, pg1, g2);
     }
 
+    int
+    GEOSPreparedContainsMany(const geos::geom::prep::PreparedGeometry* pg,
+                             const Geometry** geoms, size_t n, char* out,
+                             unsigned int numThreads)
+    {
+        return GEOSPreparedContainsMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedContainsProperlyMany(const geos::geom::prep::PreparedGeometry* pg,
+                                     const Geometry** geoms, size_t n, char* out,
+                                     unsigned int numThreads)
+    {
+        return GEOSPreparedContainsProperlyMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedCoveredByMany(const geos::geom::prep::PreparedGeometry* pg,
+                              const Geometry** geoms, size_t n, char* out,
+                              unsigned int numThreads)
+    {
+        return GEOSPreparedCoveredByMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedCoversMany(const geos::geom::prep::PreparedGeometry* pg,
+                           const Geometry** geoms, size_t n, char* out,
+                           unsigned int numThreads)
+    {
+        return GEOSPreparedCoversMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedCrossesMany(const geos::geom::prep::PreparedGeometry* pg,
+                            const Geometry** geoms, size_t n, char* out,
+                            unsigned int numThreads)
+    {
+        return GEOSPreparedCrossesMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedDisjointMany(const geos::geom::prep::PreparedGeometry* pg,
+                             const Geometry** geoms, size_t n, char* out,
+                             unsigned int numThreads)
+    {
+        return GEOSPreparedDisjointMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedIntersectsMany(const geos::geom::prep::PreparedGeometry* pg,
+                               const Geometry** geoms, size_t n, char* out,
+                               unsigned int numThreads)
+    {
+        return GEOSPreparedIntersectsMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedOverlapsMany(const geos::geom::prep::PreparedGeometry* pg,
+                             const Geometry** geoms, size_t n, char* out,
+                             unsigned int numThreads)
+    {
+        return GEOSPreparedOverlapsMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedTouchesMany(const geos::geom::prep::PreparedGeometry* pg,
+                            const Geometry** geoms, size_t n, char* out,
+                            unsigned int numThreads)
+    {
+        return GEOSPreparedTouchesMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedWithinMany(const geos::geom::prep::PreparedGeometry* pg,
+                           const Geometry** geoms, size_t n, char* out,
+                           unsigned int numThreads)
+    {
+        return GEOSPreparedWithinMany_r(handle, pg, geoms, n, out, numThreads);
+    }
+
     STRtree*
     GEOSSTRtree_create(size_t nodeCapacity)
     {
@@ -1242,6 +1416,28 @@ extern "C" {
         GEOSSTRtree_insert_r(handle, tree, g, item);
     }
 
+    geos::index::strtree::STRtree*
+    GEOSSTRtree_createFromBounds(size_t nodeCapacity,
+                                 const double* xmin, const double* ymin,
+                                 const double* xmax, const double* ymax,
+                                 const size_t* ids, size_t n)
+    {
+        return GEOSSTRtree_createFromBounds_r(handle, nodeCapacity,
+                                              xmin, ymin, xmax, ymax, ids, n);
+    }
+
+    int
+    GEOSSTRtree_queryBounds(geos::index::strtree::STRtree* tree,
+                            const double* xmin, const double* ymin,
+                            const double* xmax, const double* ymax,
+                            size_t n, size_t* offsets,
+                            size_t* ids, size_t idsCapacity,
+                            size_t* numHits)
+    {
+        return GEOSSTRtree_queryBounds_r(handle, tree, xmin, ymin, xmax, ymax,
+                                         n, offsets, ids, idsCapacity, numHits);
+    }
+
     void
     GEOSSTRtree_query(geos::index::strtree::STRtree* tree,
                       const geos::geom::Geometry* g,
@@ -1267,6 +1463,32 @@ extern "C" {
         return GEOSSTRtree_nearest_generic_r(handle, tree, item, itemEnvelope, distancefn, userdata);
     }
 
+    int
+    GEOSSTRtree_nearest_k_generic(GEOSSTRtree* tree,
+                                  const void* item,
+                                  const GEOSGeometry* itemEnvelope,
+                                  GEOSDistanceCallback distancefn,
+                                  void* userdata,
+                                  unsigned int k,
+                                  const void** results)
+    {
+        return GEOSSTRtree_nearest_k_generic_r(handle, tree, item, itemEnvelope, distancefn,
+                                               userdata, k, results);
+    }
+
+    int
+    GEOSSTRtree_withinDistance_generic(GEOSSTRtree* tree,
+                                       const void* item,
+                                       const GEOSGeometry* itemEnvelope,
+                                       double maxDistance,
+                                       GEOSDistanceCallback distancefn,
+                                       GEOSQueryCallback callback,
+                                       void* userdata)
+    {
+        return GEOSSTRtree_withinDistance_generic_r(handle, tree, item, itemEnvelope, maxDistance,
+                                                    distancefn, callback, userdata);
+    }
+
     void
     GEOSSTRtree_iterate(geos::index::strtree::STRtree* tree,
                         GEOSQueryCallback callback,
@@ -17,10 +17,12 @@
  ***********************************************************************/
 
 #include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequenceFilter.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/prep/PreparedGeometry.h>
 #include <geos/geom/prep/PreparedGeometryFactory.h>
 #include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryComponentFilter.h>
 #include <geos/geom/Polygon.h>
 #include <geos/geom/Point.h>
 #include <geos/geom/MultiPoint.h>
@@ -32,9 +34,13 @@
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/PackedCoordinateSequenceFactory.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/IntersectionMatrix.h>
 #include <geos/geom/Envelope.h>
+#include <geos/index/strtree/FrozenSTRtree.h>
 #include <geos/index/strtree/STRtree.h>
 #include <geos/index/strtree/GeometryItemDistance.h>
 #include <geos/index/ItemVisitor.h>
@@ -68,6 +74,7 @@
 #include <geos/operation/sharedpaths/SharedPathsOp.h>
 #include <geos/operation/union/CascadedPolygonUnion.h>
 #include <geos/operation/union/CoverageUnion.h>
+#include <geos/operation/union/UnaryUnionOp.h>
 #include <geos/operation/valid/IsValidOp.h>
 #include <geos/operation/valid/MakeValid.h>
 #include <geos/precision/GeometryPrecisionReducer.h>
@@ -80,10 +87,12 @@
 #include <geos/util/Machine.h>
 #include <geos/version.h>
 
+#include <algorithm>
 // This should go away
 #include <cmath> // finite
 #include <cstdarg>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -92,6 +101,9 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4099)
@@ -132,6 +144,7 @@ using geos::geom::LinearRing;
 using geos::geom::MultiLineString;
 using geos::geom::MultiPolygon;
 using geos::geom::Polygon;
+using geos::geom::Coordinate;
 using geos::geom::CoordinateSequence;
 using geos::geom::GeometryCollection;
 using geos::geom::GeometryFactory;
@@ -166,6 +179,7 @@ typedef struct GEOSContextHandle_HS {
     int WKBOutputDims;
     int WKBByteOrder;
     int initialized;
+    geos::util::InterruptState interruptState;
 
     GEOSContextHandle_HS()
         :
@@ -291,6 +305,24 @@ public:
     }
 };
 
+// STRtree built by the CAPI. Trees built by GEOSSTRtree_createFromBounds_r
+// own the envelopes their items were inserted with (STRtree only keeps
+// pointers to them). The snapshot GEOSSTRtree_queryBounds_r runs its
+// batches on is kept until an item is removed.
+class CAPI_STRtree : public geos::index::strtree::STRtree {
+public:
+    CAPI_STRtree(size_t p_nodeCapacity, size_t n = 0)
+        : STRtree(p_nodeCapacity)
+    {
+        envelopes.reserve(n);
+    }
+
+    // Never reallocated once the items are inserted
+    std::vector<geos::geom::Envelope> envelopes;
+
+    std::unique_ptr<geos::index::strtree::FrozenSTRtree> frozen;
+};
+
 
 //## PROTOTYPES #############################################
 
@@ -325,6 +357,314 @@ gstrdup(std::string const& str)
     return gstrdup_s(str.c_str(), str.size());
 }
 
+// ItemDistance calling a user-supplied GEOSDistanceCallback
+struct CustomItemDistance : public geos::index::strtree::ItemDistance {
+    CustomItemDistance(GEOSDistanceCallback p_distancefn, void* p_userdata)
+        : m_distancefn(p_distancefn), m_userdata(p_userdata) {}
+
+    GEOSDistanceCallback m_distancefn;
+    void* m_userdata;
+
+    double
+    distance(const geos::index::strtree::ItemBoundable* item1,
+             const geos::index::strtree::ItemBoundable* item2) override
+    {
+        const void* a = item1->getItem();
+        const void* b = item2->getItem();
+        double d;
+
+        if(!m_distancefn(a, b, &d, m_userdata)) {
+            throw std::runtime_error(std::string("Failed to compute distance."));
+        }
+
+        return d;
+    }
+};
+
+// Read-only streambuf over a caller-supplied buffer, to avoid copying it
+// http://stackoverflow.com/questions/2079912/simpler-way-to-create-a-c-memorystream-from-char-size-t-without-copying-t
+struct membuf : public std::streambuf {
+    membuf(char* s, std::size_t n)
+    {
+        setg(s, s, s + n);
+    }
+};
+
+// Reads every lazily computed cache of g (envelopes, coordinate
+// arrays) so that g can then be read from several threads at once
+struct CacheWarmingFilter : public geos::geom::CoordinateSequenceFilter {
+    void
+    filter_ro(const geos::geom::CoordinateSequence& seq, std::size_t i) override
+    {
+        if(i == 0) {
+            seq.getDimension();
+            seq.getAt(0);
+        }
+    }
+
+    void
+    filter_rw(geos::geom::CoordinateSequence&, std::size_t) override
+    {
+        assert(0);
+    }
+
+    bool
+    isDone() const override
+    {
+        return false;
+    }
+
+    bool
+    isGeometryChanged() const override
+    {
+        return false;
+    }
+};
+
+// Computes the envelopes of every component of a geometry, down to
+// the holes of polygons, which the top level envelope does not reach
+struct EnvelopeWarmingFilter : public geos::geom::GeometryComponentFilter {
+    void
+    filter_ro(const Geometry* g) override
+    {
+        g->getEnvelopeInternal();
+    }
+};
+
+void
+warmGeometryCaches(const Geometry* g)
+{
+    if(g) {
+        EnvelopeWarmingFilter envFilter;
+        g->apply_ro(&envFilter);
+        CacheWarmingFilter filter;
+        g->apply_ro(filter);
+    }
+}
+
+/*
+ * Evaluates a predicate for the n entries of a batch, splitting them
+ * into contiguous chunks run by up to numThreads threads.
+ *
+ * evalChunk(start, end, out, error) evaluates entries [start, end),
+ * stores 0, 1 or 2 in out[i] and the first exception message, if any,
+ * in error. Messages are reported through the context handle once all
+ * threads have finished, since the handlers are not thread-safe.
+ *
+ * Returns true if no entry raised an exception.
+ */
+template<class ChunkEvaluator>
+bool
+evaluateBatch(GEOSContextHandleInternal_t* handle, std::size_t n, char* out,
+              unsigned int numThreads, ChunkEvaluator evalChunk)
+{
+    std::size_t nchunks = numThreads > 1 ? std::min<std::size_t>(numThreads, n) : 1;
+    std::size_t chunkSize = nchunks ? (n + nchunks - 1) / nchunks : 0;
+    std::vector<std::string> errors(nchunks);
+
+    std::vector<std::thread> workers;
+    for(std::size_t t = 1; t < nchunks; ++t) {
+        std::size_t start = std::min(n, t * chunkSize);
+        std::size_t end = std::min(n, start + chunkSize);
+        try {
+            workers.emplace_back([handle, &evalChunk, &errors, out, t, start, end]() {
+                geos::util::Interrupt::Scope interruptScope(&handle->interruptState, false);
+                evalChunk(start, end, out, errors[t]);
+            });
+        }
+        catch(const std::system_error&) {
+            evalChunk(start, end, out, errors[t]);
+        }
+    }
+    if(nchunks > 0) {
+        evalChunk(0, std::min(n, chunkSize), out, errors[0]);
+    }
+    for(std::thread& w : workers) {
+        w.join();
+    }
+
+    for(const std::string& e : errors) {
+        if(!e.empty()) {
+            handle->ERROR_MESSAGE("%s", e.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stores the outcome of pred() in out, 2 and the first message on error
+template<class Predicate>
+void
+evaluateEntry(Predicate pred, char& out, std::string& error)
+{
+    try {
+        out = pred() ? 1 : 0;
+        return;
+    }
+    catch(const std::exception& e) {
+        if(error.empty()) {
+            error = e.what();
+        }
+    }
+    catch(...) {
+        if(error.empty()) {
+            error = "Unknown exception thrown";
+        }
+    }
+    out = 2;
+}
+
+typedef bool (geos::geom::prep::PreparedGeometry::*PreparedPredicate)(const Geometry*) const;
+
+int
+preparedPredicateMany(GEOSContextHandle_t extHandle,
+                      const geos::geom::prep::PreparedGeometry* pg,
+                      PreparedPredicate pred, const Geometry** geoms,
+                      std::size_t n, char* out, unsigned int numThreads)
+{
+    if(0 == extHandle) {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t* handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if(0 == handle->initialized) {
+        return 0;
+    }
+
+    geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
+    try {
+        if(numThreads > 1 && n > 1) {
+            warmGeometryCaches(&pg->getGeometry());
+            for(std::size_t i = 0; i < n; ++i) {
+                warmGeometryCaches(geoms[i]);
+            }
+        }
+
+        auto evalChunk = [pg, pred, geoms](std::size_t start, std::size_t end,
+                                           char* p_out, std::string& error) {
+            // Prepared geometries build their indexes lazily, so worker
+            // threads use their own copy of pg
+            std::unique_ptr<geos::geom::prep::PreparedGeometry> own;
+            const geos::geom::prep::PreparedGeometry* prep = pg;
+            if(start > 0) {
+                try {
+                    own = geos::geom::prep::PreparedGeometryFactory::prepare(&pg->getGeometry());
+                    prep = own.get();
+                }
+                catch(const std::exception& e) {
+                    error = e.what();
+                    std::fill(p_out + start, p_out + end, 2);
+                    return;
+                }
+            }
+            for(std::size_t i = start; i < end; ++i) {
+                const Geometry* g = geoms[i];
+                evaluateEntry([prep, pred, g]() {
+                    if(!g) {
+                        throw geos::util::IllegalArgumentException("Geometry is NULL");
+                    }
+                    return (prep->*pred)(g);
+                }, p_out[i], error);
+            }
+        };
+
+        return evaluateBatch(handle, n, out, numThreads, evalChunk) ? 1 : 0;
+    }
+    catch(const std::exception& e) {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch(...) {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 0;
+}
+
+static_assert(sizeof(geos::geom::Coordinate) == 3 * sizeof(double),
+              "Coordinate is expected to be three packed doubles");
+
+// Creates a sequence from size interleaved XY or XYZ coordinates,
+// using the sequence factory of gf
+std::unique_ptr<CoordinateSequence>
+coordSeqFromBuffer(const GeometryFactory* gf, const double* buf,
+                   std::size_t size, bool hasZ)
+{
+    std::size_t dims = hasZ ? 3 : 2;
+    const geos::geom::CoordinateSequenceFactory* csf = gf->getCoordinateSequenceFactory();
+
+    if(dynamic_cast<const geos::geom::PackedCoordinateSequenceFactory*>(csf)) {
+        std::vector<double> ords(buf, buf + size * dims);
+        return std::unique_ptr<CoordinateSequence>(
+                   new geos::geom::PackedCoordinateSequence(std::move(ords), dims));
+    }
+
+    std::unique_ptr<std::vector<Coordinate>> coords(new std::vector<Coordinate>(size));
+    if(hasZ) {
+        if(size > 0) {
+            std::memcpy(&(*coords)[0].x, buf, size * 3 * sizeof(double));
+        }
+    }
+    else {
+        for(std::size_t i = 0; i < size; ++i) {
+            (*coords)[i].x = buf[2 * i];
+            (*coords)[i].y = buf[2 * i + 1];
+        }
+    }
+    return csf->create(coords.release(), dims);
+}
+
+// Same as coordSeqFromBuffer from separate ordinate arrays, z may be null
+std::unique_ptr<CoordinateSequence>
+coordSeqFromArrays(const GeometryFactory* gf, const double* x,
+                   const double* y, const double* z, std::size_t size)
+{
+    std::unique_ptr<std::vector<Coordinate>> coords(new std::vector<Coordinate>(size));
+    for(std::size_t i = 0; i < size; ++i) {
+        Coordinate& c = (*coords)[i];
+        c.x = x[i];
+        c.y = y[i];
+        if(z) {
+            c.z = z[i];
+        }
+    }
+    return gf->getCoordinateSequenceFactory()->create(coords.release(), z ? 3 : 2);
+}
+
+// Copies the coordinates of cs to buf as interleaved XY or XYZ values
+void
+coordSeqToBuffer(const CoordinateSequence& cs, double* buf, bool hasZ)
+{
+    std::size_t size = cs.getSize();
+    if(size == 0) {
+        return;
+    }
+
+    std::size_t dims = hasZ ? 3 : 2;
+    const geos::geom::PackedCoordinateSequence* packed =
+        dynamic_cast<const geos::geom::PackedCoordinateSequence*>(&cs);
+    if(packed && packed->stride() == dims) {
+        std::memcpy(buf, packed->data(), size * dims * sizeof(double));
+        return;
+    }
+    if(hasZ && dynamic_cast<const geos::geom::CoordinateArraySequence*>(&cs)) {
+        // coordinates are stored in a vector
+        std::memcpy(buf, &cs.getAt(0).x, size * 3 * sizeof(double));
+        return;
+    }
+
+    Coordinate c;
+    for(std::size_t i = 0; i < size; ++i) {
+        cs.getAt(i, c);
+        buf[i * dims] = c.x;
+        buf[i * dims + 1] = c.y;
+        if(hasZ) {
+            buf[i * dims + 2] = c.z;
+        }
+    }
+}
+
 } // namespace anonymous
 
 extern "C" {
@@ -376,6 +716,54 @@ extern "C" {
         return handle->setErrorHandler(nf);
     }
 
+    void
+    GEOSContext_interrupt_r(GEOSContextHandle_t extHandle)
+    {
+        if(0 == extHandle) {
+            return;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return;
+        }
+
+        handle->interruptState.request();
+    }
+
+    void
+    GEOSContext_cancelInterrupt_r(GEOSContextHandle_t extHandle)
+    {
+        if(0 == extHandle) {
+            return;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return;
+        }
+
+        handle->interruptState.cancel();
+    }
+
+    void
+    GEOSContext_setTimeout_r(GEOSContextHandle_t extHandle, double seconds)
+    {
+        if(0 == extHandle) {
+            return;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return;
+        }
+
+        handle->interruptState.setTimeout(seconds);
+    }
+
     GEOSMessageHandler_r
     GEOSContext_setNoticeMessageHandler_r(GEOSContextHandle_t extHandle, GEOSMessageHandler_r nf, void* userData)
     {
@@ -440,6 +828,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->disjoint(g2);
             return result;
@@ -471,6 +861,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->touches(g2);
             return result;
@@ -498,6 +890,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->intersects(g2);
             return result;
@@ -525,6 +919,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->crosses(g2);
             return result;
@@ -552,6 +948,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->within(g2);
             return result;
@@ -583,6 +981,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->contains(g2);
             return result;
@@ -610,6 +1010,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->overlaps(g2);
             return result;
@@ -637,6 +1039,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->covers(g2);
             return result;
@@ -664,6 +1068,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->coveredBy(g2);
             return result;
@@ -696,6 +1102,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             std::string s(pat);
             bool result = g1->relate(g2, s);
@@ -711,6 +1119,60 @@ extern "C" {
         return 2;
     }
 
+    int
+    GEOSRelatePatternMany_r(GEOSContextHandle_t extHandle,
+                            const Geometry** g1, const Geometry** g2,
+                            size_t n, const char* pat, char* out,
+                            unsigned int numThreads)
+    {
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
+        try {
+            std::string s(pat);
+
+            if(numThreads > 1 && n > 1) {
+                for(std::size_t i = 0; i < n; ++i) {
+                    warmGeometryCaches(g1[i]);
+                    warmGeometryCaches(g2[i]);
+                }
+            }
+
+            auto evalChunk = [g1, g2, &s](std::size_t start, std::size_t end,
+                                          char* p_out, std::string& error) {
+                for(std::size_t i = start; i < end; ++i) {
+                    const Geometry* a = g1[i];
+                    const Geometry* b = g2[i];
+                    evaluateEntry([a, b, &s]() {
+                        if(!a || !b) {
+                            throw geos::util::IllegalArgumentException("Geometry is NULL");
+                        }
+                        return a->relate(b, s);
+                    }, p_out[i], error);
+                }
+            };
+
+            return evaluateBatch(handle, n, out, numThreads, evalChunk) ? 1 : 0;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
     char
     GEOSRelatePatternMatch_r(GEOSContextHandle_t extHandle, const char* mat,
                              const char* pat)
@@ -758,6 +1220,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             using geos::geom::IntersectionMatrix;
 
@@ -793,6 +1257,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             using geos::operation::relate::RelateOp;
             using geos::geom::IntersectionMatrix;
@@ -1001,6 +1467,8 @@ extern "C" {
             return 2;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             bool result = g1->equals(g2);
             return result;
@@ -1383,15 +1851,12 @@ extern "C" {
         try {
             int byteOrder = handle->WKBByteOrder;
             WKBWriter w(handle->WKBOutputDims, byteOrder);
-            std::ostringstream os(std::ios_base::binary);
-            w.write(*g, os);
-            std::string wkbstring(os.str());
-            const std::size_t len = wkbstring.length();
+            const std::size_t len = w.getWKBSize(*g);
 
             unsigned char* result = 0;
             result = static_cast<unsigned char*>(malloc(len));
             if(0 != result) {
-                std::memcpy(result, wkbstring.c_str(), len);
+                w.write(*g, result, len);
                 *size = len;
             }
             return result;
@@ -1421,12 +1886,8 @@ extern "C" {
 
         using geos::io::WKBReader;
         try {
-            std::string wkbstring(reinterpret_cast<const char*>(wkb), size); // make it binary !
             WKBReader r(*(static_cast<GeometryFactory const*>(handle->geomFactory)));
-            std::istringstream is(std::ios_base::binary);
-            is.str(wkbstring);
-            is.seekg(0, std::ios::beg); // rewind reader pointer
-            Geometry* g = r.read(is);
+            Geometry* g = r.read(wkb, size);
             return g;
         }
         catch(const std::exception& e) {
@@ -1494,11 +1955,9 @@ extern "C" {
 
         using geos::io::WKBReader;
         try {
-            std::string hexstring(reinterpret_cast<const char*>(hex), size);
             WKBReader r(*(static_cast<GeometryFactory const*>(handle->geomFactory)));
-            std::istringstream is(std::ios_base::binary);
-            is.str(hexstring);
-            is.seekg(0, std::ios::beg); // rewind reader pointer
+            membuf mb((char*)hex, size);
+            istream is(&mb);
 
             Geometry* g = r.readHEX(is);
             return g;
@@ -1702,6 +2161,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             return g1->intersection(g2).release();
         }
@@ -1728,6 +2189,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             Geometry* g3 = g1->buffer(width, quadrantsegments).release();
             return g3;
@@ -1760,6 +2223,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             BufferParameters bp;
             bp.setQuadrantSegments(quadsegs);
@@ -1806,6 +2271,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             BufferParameters bp;
             bp.setEndCapStyle(BufferParameters::CAP_FLAT);
@@ -1854,6 +2321,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             BufferParameters bp;
             bp.setEndCapStyle(BufferParameters::CAP_FLAT);
@@ -2000,20 +2469,216 @@ extern "C" {
     GEOSMinimumClearance_r(GEOSContextHandle_t extHandle, const Geometry* g, double* d)
     {
         if(0 == extHandle) {
-            return 2;
+            return 2;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 2;
+        }
+
+        try {
+            geos::precision::MinimumClearance mc(g);
+            double res = mc.getDistance();
+            *d = res;
+            return 0;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 2;
+    }
+
+
+    Geometry*
+    GEOSDifference_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
+        try {
+            return g1->difference(g2).release();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    Geometry*
+    GEOSBoundary_r(GEOSContextHandle_t extHandle, const Geometry* g1)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        try {
+            Geometry* g3 = g1->getBoundary().release();
+            return g3;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    Geometry*
+    GEOSSymDifference_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
+        try {
+            return g1->symDifference(g2).release();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+            return NULL;
+        }
+
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+            return NULL;
+        }
+    }
+
+    Geometry*
+    GEOSUnion_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
+        try {
+            return g1->Union(g2).release();
+        }
+        catch(const std::exception& e) {
+#if VERBOSE_EXCEPTIONS
+            std::ostringstream s;
+            s << "Exception on GEOSUnion_r with following inputs:" << std::endl;
+            s << "A: " << g1->toString() << std::endl;
+            s << "B: " << g2->toString() << std::endl;
+            handle->NOTICE_MESSAGE("%s", s.str().c_str());
+#endif // VERBOSE_EXCEPTIONS
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    Geometry*
+    GEOSIntersectionPrec_r(GEOSContextHandle_t extHandle, const Geometry* g1,
+                           const Geometry* g2, double gridSize)
+    {
+        using geos::geom::PrecisionModel;
+
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
+        try {
+            if(!(gridSize >= 0)) {
+                throw IllegalArgumentException("gridSize must be non-negative");
+            }
+            if(gridSize == 0) {
+                return g1->intersection(g2).release();
+            }
+            PrecisionModel pm(1.0 / gridSize);
+            return g1->intersection(g2, pm).release();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    Geometry*
+    GEOSDifferencePrec_r(GEOSContextHandle_t extHandle, const Geometry* g1,
+                         const Geometry* g2, double gridSize)
+    {
+        using geos::geom::PrecisionModel;
+
+        if(0 == extHandle) {
+            return NULL;
         }
 
         GEOSContextHandleInternal_t* handle = 0;
         handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
         if(0 == handle->initialized) {
-            return 2;
+            return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            geos::precision::MinimumClearance mc(g);
-            double res = mc.getDistance();
-            *d = res;
-            return 0;
+            if(!(gridSize >= 0)) {
+                throw IllegalArgumentException("gridSize must be non-negative");
+            }
+            if(gridSize == 0) {
+                return g1->difference(g2).release();
+            }
+            PrecisionModel pm(1.0 / gridSize);
+            return g1->difference(g2, pm).release();
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -2022,13 +2687,15 @@ extern "C" {
             handle->ERROR_MESSAGE("Unknown exception thrown");
         }
 
-        return 2;
+        return NULL;
     }
 
-
     Geometry*
-    GEOSDifference_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2)
+    GEOSSymDifferencePrec_r(GEOSContextHandle_t extHandle, const Geometry* g1,
+                            const Geometry* g2, double gridSize)
     {
+        using geos::geom::PrecisionModel;
+
         if(0 == extHandle) {
             return NULL;
         }
@@ -2039,8 +2706,17 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            return g1->difference(g2).release();
+            if(!(gridSize >= 0)) {
+                throw IllegalArgumentException("gridSize must be non-negative");
+            }
+            if(gridSize == 0) {
+                return g1->symDifference(g2).release();
+            }
+            PrecisionModel pm(1.0 / gridSize);
+            return g1->symDifference(g2, pm).release();
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -2053,8 +2729,11 @@ extern "C" {
     }
 
     Geometry*
-    GEOSBoundary_r(GEOSContextHandle_t extHandle, const Geometry* g1)
+    GEOSUnionPrec_r(GEOSContextHandle_t extHandle, const Geometry* g1,
+                    const Geometry* g2, double gridSize)
     {
+        using geos::geom::PrecisionModel;
+
         if(0 == extHandle) {
             return NULL;
         }
@@ -2065,9 +2744,17 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            Geometry* g3 = g1->getBoundary().release();
-            return g3;
+            if(!(gridSize >= 0)) {
+                throw IllegalArgumentException("gridSize must be non-negative");
+            }
+            if(gridSize == 0) {
+                return g1->Union(g2).release();
+            }
+            PrecisionModel pm(1.0 / gridSize);
+            return g1->Union(g2, pm).release();
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -2080,7 +2767,7 @@ extern "C" {
     }
 
     Geometry*
-    GEOSSymDifference_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2)
+    GEOSCoverageUnion_r(GEOSContextHandle_t extHandle, const Geometry* g)
     {
         if(0 == extHandle) {
             return NULL;
@@ -2092,22 +2779,23 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            return g1->symDifference(g2).release();
+            return geos::operation::geounion::CoverageUnion::Union(g).release();
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
-            return NULL;
         }
-
         catch(...) {
             handle->ERROR_MESSAGE("Unknown exception thrown");
-            return NULL;
         }
+
+        return NULL;
     }
 
     Geometry*
-    GEOSUnion_r(GEOSContextHandle_t extHandle, const Geometry* g1, const Geometry* g2)
+    GEOSUnaryUnion_r(GEOSContextHandle_t extHandle, const Geometry* g)
     {
         if(0 == extHandle) {
             return NULL;
@@ -2119,13 +2807,16 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            return g1->Union(g2).release();
+            GeomPtr g3(g->Union());
+            return g3.release();
         }
         catch(const std::exception& e) {
 #if VERBOSE_EXCEPTIONS
             std::ostringstream s;
-            s << "Exception on GEOSUnion_r with following inputs:" << std::endl;
+            s << "Exception on GEOSUnaryUnion_r with following inputs:" << std::endl;
             s << "A: " << g1->toString() << std::endl;
             s << "B: " << g2->toString() << std::endl;
             handle->NOTICE_MESSAGE("%s", s.str().c_str());
@@ -2140,7 +2831,8 @@ extern "C" {
     }
 
     Geometry*
-    GEOSCoverageUnion_r(GEOSContextHandle_t extHandle, const Geometry* g)
+    GEOSUnaryUnionParallel_r(GEOSContextHandle_t extHandle, const Geometry* g,
+                             unsigned int numThreads)
     {
         if(0 == extHandle) {
             return NULL;
@@ -2152,8 +2844,11 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            return geos::operation::geounion::CoverageUnion::Union(g).release();
+            GeomPtr g3(geos::operation::geounion::UnaryUnionOp::Union(*g, numThreads));
+            return g3.release();
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -2166,7 +2861,7 @@ extern "C" {
     }
 
     Geometry*
-    GEOSUnaryUnion_r(GEOSContextHandle_t extHandle, const Geometry* g)
+    GEOSNode_r(GEOSContextHandle_t extHandle, const Geometry* g)
     {
         if(0 == extHandle) {
             return NULL;
@@ -2179,13 +2874,13 @@ extern "C" {
         }
 
         try {
-            GeomPtr g3(g->Union());
+            std::unique_ptr<Geometry> g3 = geos::noding::GeometryNoder::node(*g);
             return g3.release();
         }
         catch(const std::exception& e) {
 #if VERBOSE_EXCEPTIONS
             std::ostringstream s;
-            s << "Exception on GEOSUnaryUnion_r with following inputs:" << std::endl;
+            s << "Exception on GEOSNode_r with following inputs:" << std::endl;
             s << "A: " << g1->toString() << std::endl;
             s << "B: " << g2->toString() << std::endl;
             handle->NOTICE_MESSAGE("%s", s.str().c_str());
@@ -2200,7 +2895,8 @@ extern "C" {
     }
 
     Geometry*
-    GEOSNode_r(GEOSContextHandle_t extHandle, const Geometry* g)
+    GEOSNodeParallel_r(GEOSContextHandle_t extHandle, const Geometry* g,
+                       unsigned int numThreads)
     {
         if(0 == extHandle) {
             return NULL;
@@ -2212,18 +2908,13 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
-            std::unique_ptr<Geometry> g3 = geos::noding::GeometryNoder::node(*g);
+            std::unique_ptr<Geometry> g3 = geos::noding::GeometryNoder::node(*g, numThreads);
             return g3.release();
         }
         catch(const std::exception& e) {
-#if VERBOSE_EXCEPTIONS
-            std::ostringstream s;
-            s << "Exception on GEOSNode_r with following inputs:" << std::endl;
-            s << "A: " << g1->toString() << std::endl;
-            s << "B: " << g2->toString() << std::endl;
-            handle->NOTICE_MESSAGE("%s", s.str().c_str());
-#endif // VERBOSE_EXCEPTIONS
             handle->ERROR_MESSAGE("%s", e.what());
         }
         catch(...) {
@@ -2246,6 +2937,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             const geos::geom::MultiPolygon* p = dynamic_cast<const geos::geom::MultiPolygon*>(g1);
             if(! p) {
@@ -3704,6 +4397,128 @@ extern "C" {
         return NULL;
     }
 
+    CoordinateSequence*
+    GEOSCoordSeq_copyFromBuffer_r(GEOSContextHandle_t extHandle, const double* buf,
+                                  unsigned int size, int hasZ)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        try {
+            return coordSeqFromBuffer(handle->geomFactory, buf, size, hasZ != 0).release();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    CoordinateSequence*
+    GEOSCoordSeq_copyFromArrays_r(GEOSContextHandle_t extHandle, const double* x,
+                                  const double* y, const double* z, unsigned int size)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        try {
+            return coordSeqFromArrays(handle->geomFactory, x, y, z, size).release();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    int
+    GEOSCoordSeq_copyToBuffer_r(GEOSContextHandle_t extHandle, const CoordinateSequence* cs,
+                                double* buf, int hasZ)
+    {
+        assert(0 != cs);
+
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        try {
+            coordSeqToBuffer(*cs, buf, hasZ != 0);
+            return 1;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
+    int
+    GEOSCoordSeq_copyToArrays_r(GEOSContextHandle_t extHandle, const CoordinateSequence* cs,
+                                double* x, double* y, double* z)
+    {
+        assert(0 != cs);
+
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        try {
+            Coordinate c;
+            for(std::size_t i = 0, n = cs->getSize(); i < n; ++i) {
+                cs->getAt(i, c);
+                x[i] = c.x;
+                y[i] = c.y;
+                if(z) {
+                    z[i] = c.z;
+                }
+            }
+            return 1;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
     int
     GEOSCoordSeq_setOrdinate_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs,
                                unsigned int idx, unsigned int dim, double val)
@@ -3979,13 +4794,95 @@ extern "C" {
                 return ls->getCoordinatesRO();
             }
 
-            const Point* p = dynamic_cast<const Point*>(g);
-            if(p) {
-                return p->getCoordinatesRO();
-            }
+            const Point* p = dynamic_cast<const Point*>(g);
+            if(p) {
+                return p->getCoordinatesRO();
+            }
+
+            handle->ERROR_MESSAGE("Geometry must be a Point or LineString");
+            return 0;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
+    Geometry*
+    GEOSGeom_createEmptyPoint_r(GEOSContextHandle_t extHandle)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        try {
+            const GeometryFactory* gf = handle->geomFactory;
+            return gf->createPoint();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return NULL;
+    }
+
+    Geometry*
+    GEOSGeom_createPoint_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs)
+    {
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        try {
+            const GeometryFactory* gf = handle->geomFactory;
+            return gf->createPoint(cs);
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
+    Geometry*
+    GEOSGeom_createLinearRing_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs)
+    {
+        if(0 == extHandle) {
+            return NULL;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return NULL;
+        }
+
+        try {
+            const GeometryFactory* gf = handle->geomFactory;
 
-            handle->ERROR_MESSAGE("Geometry must be a Point or LineString");
-            return 0;
+            return gf->createLinearRing(cs);
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -3994,11 +4891,11 @@ extern "C" {
             handle->ERROR_MESSAGE("Unknown exception thrown");
         }
 
-        return 0;
+        return NULL;
     }
 
     Geometry*
-    GEOSGeom_createEmptyPoint_r(GEOSContextHandle_t extHandle)
+    GEOSGeom_createEmptyLineString_r(GEOSContextHandle_t extHandle)
     {
         if(0 == extHandle) {
             return NULL;
@@ -4012,7 +4909,8 @@ extern "C" {
 
         try {
             const GeometryFactory* gf = handle->geomFactory;
-            return gf->createPoint();
+
+            return gf->createLineString();
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -4025,21 +4923,22 @@ extern "C" {
     }
 
     Geometry*
-    GEOSGeom_createPoint_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs)
+    GEOSGeom_createLineString_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs)
     {
         if(0 == extHandle) {
-            return 0;
+            return NULL;
         }
 
         GEOSContextHandleInternal_t* handle = 0;
         handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
         if(0 == handle->initialized) {
-            return 0;
+            return NULL;
         }
 
         try {
             const GeometryFactory* gf = handle->geomFactory;
-            return gf->createPoint(cs);
+
+            return gf->createLineString(cs);
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -4048,11 +4947,12 @@ extern "C" {
             handle->ERROR_MESSAGE("Unknown exception thrown");
         }
 
-        return 0;
+        return NULL;
     }
 
     Geometry*
-    GEOSGeom_createLinearRing_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs)
+    GEOSGeom_createLineStringFromBuffer_r(GEOSContextHandle_t extHandle, const double* buf,
+                                          unsigned int size, int hasZ)
     {
         if(0 == extHandle) {
             return NULL;
@@ -4066,8 +4966,8 @@ extern "C" {
 
         try {
             const GeometryFactory* gf = handle->geomFactory;
-
-            return gf->createLinearRing(cs);
+            auto cs = coordSeqFromBuffer(gf, buf, size, hasZ != 0);
+            return gf->createLineString(cs.release());
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -4080,7 +4980,8 @@ extern "C" {
     }
 
     Geometry*
-    GEOSGeom_createEmptyLineString_r(GEOSContextHandle_t extHandle)
+    GEOSGeom_createLinearRingFromBuffer_r(GEOSContextHandle_t extHandle, const double* buf,
+                                          unsigned int size, int hasZ)
     {
         if(0 == extHandle) {
             return NULL;
@@ -4094,8 +4995,8 @@ extern "C" {
 
         try {
             const GeometryFactory* gf = handle->geomFactory;
-
-            return gf->createLineString();
+            auto cs = coordSeqFromBuffer(gf, buf, size, hasZ != 0);
+            return gf->createLinearRing(cs.release());
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -4108,7 +5009,9 @@ extern "C" {
     }
 
     Geometry*
-    GEOSGeom_createLineString_r(GEOSContextHandle_t extHandle, CoordinateSequence* cs)
+    GEOSGeom_createPolygonFromBuffer_r(GEOSContextHandle_t extHandle, const double* buf,
+                                       const unsigned int* ringSizes, unsigned int nrings,
+                                       int hasZ)
     {
         if(0 == extHandle) {
             return NULL;
@@ -4122,8 +5025,32 @@ extern "C" {
 
         try {
             const GeometryFactory* gf = handle->geomFactory;
+            if(nrings == 0) {
+                return gf->createPolygon();
+            }
+
+            std::size_t dims = hasZ ? 3 : 2;
+            std::unique_ptr<LinearRing> shell;
+            std::vector<std::unique_ptr<Geometry>> holeRings;
+            holeRings.reserve(nrings - 1);
+            for(unsigned int i = 0; i < nrings; ++i) {
+                auto cs = coordSeqFromBuffer(gf, buf, ringSizes[i], hasZ != 0);
+                LinearRing* ring = gf->createLinearRing(cs.release());
+                if(i == 0) {
+                    shell.reset(ring);
+                }
+                else {
+                    holeRings.emplace_back(ring);
+                }
+                buf += ringSizes[i] * dims;
+            }
 
-            return gf->createLineString(cs);
+            std::vector<Geometry*>* holes = new std::vector<Geometry*>(holeRings.size());
+            for(std::size_t i = 0; i < holeRings.size(); ++i) {
+                (*holes)[i] = holeRings[i].release();
+            }
+
+            return gf->createPolygon(shell.release(), holes);
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -4909,13 +5836,6 @@ extern "C" {
         }
     }
 
-    struct membuf : public std::streambuf {
-        membuf(char* s, std::size_t n)
-        {
-            setg(s, s, s + n);
-        }
-    };
-
     Geometry*
     GEOSWKBReader_read_r(GEOSContextHandle_t extHandle, WKBReader* reader, const unsigned char* wkb, size_t size)
     {
@@ -4933,16 +5853,7 @@ extern "C" {
         }
 
         try {
-            //std::string wkbstring(reinterpret_cast<const char*>(wkb), size); // make it binary !
-            //std::istringstream is(std::ios_base::binary);
-            //is.str(wkbstring);
-            //is.seekg(0, std::ios::beg); // rewind reader pointer
-
-            // http://stackoverflow.com/questions/2079912/simpler-way-to-create-a-c-memorystream-from-char-size-t-without-copying-t
-            membuf mb((char*)wkb, size);
-            istream is(&mb);
-
-            Geometry* g = reader->read(is);
+            Geometry* g = reader->read(wkb, size);
             return g;
         }
         catch(const std::exception& e) {
@@ -4972,10 +5883,8 @@ extern "C" {
         }
 
         try {
-            std::string hexstring(reinterpret_cast<const char*>(hex), size);
-            std::istringstream is(std::ios_base::binary);
-            is.str(hexstring);
-            is.seekg(0, std::ios::beg); // rewind reader pointer
+            membuf mb((char*)hex, size);
+            istream is(&mb);
 
             Geometry* g = reader->readHEX(is);
             return g;
@@ -5072,15 +5981,14 @@ extern "C" {
         }
 
         try {
-            std::ostringstream os(std::ios_base::binary);
-            writer->write(*geom, os);
-
-            const std::string& wkbstring = os.str();
-            const std::size_t len = wkbstring.length();
+            const std::size_t len = writer->getWKBSize(*geom);
 
             unsigned char* result = NULL;
             result = (unsigned char*) malloc(len);
-            std::memcpy(result, wkbstring.c_str(), len);
+            if(NULL == result) {
+                throw std::runtime_error("Failed to allocate memory for WKB output");
+            }
+            writer->write(*geom, result, len);
             *size = len;
             return result;
         }
@@ -5133,6 +6041,40 @@ extern "C" {
         return NULL;
     }
 
+    size_t
+    GEOSWKBWriter_writeToBuffer_r(GEOSContextHandle_t extHandle, WKBWriter* writer, const Geometry* geom,
+                                  unsigned char* buf, size_t bufSize)
+    {
+        assert(0 != writer);
+        assert(0 != geom);
+
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        try {
+            const std::size_t len = writer->getWKBSize(*geom);
+            if(NULL != buf && len <= bufSize) {
+                writer->write(*geom, buf, len);
+            }
+            return len;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
     int
     GEOSWKBWriter_getOutputDimension_r(GEOSContextHandle_t extHandle, const GEOSWKBWriter* writer)
     {
@@ -5656,6 +6598,116 @@ extern "C" {
         return 2;
     }
 
+    int
+    GEOSPreparedContainsMany_r(GEOSContextHandle_t extHandle,
+                               const geos::geom::prep::PreparedGeometry* pg,
+                               const Geometry** geoms, size_t n, char* out,
+                               unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::contains,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedContainsProperlyMany_r(GEOSContextHandle_t extHandle,
+                                       const geos::geom::prep::PreparedGeometry* pg,
+                                       const Geometry** geoms, size_t n, char* out,
+                                       unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::containsProperly,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedCoveredByMany_r(GEOSContextHandle_t extHandle,
+                                const geos::geom::prep::PreparedGeometry* pg,
+                                const Geometry** geoms, size_t n, char* out,
+                                unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::coveredBy,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedCoversMany_r(GEOSContextHandle_t extHandle,
+                             const geos::geom::prep::PreparedGeometry* pg,
+                             const Geometry** geoms, size_t n, char* out,
+                             unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::covers,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedCrossesMany_r(GEOSContextHandle_t extHandle,
+                              const geos::geom::prep::PreparedGeometry* pg,
+                              const Geometry** geoms, size_t n, char* out,
+                              unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::crosses,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedDisjointMany_r(GEOSContextHandle_t extHandle,
+                               const geos::geom::prep::PreparedGeometry* pg,
+                               const Geometry** geoms, size_t n, char* out,
+                               unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::disjoint,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedIntersectsMany_r(GEOSContextHandle_t extHandle,
+                                 const geos::geom::prep::PreparedGeometry* pg,
+                                 const Geometry** geoms, size_t n, char* out,
+                                 unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::intersects,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedOverlapsMany_r(GEOSContextHandle_t extHandle,
+                               const geos::geom::prep::PreparedGeometry* pg,
+                               const Geometry** geoms, size_t n, char* out,
+                               unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::overlaps,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedTouchesMany_r(GEOSContextHandle_t extHandle,
+                              const geos::geom::prep::PreparedGeometry* pg,
+                              const Geometry** geoms, size_t n, char* out,
+                              unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::touches,
+                                     geoms, n, out, numThreads);
+    }
+
+    int
+    GEOSPreparedWithinMany_r(GEOSContextHandle_t extHandle,
+                             const geos::geom::prep::PreparedGeometry* pg,
+                             const Geometry** geoms, size_t n, char* out,
+                             unsigned int numThreads)
+    {
+        return preparedPredicateMany(extHandle, pg,
+                                     &geos::geom::prep::PreparedGeometry::within,
+                                     geoms, n, out, numThreads);
+    }
+
 //-----------------------------------------------------------------
 // STRtree
 //-----------------------------------------------------------------
@@ -5677,7 +6729,7 @@ extern "C" {
         geos::index::strtree::STRtree* tree = 0;
 
         try {
-            tree = new geos::index::strtree::STRtree(nodeCapacity);
+            tree = new CAPI_STRtree(nodeCapacity);
         }
         catch(const std::exception& e) {
             handle->ERROR_MESSAGE("%s", e.what());
@@ -5728,6 +6780,115 @@ extern "C" {
         }
     }
 
+    geos::index::strtree::STRtree*
+    GEOSSTRtree_createFromBounds_r(GEOSContextHandle_t extHandle,
+                                   size_t nodeCapacity,
+                                   const double* xmin, const double* ymin,
+                                   const double* xmax, const double* ymax,
+                                   const size_t* ids, size_t n)
+    {
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        try {
+            std::unique_ptr<CAPI_STRtree> tree(new CAPI_STRtree(nodeCapacity, n));
+            for(size_t i = 0; i < n; ++i) {
+                tree->envelopes.emplace_back(xmin[i], xmax[i], ymin[i], ymax[i]);
+            }
+            for(size_t i = 0; i < n; ++i) {
+                uintptr_t id = ids ? ids[i] : i;
+                tree->insert(&tree->envelopes[i], reinterpret_cast<void*>(id));
+            }
+            return tree.release();
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
+    int
+    GEOSSTRtree_queryBounds_r(GEOSContextHandle_t extHandle,
+                              geos::index::strtree::STRtree* tree,
+                              const double* xmin, const double* ymin,
+                              const double* xmax, const double* ymax,
+                              size_t n, size_t* offsets,
+                              size_t* ids, size_t idsCapacity,
+                              size_t* numHits)
+    {
+        assert(tree != 0);
+        assert(offsets != 0);
+
+        if(0 == extHandle) {
+            return 0;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return 0;
+        }
+
+        try {
+            using geos::index::strtree::FrozenSTRtree;
+
+            std::unique_ptr<FrozenSTRtree> tmpFrozen;
+            const FrozenSTRtree* frozen;
+            if(CAPI_STRtree* capiTree = dynamic_cast<CAPI_STRtree*>(tree)) {
+                if(!capiTree->frozen) {
+                    capiTree->frozen.reset(new FrozenSTRtree(*capiTree));
+                }
+                frozen = capiTree->frozen.get();
+            }
+            else {
+                tmpFrozen.reset(new FrozenSTRtree(*tree));
+                frozen = tmpFrozen.get();
+            }
+
+            std::vector<geos::geom::Envelope> searchEnvs;
+            searchEnvs.reserve(n);
+            for(size_t i = 0; i < n; ++i) {
+                searchEnvs.emplace_back(xmin[i], xmax[i], ymin[i], ymax[i]);
+            }
+
+            std::vector<size_t> found;
+            std::vector<size_t> foundOffsets;
+            frozen->queryBatch(searchEnvs, foundOffsets, found);
+
+            std::copy(foundOffsets.begin(), foundOffsets.end(), offsets);
+            if(numHits) {
+                *numHits = found.size();
+            }
+            if(found.size() > idsCapacity) {
+                return 2;
+            }
+            // the snapshot finds leaf positions, return the items
+            for(size_t i = 0; i < found.size(); ++i) {
+                ids[i] = reinterpret_cast<uintptr_t>(frozen->getItem(found[i]));
+            }
+            return 1;
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return 0;
+    }
+
     void
     GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
                         geos::index::strtree::STRtree* tree,
@@ -5790,28 +6951,6 @@ extern "C" {
 
         GEOSContextHandleInternal_t* handle = 0;
 
-        struct CustomItemDistance : public ItemDistance {
-            CustomItemDistance(GEOSDistanceCallback p_distancefn, void* p_userdata)
-                : m_distancefn(p_distancefn), m_userdata(p_userdata) {}
-
-            GEOSDistanceCallback m_distancefn;
-            void* m_userdata;
-
-            double
-            distance(const ItemBoundable* item1, const ItemBoundable* item2) override
-            {
-                const void* a = item1->getItem();
-                const void* b = item2->getItem();
-                double d;
-
-                if(!m_distancefn(a, b, &d, m_userdata)) {
-                    throw std::runtime_error(std::string("Failed to compute distance."));
-                }
-
-                return d;
-            }
-        };
-
         try {
             if(distancefn) {
                 CustomItemDistance itemDistance(distancefn, userdata);
@@ -5850,6 +6989,100 @@ extern "C" {
         return NULL;
     }
 
+    int
+    GEOSSTRtree_nearest_k_generic_r(GEOSContextHandle_t extHandle,
+                                    geos::index::strtree::STRtree* tree,
+                                    const void* item,
+                                    const geos::geom::Geometry* itemEnvelope,
+                                    GEOSDistanceCallback distancefn,
+                                    void* userdata,
+                                    unsigned int k,
+                                    const void** results)
+    {
+        using namespace geos::index::strtree;
+
+        if(0 == extHandle) {
+            return -1;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return -1;
+        }
+
+        try {
+            std::vector<const void*> found;
+            if(distancefn) {
+                CustomItemDistance itemDistance(distancefn, userdata);
+                found = tree->kNearest(itemEnvelope->getEnvelopeInternal(), item, k, &itemDistance);
+            }
+            else {
+                GeometryItemDistance itemDistance;
+                found = tree->kNearest(itemEnvelope->getEnvelopeInternal(), item, k, &itemDistance);
+            }
+            std::copy(found.begin(), found.end(), results);
+            return static_cast<int>(found.size());
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return -1;
+    }
+
+    int
+    GEOSSTRtree_withinDistance_generic_r(GEOSContextHandle_t extHandle,
+                                         geos::index::strtree::STRtree* tree,
+                                         const void* item,
+                                         const geos::geom::Geometry* itemEnvelope,
+                                         double maxDistance,
+                                         GEOSDistanceCallback distancefn,
+                                         GEOSQueryCallback callback,
+                                         void* userdata)
+    {
+        using namespace geos::index::strtree;
+
+        if(0 == extHandle) {
+            return -1;
+        }
+
+        GEOSContextHandleInternal_t* handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if(0 == handle->initialized) {
+            return -1;
+        }
+
+        try {
+            std::vector<const void*> found;
+            if(distancefn) {
+                CustomItemDistance itemDistance(distancefn, userdata);
+                found = tree->withinDistance(itemEnvelope->getEnvelopeInternal(), item,
+                                             maxDistance, &itemDistance);
+            }
+            else {
+                GeometryItemDistance itemDistance;
+                found = tree->withinDistance(itemEnvelope->getEnvelopeInternal(), item,
+                                             maxDistance, &itemDistance);
+            }
+            for(const void* f : found) {
+                callback(const_cast<void*>(f), userdata);
+            }
+            return static_cast<int>(found.size());
+        }
+        catch(const std::exception& e) {
+            handle->ERROR_MESSAGE("%s", e.what());
+        }
+        catch(...) {
+            handle->ERROR_MESSAGE("Unknown exception thrown");
+        }
+
+        return -1;
+    }
+
     void
     GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
                           geos::index::strtree::STRtree* tree,
@@ -5911,6 +7144,9 @@ extern "C" {
 
         try {
             bool result = tree->remove(g->getEnvelopeInternal(), item);
+            if(CAPI_STRtree* capiTree = dynamic_cast<CAPI_STRtree*>(tree)) {
+                capiTree->frozen.reset();
+            }
             return result;
         }
         catch(const std::exception& e) {
@@ -6426,6 +7662,8 @@ extern "C" {
             return NULL;
         }
 
+        geos::util::Interrupt::Scope interruptScope(&handle->interruptState);
+
         try {
             BufferOp op(g1, *bp);
             Geometry* g3 = op.getResultGeometry(width);
@@ -19,14 +19,7 @@
 #ifndef GEOS_ALGORITHM_CGALGORITHMDD_H
 #define GEOS_ALGORITHM_CGALGORITHMDD_H
 #include <geos/export.h>
-#include <geos/algorithm/ttmath/ttmath.h>
-
-// Close to DoubleDouble equivalent used by JTS
-// Usage: ttmath::Big<exponent, mantissa>
-typedef ttmath::Big<TTMATH_BITS(32), TTMATH_BITS(128)> DD;
-//typedef ttmath::Big<TTMATH_BITS(64), TTMATH_BITS(128)> DD;
-//typedef ttmath::Big<TTMATH_BITS(32), TTMATH_BITS(256)> DD;
-//typedef ttmath::Big<TTMATH_BITS(64), TTMATH_BITS(256)> DD;
+#include <geos/math/DD.h>
 
 // Forward declarations
 namespace geos {
@@ -41,6 +34,10 @@ namespace algorithm { // geos::algorithm
 /**
 * \brief
 * Implements basic computational geometry algorithms using extended precision float-point arithmetic.
+*
+* Extended precision is provided by the double-double type geos::math::DD,
+* which is only used when the fast double-precision filters are unable
+* to determine a result safely.
 */
 class GEOS_DLL CGAlgorithmsDD {
 
@@ -119,7 +116,8 @@ public:
 
 protected:
 
-    static int signOfDet2x2(DD& x1, DD& y1, DD& x2, DD& y2);
+    static int signOfDet2x2(const math::DD& x1, const math::DD& y1,
+                            const math::DD& x2, const math::DD& y2);
 
 };
 
@@ -0,0 +1,135 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_ARENACOORDINATESEQUENCE_H
+#define GEOS_GEOM_ARENACOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+
+#include <memory>
+#include <vector>
+
+// Forward declarations
+namespace geos {
+namespace util {
+class Arena;
+}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * A CoordinateSequence keeping its Coordinate array in a util::Arena.
+ *
+ * This is the sequence built by the CoordinateSequenceFactory of an
+ * arena GeometryFactory: along with the sequence object itself, its
+ * coordinates are allocated from the arena, so that the arena can be
+ * released without leaking them (see util::Arena for the lifetime
+ * rules). The array is given back to the arena when the sequence is
+ * destroyed or grows.
+ *
+ * Clones are CoordinateArraySequence objects on the heap, independent
+ * of the arena like clones of arena geometries.
+ */
+class GEOS_DLL ArenaCoordinateSequence final : public CoordinateSequence {
+public:
+
+    /// Construct sequence of n coordinates, initialized to (0, 0, NaN)
+    ArenaCoordinateSequence(util::Arena& arena, std::size_t n = 0,
+                            std::size_t dimension = 0);
+
+    /// Construct sequence copying the given coordinates
+    ArenaCoordinateSequence(util::Arena& arena,
+                            const std::vector<Coordinate>& coords,
+                            std::size_t dimension = 0);
+
+    /// Construct sequence copying the given sequence
+    ArenaCoordinateSequence(util::Arena& arena, const CoordinateSequence& seq);
+
+    ArenaCoordinateSequence(const ArenaCoordinateSequence&) = delete;
+    ArenaCoordinateSequence& operator=(const ArenaCoordinateSequence&) = delete;
+
+    ~ArenaCoordinateSequence() override;
+
+    std::unique_ptr<CoordinateSequence> clone() const override;
+
+    const Coordinate&
+    getAt(std::size_t pos) const override
+    {
+        return coords[pos];
+    }
+
+    void getAt(std::size_t i, Coordinate& c) const override;
+
+    std::size_t
+    getSize() const override
+    {
+        return size;
+    }
+
+    void toVector(std::vector<Coordinate>& out) const override;
+
+    bool
+    isEmpty() const override
+    {
+        return size == 0;
+    }
+
+    using CoordinateSequence::add;
+
+    void add(const Coordinate& c) override;
+
+    void add(const Coordinate& c, bool allowRepeated) override;
+
+    void add(std::size_t i, const Coordinate& coord, bool allowRepeated) override;
+
+    void setAt(const Coordinate& c, std::size_t pos) override;
+
+    void setPoints(const std::vector<Coordinate>& v) override;
+
+    std::size_t getDimension() const override;
+
+    double getOrdinate(std::size_t index, std::size_t ordinateIndex) const override;
+
+    void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+                     double value) override;
+
+    void expandEnvelope(Envelope& env) const override;
+
+    void apply_rw(const CoordinateFilter* filter) override;
+
+    void apply_ro(CoordinateFilter* filter) const override;
+
+private:
+
+    /// Makes room for at least n coordinates, keeping the current ones
+    void reserve(std::size_t n);
+
+    util::Arena* arena;
+
+    Coordinate* coords;
+
+    std::size_t size;
+
+    std::size_t capacity;
+
+    mutable std::size_t dimension;
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_ARENACOORDINATESEQUENCE_H
@@ -28,6 +28,9 @@ namespace geos {
 namespace geom {
 class Coordinate;
 }
+namespace util {
+class Arena;
+}
 }
 
 namespace geos {
@@ -43,6 +46,16 @@ namespace geom { // geos::geom
 class GEOS_DLL CoordinateArraySequenceFactory: public CoordinateSequenceFactory {
 
 public:
+    CoordinateArraySequenceFactory() : arena(nullptr) {}
+
+    /**
+     * Creates a factory building ArenaCoordinateSequence objects,
+     * which keep their coordinates in the given Arena too.
+     * The vectors given to create(std::vector<Coordinate>*, std::size_t)
+     * are copied to the arena and deleted.
+     */
+    explicit CoordinateArraySequenceFactory(geos::util::Arena* p_arena) : arena(p_arena) {}
+
     std::unique_ptr<CoordinateSequence> create() const override;
 
     std::unique_ptr<CoordinateSequence> create(std::vector<Coordinate>* coords, std::size_t dims = 0) const override;
@@ -56,6 +69,9 @@ public:
      * Returns the singleton instance of CoordinateArraySequenceFactory
      */
     static const CoordinateSequenceFactory* instance();
+
+private:
+    geos::util::Arena* arena;
 };
 
 /// This is for backward API compatibility
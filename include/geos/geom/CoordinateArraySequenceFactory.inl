@@ -17,23 +17,40 @@
 
 #include <cassert>
 #include <geos/geom/CoordinateArraySequenceFactory.h>
+#include <geos/geom/ArenaCoordinateSequence.h>
 #include <geos/geom/CoordinateArraySequence.h>
 
+#include <memory>
+#include <vector>
+
 namespace geos {
 namespace geom { // geos::geom
 
 INLINE std::unique_ptr<CoordinateSequence>
 CoordinateArraySequenceFactory::create() const
 {
+    if(arena) {
+        return std::unique_ptr<CoordinateSequence>(
+                new(*arena) ArenaCoordinateSequence(*arena));
+    }
     return std::unique_ptr<CoordinateSequence>(
-            new CoordinateArraySequence(
-                    reinterpret_cast<std::vector<Coordinate>*>(0), 0));
+            new CoordinateArraySequence(reinterpret_cast<std::vector<Coordinate>*>(0), 0));
 }
 
 INLINE std::unique_ptr<CoordinateSequence>
 CoordinateArraySequenceFactory::create(std::vector<Coordinate>* coords,
                                        size_t dimension) const
 {
+    if(arena) {
+        // the coordinates move to the arena, the vector is ours to delete
+        std::unique_ptr<std::vector<Coordinate>> owned(coords);
+        std::unique_ptr<CoordinateSequence> seq(
+            new(*arena) ArenaCoordinateSequence(*arena, std::size_t(0), dimension));
+        if(owned) {
+            seq->setPoints(*owned);
+        }
+        return seq;
+    }
     return std::unique_ptr<CoordinateSequence>(
             new CoordinateArraySequence(coords, dimension));
 }
@@ -42,6 +59,10 @@ INLINE std::unique_ptr<CoordinateSequence>
 CoordinateArraySequenceFactory::create(std::size_t size, std::size_t dimension)
 const
 {
+    if(arena) {
+        return std::unique_ptr<CoordinateSequence>(
+                new(*arena) ArenaCoordinateSequence(*arena, size, dimension));
+    }
     return std::unique_ptr<CoordinateSequence>(
             new CoordinateArraySequence(size, dimension));
 }
@@ -50,11 +71,14 @@ INLINE std::unique_ptr<CoordinateSequence>
 CoordinateArraySequenceFactory::create(const CoordinateSequence& seq)
 const
 {
+    if(arena) {
+        return std::unique_ptr<CoordinateSequence>(
+                new(*arena) ArenaCoordinateSequence(*arena, seq));
+    }
     return std::unique_ptr<CoordinateSequence>(
             new CoordinateArraySequence(seq));
 }
 
-
 } // namespace geos::geom
 } // namespace geos
 
@@ -31,6 +31,9 @@ class Envelope;
 class CoordinateFilter;
 class Coordinate;
 }
+namespace util {
+class Arena;
+}
 }
 
 namespace geos {
@@ -70,6 +73,18 @@ public:
     virtual
     ~CoordinateSequence() {}
 
+    /// Allocates a CoordinateSequence on the heap
+    static void* operator new(std::size_t size);
+
+    /// Allocates a CoordinateSequence from the given Arena
+    static void* operator new(std::size_t size, geos::util::Arena& arena);
+
+    /// Frees a CoordinateSequence, wherever it was allocated
+    static void operator delete(void* p, std::size_t size);
+
+    /// Called if a constructor throws during arena allocation
+    static void operator delete(void* p, geos::util::Arena& arena);
+
     /** \brief
      * Returns a deep copy of this collection.
      */
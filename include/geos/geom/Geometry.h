@@ -65,6 +65,9 @@ class Point;
 namespace io { // geos.io
 class Unload;
 } // namespace geos.io
+namespace util { // geos.util
+class Arena;
+} // namespace geos.util
 }
 
 namespace geos {
@@ -205,6 +208,18 @@ public:
     /// Destroy Geometry and all components
     virtual ~Geometry();
 
+    /// Allocates a Geometry on the heap
+    static void* operator new(std::size_t size);
+
+    /// Allocates a Geometry from the given Arena (see GeometryFactory)
+    static void* operator new(std::size_t size, geos::util::Arena& arena);
+
+    /// Frees a Geometry, wherever it was allocated
+    static void operator delete(void* p, std::size_t size);
+
+    /// Called if a constructor throws during arena allocation
+    static void operator delete(void* p, geos::util::Arena& arena);
+
 
     /**
      * \brief
@@ -650,6 +665,19 @@ public:
      */
     std::unique_ptr<Geometry> intersection(const Geometry* other) const;
 
+    /** \brief
+     * Returns a Geometry representing the points shared by
+     * this Geometry and other, snap rounded to the grid of pm.
+     *
+     * @see operation::overlay::snap::SnapRoundingOverlayOp
+     *
+     * @throws util::TopologyException if a robustness error occurs
+     * @throws util::IllegalArgumentException if pm is floating
+     *
+     */
+    std::unique_ptr<Geometry> intersection(const Geometry* other,
+                                           const PrecisionModel& pm) const;
+
     /** \brief
      * Returns a Geometry representing all the points in this Geometry
      * and other.
@@ -662,6 +690,19 @@ public:
     std::unique_ptr<Geometry> Union(const Geometry* other) const;
     // throw(IllegalArgumentException *, TopologyException *);
 
+    /** \brief
+     * Returns a Geometry representing all the points in this Geometry
+     * and other, snap rounded to the grid of pm.
+     *
+     * @see operation::overlay::snap::SnapRoundingOverlayOp
+     *
+     * @throws util::TopologyException if a robustness error occurs
+     * @throws util::IllegalArgumentException if pm is floating
+     *
+     */
+    std::unique_ptr<Geometry> Union(const Geometry* other,
+                                    const PrecisionModel& pm) const;
+
     /**
      * Computes the union of all the elements of this geometry. Heterogeneous
      * {@link GeometryCollection}s are fully supported.
@@ -694,6 +735,19 @@ public:
      */
     std::unique_ptr<Geometry> difference(const Geometry* other) const;
 
+    /** \brief
+     * Returns a Geometry representing the points making up this
+     * Geometry that do not make up other, snap rounded to the grid of pm.
+     *
+     * @see operation::overlay::snap::SnapRoundingOverlayOp
+     *
+     * @throws util::TopologyException if a robustness error occurs
+     * @throws util::IllegalArgumentException if pm is floating
+     *
+     */
+    std::unique_ptr<Geometry> difference(const Geometry* other,
+                                         const PrecisionModel& pm) const;
+
     /** \brief
      * Returns a set combining the points in this Geometry not in other,
      * and the points in other not in this Geometry.
@@ -705,6 +759,20 @@ public:
      */
     std::unique_ptr<Geometry> symDifference(const Geometry* other) const;
 
+    /** \brief
+     * Returns a set combining the points in this Geometry not in other,
+     * and the points in other not in this Geometry, snap rounded to the
+     * grid of pm.
+     *
+     * @see operation::overlay::snap::SnapRoundingOverlayOp
+     *
+     * @throws util::TopologyException if a robustness error occurs
+     * @throws util::IllegalArgumentException if pm is floating
+     *
+     */
+    std::unique_ptr<Geometry> symDifference(const Geometry* other,
+                                            const PrecisionModel& pm) const;
+
     /** \brief
      * Returns true iff the two Geometrys are of the same type and their
      * vertices corresponding by index are equal up to a specified tolerance.
@@ -831,8 +899,15 @@ public:
 
 protected:
 
-    /// The bounding box of this Geometry
-    mutable std::unique_ptr<Envelope> envelope;
+    /// The bounding box of this Geometry, valid if envelopeComputed is set
+    mutable Envelope envelope;
+
+    /// Whether envelope holds the bounding box of the current coordinates
+    mutable bool envelopeComputed;
+
+    /// Whether this Geometry holds a reference on its factory, which
+    /// geometries allocated in an Arena don't (see GeometryFactory)
+    bool holdsFactoryRef;
 
     /// Returns true if the array contains any non-empty Geometrys.
     static bool hasNonEmptyElements(const std::vector<Geometry*>* geometries);
@@ -843,6 +918,16 @@ protected:
     /// Returns true if the vector contains any null elements.
     static bool hasNullElements(const std::vector<Geometry*>* lrs);
 
+    /**
+     * Takes ownership of the component list of a new geometry of
+     * the factory (an empty one if null), moving it to the Arena of
+     * the factory if it has one.
+     */
+    std::vector<Geometry*>* adoptComponents(std::vector<Geometry*>* list) const;
+
+    /// Deletes a list returned by adoptComponents(), not its elements
+    void deleteComponents(std::vector<Geometry*>* list) const;
+
 //	static void reversePointOrder(CoordinateSequence* coordinates);
 //	static Coordinate& minCoordinate(CoordinateSequence* coordinates);
 //	static void scroll(CoordinateSequence* coordinates,Coordinate* firstCoordinate);
@@ -861,7 +946,7 @@ protected:
 
     //virtual void checkEqualPrecisionModel(Geometry *other);
 
-    virtual Envelope::Ptr computeEnvelopeInternal() const = 0; //Abstract
+    virtual Envelope computeEnvelopeInternal() const = 0; //Abstract
 
     virtual int compareToSameClass(const Geometry* geom) const = 0; //Abstract
 
@@ -207,7 +207,7 @@ protected:
 
     std::vector<Geometry*>* geometries;
 
-    Envelope::Ptr computeEnvelopeInternal() const override;
+    Envelope computeEnvelopeInternal() const override;
 
     int compareToSameClass(const Geometry* gc) const override;
 
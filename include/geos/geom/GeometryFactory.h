@@ -28,12 +28,14 @@
 #include <geos/export.h>
 #include <geos/inline.h>
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <cassert>
 
 namespace geos {
 namespace geom {
+class CoordinateArraySequenceFactory;
 class CoordinateSequenceFactory;
 class Coordinate;
 class CoordinateSequence;
@@ -49,6 +51,9 @@ class Point;
 class Polygon;
 class PrecisionModel;
 }
+namespace util {
+class Arena;
+}
 }
 
 namespace geos {
@@ -130,6 +135,32 @@ public:
      */
     static GeometryFactory::Ptr create(const PrecisionModel* pm, int newSRID);
 
+    /**
+     * \brief
+     * Constructs a GeometryFactory that allocates the Geometries and
+     * CoordinateSequences it creates from the given Arena.
+     *
+     * Everything built through the factory goes to the arena,
+     * including the coordinates (see ArenaCoordinateSequence), the
+     * components of polygons and collections, and the output of readers and operations using it (e.g. overlay results
+     * of geometries from this factory). Clones are still allocated on
+     * the heap.
+     *
+     * NOTES:
+     * (1) the given PrecisionModel is COPIED
+     * (2) the Arena is NOT COPIED and must outlive every
+     *     geometry created by the factory
+     * (3) geometries in the arena hold no reference on the factory,
+     *     which must outlive them, so that util::Arena::release()
+     *     may abandon them
+     *
+     * @param pm the PrecisionModel to use, will be copied internally
+     * @param newSRID the SRID to use
+     * @param arena the Arena to allocate from
+     */
+    static GeometryFactory::Ptr create(const PrecisionModel* pm, int newSRID,
+                                       geos::util::Arena& arena);
+
     /**
      * \brief Copy constructor
      *
@@ -388,6 +419,13 @@ public:
     /// with this GeometryFactory
     const CoordinateSequenceFactory* getCoordinateSequenceFactory() const;
 
+    /// Returns the Arena geometries are allocated from, or null
+    geos::util::Arena*
+    getArena() const
+    {
+        return arena;
+    }
+
     /// Returns a clone of given Geometry.
     Geometry* createGeometry(const Geometry* g) const;
 
@@ -455,6 +493,16 @@ protected:
      */
     GeometryFactory(const PrecisionModel* pm, int newSRID);
 
+    /**
+     * \brief
+     * Constructs a GeometryFactory that allocates from the given Arena.
+     *
+     * @param pm the PrecisionModel to use, will be copied internally
+     * @param newSRID the SRID to use
+     * @param arena the Arena to allocate from
+     */
+    GeometryFactory(const PrecisionModel* pm, int newSRID, geos::util::Arena& arena);
+
     /**
      * \brief Copy constructor
      *
@@ -471,7 +519,23 @@ private:
     int SRID;
     const CoordinateSequenceFactory* coordinateListFactory;
 
-    mutable int _refCount;
+    geos::util::Arena* arena = nullptr;
+
+    /// Sequence factory allocating from the arena, when one is used
+    std::unique_ptr<CoordinateArraySequenceFactory> arenaSequenceFactory;
+
+    /// Allocates a new geometry from the arena, or from the heap
+    template<class T, class... Args>
+    T* newGeometry(Args&& ... args) const;
+
+    /// Copies g as a component of a new geometry: in the arena, with
+    /// this factory, when one is used, or as a clone
+    Geometry* copyComponent(const Geometry& g) const;
+
+    /// Copies coordinates for a new geometry, in the arena when one is used
+    std::unique_ptr<CoordinateSequence> copyCoordinates(const CoordinateSequence& seq) const;
+
+    mutable std::atomic<int> _refCount;
     bool _autoDestroy;
 
     friend class Geometry;
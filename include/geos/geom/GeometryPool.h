@@ -0,0 +1,93 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_GEOMETRYPOOL_H
+#define GEOS_GEOM_GEOMETRYPOOL_H
+
+#include <geos/export.h>
+#include <geos/geom/GeometryFactory.h> // for GeometryFactory::Ptr
+#include <geos/util/Arena.h> // for composition
+
+#include <memory>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Geometry;
+class PrecisionModel;
+}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * Recycles the storage of geometries which are created and discarded
+ * one after the other, such as records decoded from a stream.
+ *
+ * Geometries built through getFactory() are allocated, along with
+ * their coordinates, from an Arena owned by the pool, which reuses the
+ * memory of deleted geometries for new ones of the same size. A reader
+ * using the pool (see io::WKBReader) thus stops allocating once it has
+ * seen a few records of each shape.
+ *
+ * The pool must outlive every geometry created from its factory.
+ * It is not thread-safe.
+ */
+class GEOS_DLL GeometryPool {
+
+public:
+
+    /**
+     * @param pm the PrecisionModel of the factory, floating if null
+     * @param srid the SRID of the factory
+     */
+    GeometryPool(const PrecisionModel* pm = nullptr, int srid = 0);
+
+    /// Returns the factory creating geometries in the pool
+    const GeometryFactory&
+    getFactory() const
+    {
+        return *factory;
+    }
+
+    /**
+     * Destroys a geometry. The memory of one from getFactory() goes
+     * back to the arena for the next geometry of the same shape.
+     */
+    void recycle(std::unique_ptr<Geometry> g);
+
+private:
+
+    util::Arena arena;
+
+    GeometryFactory::Ptr factory;
+
+    // Declare type as noncopyable
+    GeometryPool(const GeometryPool& other) = delete;
+    GeometryPool& operator=(const GeometryPool& rhs) = delete;
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_GEOM_GEOMETRYPOOL_H
@@ -0,0 +1,224 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_PACKEDCOORDINATESEQUENCE_H
+#define GEOS_GEOM_PACKEDCOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <geos/geom/CoordinateSequence.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Coordinate;
+}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * A CoordinateSequence storing its ordinates in a single contiguous
+ * array of doubles.
+ *
+ * Coordinates are packed as XY pairs, or as XYZ triples once a
+ * coordinate with a Z value is stored in the sequence.
+ * The packed array is available through the non-virtual
+ * data() and stride() accessors, which allow tight loops over
+ * the ordinates without a virtual call per point.
+ *
+ * getAt(std::size_t) and apply_ro() must hand out references to
+ * Coordinate objects, which the packed doubles are not. The first such
+ * call builds an array of Coordinate objects mirroring the packed
+ * ordinates, once even if several threads make it, and keeps it in
+ * sync from then on.
+ *
+ * The memory saving only holds for code which avoids reference access:
+ * getAt(std::size_t, Coordinate&), getX(), getY(), getOrdinate(),
+ * expandEnvelope() and the packed accessors read the ordinates
+ * directly. Most algorithms of the library take references (noding,
+ * relate, overlay...), and a sequence they have read carries both
+ * the packed array and the mirror.
+ */
+class GEOS_DLL PackedCoordinateSequence final : public CoordinateSequence {
+public:
+
+    /// Construct an empty XY sequence
+    PackedCoordinateSequence();
+
+    /**
+     * Construct sequence of n coordinates, initialized to (0, 0)
+     *
+     * @param n the number of coordinates
+     * @param dimension_in 3 to store Z values, any other value for XY only
+     */
+    PackedCoordinateSequence(std::size_t n, std::size_t dimension_in = 2);
+
+    /**
+     * Construct sequence taking ownership of the given packed ordinates
+     *
+     * @param coords_in ordinates, packed by dimension
+     * @param dimension_in 2 for XY or 3 for XYZ
+     */
+    PackedCoordinateSequence(std::vector<double>&& coords_in, std::size_t dimension_in);
+
+    /**
+     * Construct sequence from the given coordinates, storing Z values
+     * if dimension is 3 or any of the coordinates has a Z value.
+     */
+    PackedCoordinateSequence(const std::vector<Coordinate>& coords_in,
+                             std::size_t dimension_in = 0);
+
+    PackedCoordinateSequence(const PackedCoordinateSequence& seq);
+
+    PackedCoordinateSequence(const CoordinateSequence& seq);
+
+    ~PackedCoordinateSequence() override;
+
+    /// Returns the packed ordinates, stride() values per coordinate
+    const double*
+    data() const
+    {
+        return coords.data();
+    }
+
+    /// Returns the number of ordinates stored per coordinate (2 or 3)
+    std::size_t
+    stride() const
+    {
+        return dimension;
+    }
+
+    std::unique_ptr<CoordinateSequence> clone() const override;
+
+    const Coordinate& getAt(std::size_t pos) const override;
+
+    void getAt(std::size_t i, Coordinate& c) const override;
+
+    /// Returns a copy of the first Coordinate, not building the mirror
+    Coordinate
+    front() const
+    {
+        Coordinate c;
+        getAt(0, c);
+        return c;
+    }
+
+    /// Returns a copy of the last Coordinate, not building the mirror
+    Coordinate
+    back() const
+    {
+        Coordinate c;
+        getAt(getSize() - 1, c);
+        return c;
+    }
+
+    /// Whether the Coordinate array mirroring the storage has been built
+    bool
+    hasCoordinateMirror() const
+    {
+        return coordRefs.load() != nullptr;
+    }
+
+    std::size_t
+    getSize() const override
+    {
+        return coords.size() / dimension;
+    }
+
+    void toVector(std::vector<Coordinate>& out) const override;
+
+    bool
+    isEmpty() const override
+    {
+        return coords.empty();
+    }
+
+    using CoordinateSequence::add;
+
+    void add(const Coordinate& c) override;
+
+    void add(const Coordinate& c, bool allowRepeated) override;
+
+    void add(std::size_t i, const Coordinate& coord, bool allowRepeated) override;
+
+    void setAt(const Coordinate& c, std::size_t pos) override;
+
+    void setPoints(const std::vector<Coordinate>& v) override;
+
+    std::size_t
+    getDimension() const override
+    {
+        return dimension;
+    }
+
+    double getOrdinate(std::size_t index, std::size_t ordinateIndex) const override;
+
+    double
+    getX(std::size_t index) const override
+    {
+        return coords[index * dimension];
+    }
+
+    double
+    getY(std::size_t index) const override
+    {
+        return coords[index * dimension + 1];
+    }
+
+    void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+                     double value) override;
+
+    void expandEnvelope(Envelope& env) const override;
+
+    void apply_rw(const CoordinateFilter* filter) override;
+
+    void apply_ro(CoordinateFilter* filter) const override;
+
+private:
+
+    /// Switches storage from XY to XYZ, keeping existing coordinates
+    void promoteToXYZ();
+
+    /// Returns the Coordinate array backing getAt, building
+    /// the mirror if needed
+    const Coordinate* coordinateArray() const;
+
+    /// Drops the mirror, which no longer matches the storage
+    void dropMirror();
+
+    std::vector<double> coords;
+
+    std::size_t dimension;
+
+    /// Mirror of the storage, null until needed
+    mutable std::atomic<std::vector<Coordinate>*> coordRefs;
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_GEOM_PACKEDCOORDINATESEQUENCE_H
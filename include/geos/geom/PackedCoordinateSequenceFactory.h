@@ -0,0 +1,55 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_PACKEDCOORDINATESEQUENCEFACTORY_H
+#define GEOS_GEOM_PACKEDCOORDINATESEQUENCEFACTORY_H
+
+#include <geos/export.h>
+#include <geos/geom/CoordinateSequenceFactory.h> // for inheritance
+
+#include <vector>
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Coordinate;
+}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * Creates PackedCoordinateSequence objects.
+ *
+ * Sequences are created with XY storage unless a dimension of 3 is
+ * requested or the source coordinates carry Z values.
+ */
+class GEOS_DLL PackedCoordinateSequenceFactory: public CoordinateSequenceFactory {
+
+public:
+    std::unique_ptr<CoordinateSequence> create() const override;
+
+    std::unique_ptr<CoordinateSequence> create(std::vector<Coordinate>* coords, std::size_t dims = 0) const override;
+
+    std::unique_ptr<CoordinateSequence> create(std::size_t size, std::size_t dimension = 0) const override;
+
+    std::unique_ptr<CoordinateSequence> create(const CoordinateSequence& coordSeq) const override;
+
+    static const CoordinateSequenceFactory* instance();
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_PACKEDCOORDINATESEQUENCEFACTORY_H
@@ -24,10 +24,9 @@
 
 #include <geos/export.h>
 #include <vector>
-#include <set>
 #include <string>
 
-#include <geos/geomgraph/EdgeIntersection.h> // for EdgeIntersectionLessThen
+#include <geos/geomgraph/EdgeIntersection.h> // for composition
 #include <geos/geom/Coordinate.h> // for CoordinateLessThen
 
 #include <geos/inline.h>
@@ -58,12 +57,24 @@ namespace geomgraph { // geos.geomgraph
  */
 class GEOS_DLL EdgeIntersectionList {
 public:
-    typedef std::set<EdgeIntersection*, EdgeIntersectionLessThen> container;
-    typedef container::iterator iterator;
+    typedef std::vector<EdgeIntersection> container;
+    typedef container::const_iterator iterator;
     typedef container::const_iterator const_iterator;
 
 private:
-    container nodeMap;
+    // intersections in insertion order until prepare()
+    // sorts and dedupes them
+    mutable container nodeMap;
+
+    // true if nodeMap is sorted and has no duplicates
+    mutable bool ready;
+
+    // size of nodeMap after the last prepare()
+    mutable std::size_t preparedSize;
+
+    /// Sorts the intersections and removes the duplicates, keeping the
+    /// first one added, if any was added since the last call.
+    void prepare() const;
 
 public:
 
@@ -72,34 +83,39 @@ public:
     ~EdgeIntersectionList();
 
     /*
-     * Adds an intersection into the list, if it isn't already there.
+     * Adds an intersection into the list, unless it is already there.
      * The input segmentIndex and dist are expected to be normalized.
-     * @return the EdgeIntersection found or added
+     * The list is sorted and deduplicated on the next ordered access,
+     * or once it has doubled in size. An intersection equal to the
+     * last one added is skipped right away.
      */
-    EdgeIntersection* add(const geom::Coordinate& coord,
-                          size_t segmentIndex, double dist);
+    void add(const geom::Coordinate& coord,
+             size_t segmentIndex, double dist);
 
-    iterator
-    begin()
-    {
-        return nodeMap.begin();
-    }
-    iterator
-    end()
-    {
-        return nodeMap.end();
-    }
+    /// Sorts the intersections added since the last call, so it is
+    /// not safe to call from several threads at once (nor is end())
     const_iterator
     begin() const
     {
+        prepare();
         return nodeMap.begin();
     }
     const_iterator
     end() const
     {
+        prepare();
         return nodeMap.end();
     }
 
+    /// Removes all the intersections
+    void
+    clear()
+    {
+        nodeMap.clear();
+        ready = true;
+        preparedSize = 0;
+    }
+
     bool isEmpty() const;
     bool isIntersection(const geom::Coordinate& pt) const;
 
@@ -118,7 +134,8 @@ public:
      */
     void addSplitEdges(std::vector<Edge*>* edgeList);
 
-    Edge* createSplitEdge(EdgeIntersection* ei0, EdgeIntersection* ei1);
+    Edge* createSplitEdge(const EdgeIntersection* ei0,
+                          const EdgeIntersection* ei1);
     std::string print() const;
 
 };
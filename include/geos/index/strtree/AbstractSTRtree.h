@@ -140,6 +140,8 @@ public:
 class GEOS_DLL AbstractSTRtree {
 
 private:
+    friend class FrozenSTRtree;
+
     bool built;
     BoundableList* itemBoundables;
 
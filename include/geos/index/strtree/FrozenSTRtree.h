@@ -0,0 +1,169 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_FROZENSTRTREE_H
+#define GEOS_INDEX_STRTREE_FROZENSTRTREE_H
+
+#include <geos/export.h>
+#include <geos/geom/Envelope.h>
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace index {
+class ItemVisitor;
+namespace strtree {
+class STRtree;
+}
+}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * An immutable snapshot of a built STRtree, safe to query from
+ * several threads at the same time.
+ *
+ * The node structure of the source tree is copied into contiguous
+ * arrays, and all query methods are const and do not modify any state,
+ * so no locking is needed to share one instance between readers.
+ * The source tree can be destroyed once the snapshot is taken;
+ * the items themselves are held by reference only.
+ *
+ * Items are identified by an id in [0, size()), which is their position
+ * in the leaf order of the tree. getItem() and getItemEnvelope() map
+ * ids back to the indexed items.
+ */
+class GEOS_DLL FrozenSTRtree {
+public:
+
+    /**
+     * Takes a snapshot of the given tree, building it first if needed.
+     *
+     * @param tree the tree to copy. No items can be inserted in it
+     *             afterwards, as it is built.
+     */
+    explicit FrozenSTRtree(STRtree& tree);
+
+    /// Returns the number of items in the tree
+    std::size_t
+    size() const
+    {
+        return items.size();
+    }
+
+    /// Returns the item with the given id
+    void*
+    getItem(std::size_t id) const
+    {
+        return items[id];
+    }
+
+    /// Returns the envelope the item with the given id was inserted with
+    const geom::Envelope&
+    getItemEnvelope(std::size_t id) const
+    {
+        return itemEnvs[id];
+    }
+
+    /**
+     * Finds the items whose envelopes intersect the given search envelope.
+     *
+     * @param searchEnv the envelope to query
+     * @param matches found items are appended to this vector
+     */
+    void query(const geom::Envelope& searchEnv, std::vector<void*>& matches) const;
+
+    /**
+     * Visits the items whose envelopes intersect the given search envelope.
+     */
+    void query(const geom::Envelope& searchEnv, ItemVisitor& visitor) const;
+
+    /**
+     * Finds the ids of the items whose envelopes intersect the given
+     * search envelope.
+     *
+     * @param searchEnv the envelope to query
+     * @param ids found ids are appended to this vector
+     */
+    void queryIds(const geom::Envelope& searchEnv, std::vector<std::size_t>& ids) const;
+
+    /**
+     * Queries the tree with each of the given envelopes.
+     *
+     * Results are returned in compressed sparse row form: the ids of the
+     * items matching searchEnvs[i] are
+     * ids[offsets[i]] ... ids[offsets[i + 1] - 1].
+     * The result does not depend on the number of threads used.
+     *
+     * @param searchEnvs the envelopes to query
+     * @param offsets set to searchEnvs.size() + 1 offsets into ids
+     * @param ids set to the ids of the matching items
+     * @param numThreads maximum number of threads to use, including the
+     *                   calling one. 0 or 1 runs the queries sequentially.
+     */
+    void queryBatch(const std::vector<geom::Envelope>& searchEnvs,
+                    std::vector<std::size_t>& offsets,
+                    std::vector<std::size_t>& ids,
+                    std::size_t numThreads = 1) const;
+
+private:
+
+    struct Node {
+        geom::Envelope env;
+        /// Index of the first child in nodes, or in items for a leaf
+        std::size_t childStart;
+        std::size_t childCount;
+        bool isLeaf;
+    };
+
+    /// Calls visitId for the id of each item intersecting searchEnv
+    template<class Visitor>
+    void visitIds(const geom::Envelope& searchEnv, Visitor& visitId) const;
+
+    /// Runs the queries for searchEnvs[start, end)
+    void queryRange(const std::vector<geom::Envelope>& searchEnvs,
+                    std::size_t start, std::size_t end,
+                    std::vector<std::size_t>& counts,
+                    std::vector<std::size_t>& ids) const;
+
+    /// Root first, the children of each node are contiguous
+    std::vector<Node> nodes;
+
+    std::vector<geom::Envelope> itemEnvs;
+
+    std::vector<void*> items;
+
+    // Declare type as noncopyable
+    FrozenSTRtree(const FrozenSTRtree& other) = delete;
+    FrozenSTRtree& operator=(const FrozenSTRtree& rhs) = delete;
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_FROZENSTRTREE_H
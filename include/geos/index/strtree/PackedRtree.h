@@ -0,0 +1,186 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_PACKEDRTREE_H
+#define GEOS_INDEX_STRTREE_PACKEDRTREE_H
+
+#include <geos/export.h>
+#include <geos/geom/Envelope.h>
+
+#include <cstddef>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace index {
+class ItemVisitor;
+}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * A query-only R-tree stored as flat arrays.
+ *
+ * Items are inserted first, then the tree is packed once by build().
+ * Items are ordered either by the Sort-Tile-Recursive algorithm, as
+ * STRtree does, or along a Hilbert curve through the centres of their
+ * envelopes. Each level of the tree is then made of consecutive groups
+ * of nodeCapacity entries of the level below.
+ *
+ * Unlike STRtree no node objects are allocated: the envelopes of all
+ * items and nodes are stored in four contiguous arrays of minimum and
+ * maximum ordinates, leaves first and root last, and the children of a
+ * node are found by their offset in those arrays.
+ *
+ * Query methods are const and can be called from several threads
+ * once the tree is built.
+ * Items are identified by their insertion index. As in STRtree, items
+ * with a null envelope are not added and do not get an index.
+ */
+class GEOS_DLL PackedRtree {
+public:
+
+    /// The order in which items are packed into leaves
+    enum Packing {
+        /// Sort-Tile-Recursive: vertical slices sorted by Y
+        SORT_TILE_RECURSIVE,
+        /// Sorted by the Hilbert code of the envelope centre
+        HILBERT
+    };
+
+    /**
+     * Constructs an empty tree
+     *
+     * @param nodeCapacity_in maximum number of children of a node, at least 2
+     * @param packing_in the order in which items are packed
+     */
+    explicit PackedRtree(std::size_t nodeCapacity_in = 10,
+                         Packing packing_in = SORT_TILE_RECURSIVE);
+
+    /**
+     * Adds an item to the tree, unless its envelope is null.
+     *
+     * @throws util::IllegalStateException if the tree is already built
+     */
+    void insert(const geom::Envelope* itemEnv, void* item);
+
+    /**
+     * Packs the inserted items into the tree.
+     * Must be called once, before any query. Later calls do nothing.
+     */
+    void build();
+
+    bool
+    isBuilt() const
+    {
+        return built;
+    }
+
+    /// Returns the number of items inserted
+    std::size_t
+    size() const
+    {
+        return items.size();
+    }
+
+    /// Returns the number of nodes above the items, once built
+    std::size_t
+    getNumNodes() const
+    {
+        return minX.size() - items.size();
+    }
+
+    /// Returns the number of bytes used by the tree arrays
+    std::size_t getMemoryUsage() const;
+
+    /// Returns the item inserted with the given index
+    void*
+    getItem(std::size_t id) const
+    {
+        return items[id];
+    }
+
+    /**
+     * Finds the items whose envelopes intersect the given search envelope.
+     *
+     * @throws util::IllegalStateException if the tree is not built
+     */
+    void query(const geom::Envelope& searchEnv, std::vector<void*>& matches) const;
+
+    /**
+     * Visits the items whose envelopes intersect the given search envelope.
+     *
+     * @throws util::IllegalStateException if the tree is not built
+     */
+    void query(const geom::Envelope& searchEnv, ItemVisitor& visitor) const;
+
+    /**
+     * Finds the insertion indexes of the items whose envelopes intersect
+     * the given search envelope.
+     *
+     * @throws util::IllegalStateException if the tree is not built
+     */
+    void queryIds(const geom::Envelope& searchEnv, std::vector<std::size_t>& ids) const;
+
+private:
+
+    /// Calls visitId for the id of each item intersecting searchEnv
+    template<class Visitor>
+    void visitIds(const geom::Envelope& searchEnv, Visitor& visitId) const;
+
+    /// Returns the leaf order of the items following packing
+    std::vector<std::size_t> sortItems() const;
+
+    /// Appends entry i of the arrays to the extent of the node at pos
+    void expandNode(std::size_t pos, std::size_t i);
+
+    std::size_t nodeCapacity;
+
+    Packing packing;
+
+    bool built;
+
+    std::vector<void*> items;
+
+    /// Envelopes of the items, then of the nodes, level by level.
+    /// Before build, only the item envelopes in insertion order.
+    std::vector<double> minX;
+    std::vector<double> minY;
+    std::vector<double> maxX;
+    std::vector<double> maxY;
+
+    /// For items, the insertion index; for nodes, the position of the
+    /// first child in the envelope arrays.
+    std::vector<std::size_t> indices;
+
+    /// End position in the envelope arrays of each level, leaves first
+    std::vector<std::size_t> levelEnds;
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_PACKEDRTREE_H
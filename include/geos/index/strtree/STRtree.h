@@ -102,6 +102,16 @@ private:
 
     bool isWithinDistance(BoundablePair* initBndPair, double maxDistance);
 
+    /**
+     * Pops pairs of the tree and the given item in order of
+     * increasing distance, appending the items of leaf pairs to
+     * result, until maxCount items are found or the next pair is
+     * farther than maxDistance.
+     */
+    void nearestItems(const geom::Envelope* env, const void* item,
+                      ItemDistance* itemDist, std::size_t maxCount,
+                      double maxDistance, std::vector<const void*>& result);
+
 protected:
 
     AbstractNode* createNode(int level) override;
@@ -156,6 +166,38 @@ public:
     std::pair<const void*, const void*> nearestNeighbour(BoundablePair* initBndPair);
     std::pair<const void*, const void*> nearestNeighbour(BoundablePair* initBndPair, double maxDistance);
 
+    /**
+     * Finds the k items in this tree nearest to the given item,
+     * using ItemDistance as the distance metric.
+     *
+     * A Branch-and-Bound tree traversal algorithm is used
+     * to provide an efficient search.
+     *
+     * @param env the envelope of the query item
+     * @param item the item to find the nearest neighbours of
+     * @param k the maximum number of items to return
+     * @param itemDist a distance metric applicable to the items in this
+     *        tree and the query item
+     * @return up to k items, nearest first. Fewer than k items are
+     *         returned only if the tree has fewer than k items.
+     */
+    std::vector<const void*> kNearest(const geom::Envelope* env, const void* item,
+                                      std::size_t k, ItemDistance* itemDist);
+
+    /**
+     * Finds the items in this tree within the given distance of the
+     * given item, using ItemDistance as the distance metric.
+     *
+     * @param env the envelope of the query item
+     * @param item the query item
+     * @param maxDistance the maximum distance, inclusive
+     * @param itemDist a distance metric applicable to the items in this
+     *        tree and the query item
+     * @return the items within maxDistance of item, nearest first
+     */
+    std::vector<const void*> withinDistance(const geom::Envelope* env, const void* item,
+                                            double maxDistance, ItemDistance* itemDist);
+
     bool
     remove(const geom::Envelope* itemEnv, void* item) override
     {
@@ -26,7 +26,8 @@
 //#include <geos/io/ByteOrderValues.h>
 #include <geos/inline.h>
 
-#include <iosfwd> // ostream, istream (if we remove inlines)
+#include <cstddef> // for size_t
+#include <iosfwd> // for istream
 
 namespace geos {
 namespace io {
@@ -34,18 +35,33 @@ namespace io {
 /*
  * \class ByteOrderDataInStream io.h geos.h
  *
- * Allows reading an stream of primitive datatypes from an underlying
- * istream, with the representation being in either common byte ordering.
+ * Allows reading a buffer of primitive datatypes from memory, or from
+ * an underlying istream, with the representation being in either
+ * common byte ordering.
+ *
+ * A buffer is not copied and must outlive the reads made on it.
+ * Every read from a buffer is bounds checked and throws a
+ * ParseException when it would go past the end of the buffer.
+ * Reads from an istream only consume the bytes they need.
  *
  */
 class GEOS_DLL ByteOrderDataInStream {
 
 public:
 
-    ByteOrderDataInStream(std::istream* s = nullptr);
+    ByteOrderDataInStream(const unsigned char* buff = nullptr,
+                          std::size_t buffsz = 0);
+
+    ByteOrderDataInStream(std::istream* s);
 
     ~ByteOrderDataInStream();
 
+    /**
+     * Allows a single ByteOrderDataInStream to be reused
+     * on multiple buffers.
+     */
+    void setInStream(const unsigned char* buff, std::size_t buffsz);
+
     /**
      * Allows a single ByteOrderDataInStream to be reused
      * on multiple istream.
@@ -62,12 +78,31 @@ public:
 
     double readDouble(); // throws ParseException
 
+    /**
+     * Reads n consecutive doubles into out.
+     *
+     * When the stream byte order matches the machine byte order
+     * this is a single memcpy, or a single istream read.
+     */
+    void readDoubles(double* out, std::size_t n); // throws ParseException
+
+    /// Returns the number of bytes left to read, which is unknown
+    /// and returned as the largest size_t when reading an istream
+    std::size_t size() const;
+
 private:
     int byteOrder;
+    const unsigned char* buf;
+    const unsigned char* end;
+
+    /// Read from instead of buf if not null
     std::istream* stream;
 
-    // buffers to hold primitive datatypes
-    unsigned char buf[8];
+    /// Holds the bytes of a primitive read from stream
+    unsigned char streamBuf[8];
+
+    /// Returns the next nbytes, advancing past them
+    const unsigned char* take(std::size_t nbytes); // throws ParseException
 
 };
 
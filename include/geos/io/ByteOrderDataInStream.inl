@@ -25,15 +25,30 @@
 #include <geos/io/ByteOrderValues.h>
 #include <geos/util/Machine.h> // for getMachineByteOrder
 
-#include <iostream> // ostream, istream 
+#include <cstring> // for memcpy
+#include <istream>
+#include <limits>
 
 namespace geos {
 namespace io {
 
+INLINE
+ByteOrderDataInStream::ByteOrderDataInStream(const unsigned char* buff,
+        std::size_t buffsz)
+    :
+    byteOrder(getMachineByteOrder()),
+    buf(buff),
+    end(buff + buffsz),
+    stream(nullptr)
+{
+}
+
 INLINE
 ByteOrderDataInStream::ByteOrderDataInStream(std::istream* s)
     :
     byteOrder(getMachineByteOrder()),
+    buf(nullptr),
+    end(nullptr),
     stream(s)
 {
 }
@@ -43,9 +58,20 @@ ByteOrderDataInStream::~ByteOrderDataInStream()
 {
 }
 
+INLINE void
+ByteOrderDataInStream::setInStream(const unsigned char* buff,
+                                   std::size_t buffsz)
+{
+    buf = buff;
+    end = buff + buffsz;
+    stream = nullptr;
+}
+
 INLINE void
 ByteOrderDataInStream::setInStream(std::istream* s)
 {
+    buf = nullptr;
+    end = nullptr;
     stream = s;
 }
 
@@ -55,44 +81,88 @@ ByteOrderDataInStream::setOrder(int order)
     byteOrder = order;
 }
 
-INLINE unsigned char
-ByteOrderDataInStream::readByte() // throws ParseException
+INLINE std::size_t
+ByteOrderDataInStream::size() const
+{
+    if(stream) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    return static_cast<std::size_t>(end - buf);
+}
+
+INLINE const unsigned char*
+ByteOrderDataInStream::take(std::size_t nbytes)
 {
-    stream->read(reinterpret_cast<char*>(buf), 1);
-    if(stream->eof()) {
+    if(stream) {
+        stream->read(reinterpret_cast<char*>(streamBuf),
+                     static_cast<std::streamsize>(nbytes));
+        if(stream->eof()) {
+            throw  ParseException("Unexpected EOF parsing WKB");
+        }
+        return streamBuf;
+    }
+    if(size() < nbytes) {
         throw  ParseException("Unexpected EOF parsing WKB");
     }
-    return buf[0];
+    const unsigned char* ret = buf;
+    buf += nbytes;
+    return ret;
+}
+
+INLINE unsigned char
+ByteOrderDataInStream::readByte() // throws ParseException
+{
+    return *take(1);
 }
 
 INLINE int
 ByteOrderDataInStream::readInt()
 {
-    stream->read(reinterpret_cast<char*>(buf), 4);
-    if(stream->eof()) {
-        throw  ParseException("Unexpected EOF parsing WKB");
-    }
-    return ByteOrderValues::getInt(buf, byteOrder);
+    return ByteOrderValues::getInt(take(4), byteOrder);
 }
 
 INLINE long
 ByteOrderDataInStream::readLong()
 {
-    stream->read(reinterpret_cast<char*>(buf), 8);
-    if(stream->eof()) {
-        throw  ParseException("Unexpected EOF parsing WKB");
-    }
-    return static_cast<long>(ByteOrderValues::getLong(buf, byteOrder));
+    return static_cast<long>(ByteOrderValues::getLong(take(8), byteOrder));
 }
 
 INLINE double
 ByteOrderDataInStream::readDouble()
 {
-    stream->read(reinterpret_cast<char*>(buf), 8);
-    if(stream->eof()) {
+    return ByteOrderValues::getDouble(take(8), byteOrder);
+}
+
+INLINE void
+ByteOrderDataInStream::readDoubles(double* out, std::size_t n)
+{
+    if(stream) {
+        if(byteOrder == getMachineByteOrder()) {
+            stream->read(reinterpret_cast<char*>(out),
+                         static_cast<std::streamsize>(n * 8));
+            if(stream->eof()) {
+                throw  ParseException("Unexpected EOF parsing WKB");
+            }
+            return;
+        }
+        for(std::size_t i = 0; i < n; ++i) {
+            out[i] = readDouble();
+        }
+        return;
+    }
+
+    if(n > size() / 8) {
         throw  ParseException("Unexpected EOF parsing WKB");
     }
-    return ByteOrderValues::getDouble(buf, byteOrder);
+    if(byteOrder == getMachineByteOrder()) {
+        std::memcpy(out, buf, n * 8);
+        buf += n * 8;
+        return;
+    }
+    for(std::size_t i = 0; i < n; ++i) {
+        out[i] = ByteOrderValues::getDouble(buf, byteOrder);
+        buf += 8;
+    }
 }
 
 } // namespace io
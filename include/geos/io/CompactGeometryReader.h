@@ -0,0 +1,87 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_COMPACTGEOMETRYREADER_H
+#define GEOS_IO_COMPACTGEOMETRYREADER_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+#include <memory>
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class CoordinateSequence;
+class Geometry;
+class GeometryFactory;
+}
+namespace io {
+class CompactGeometryView;
+}
+}
+
+namespace geos {
+namespace io { // geos::io
+
+/**
+ * \brief
+ * Builds Geometries from the compact binary format written by
+ * CompactGeometryWriter.
+ *
+ * There is no parsing: each coordinate sequence is copied from the
+ * record in one go, and with a factory using
+ * PackedCoordinateSequenceFactory that copy is a single memcpy.
+ * Geometries are created through the given factory, so an arena-backed
+ * factory puts them all in one Arena.
+ *
+ * The SRID of the record is set on the result.
+ */
+class GEOS_DLL CompactGeometryReader {
+
+public:
+
+    CompactGeometryReader(const geom::GeometryFactory& f): factory(f) {}
+
+    /// Initialize reader with the default GeometryFactory
+    CompactGeometryReader();
+
+    /**
+     * Reads a record from memory.
+     *
+     * The record need not be aligned; if it is not, it is copied first.
+     *
+     * @param buf the record
+     * @param size the number of bytes available at buf
+     * @throws ParseException if buf does not hold a valid record
+     */
+    std::unique_ptr<geom::Geometry> read(const unsigned char* buf,
+                                         std::size_t size) const;
+
+    /// Builds the Geometry of a record already viewed in place
+    std::unique_ptr<geom::Geometry> read(const CompactGeometryView& view) const;
+
+private:
+
+    std::unique_ptr<geom::Geometry> readPart(const CompactGeometryView& view,
+            std::size_t part) const;
+
+    std::unique_ptr<geom::CoordinateSequence> readCoordinates(
+        const CompactGeometryView& view, std::size_t part) const;
+
+    const geom::GeometryFactory& factory;
+};
+
+} // namespace geos::io
+} // namespace geos
+
+#endif // GEOS_IO_COMPACTGEOMETRYREADER_H
@@ -0,0 +1,191 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_COMPACTGEOMETRYVIEW_H
+#define GEOS_IO_COMPACTGEOMETRYVIEW_H
+
+#include <geos/export.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h> // for GeometryTypeId
+
+#include <cstddef>
+#include <cstdint>
+
+namespace geos {
+namespace io { // geos::io
+
+/**
+ * \brief
+ * Read-only view of a geometry in the compact binary format written by
+ * CompactGeometryWriter.
+ *
+ * The format stores a geometry as a fixed size header, followed by the
+ * geometry tree flattened in pre-order into an array of Part entries,
+ * followed by the coordinates of all the components as a single array
+ * of doubles (XY or XYZ, see getDimension()):
+ *
+ * <pre>
+ * Header   64 bytes
+ * Part     24 bytes * numParts
+ * double   dimension * numCoords
+ * </pre>
+ *
+ * Values are in the byte order of the machine that wrote them, and
+ * every section is 8-byte aligned, so a record in a memory-mapped file
+ * can be used in place. Records are a multiple of 8 bytes long and can
+ * be concatenated, see getSize().
+ *
+ * Constructing a view checks the header and the part table, but does
+ * not touch the coordinates. Nothing is copied: the memory must stay
+ * valid and unchanged while the view is used.
+ */
+class GEOS_DLL CompactGeometryView {
+
+public:
+
+    struct Header {
+        /// "GCG1"
+        char magic[4];
+        /// WKBConstants::wkbXDR or WKBConstants::wkbNDR
+        std::uint8_t byteOrder;
+        /// 2 or 3
+        std::uint8_t dimension;
+        std::uint16_t reserved;
+        std::int32_t srid;
+        std::uint32_t numParts;
+        std::uint64_t numCoords;
+        /// Size of the whole record, in bytes
+        std::uint64_t size;
+        /// Envelope of the geometry, all zero if it is empty
+        double minx;
+        double miny;
+        double maxx;
+        double maxy;
+    };
+
+    struct Part {
+        /// A geom::GeometryTypeId
+        std::uint32_t type;
+        /// Coordinates of a Point, LineString or LinearRing,
+        /// rings of a Polygon, elements of a collection
+        std::uint32_t count;
+        /// Number of parts in the subtree rooted at this part, itself included
+        std::uint32_t extent;
+        std::uint32_t reserved;
+        /// Index of the first coordinate of the subtree
+        std::uint64_t coordStart;
+    };
+
+    static const char MAGIC[4];
+
+    /**
+     * Creates a view of the record at the start of the given memory.
+     *
+     * @param data the record, 8-byte aligned
+     * @param size the number of bytes available at data, which may
+     *             extend past the end of the record
+     * @throws ParseException if the memory does not hold a valid record
+     *         written on a machine with the same byte order
+     */
+    CompactGeometryView(const unsigned char* data, std::size_t size);
+
+    /// Returns the size of the record, in bytes
+    std::size_t
+    getSize() const
+    {
+        return static_cast<std::size_t>(header->size);
+    }
+
+    int
+    getSRID() const
+    {
+        return header->srid;
+    }
+
+    /// Returns the number of ordinates per coordinate, 2 or 3
+    std::size_t
+    getDimension() const
+    {
+        return header->dimension;
+    }
+
+    /// Returns the envelope of the geometry, null if it is empty
+    geom::Envelope getEnvelope() const;
+
+    std::size_t
+    getNumParts() const
+    {
+        return header->numParts;
+    }
+
+    /// Returns part i of the flattened geometry tree, 0 being the root
+    const Part&
+    getPart(std::size_t i) const
+    {
+        return parts[i];
+    }
+
+    geom::GeometryTypeId
+    getGeometryTypeId(std::size_t part = 0) const
+    {
+        return static_cast<geom::GeometryTypeId>(parts[part].type);
+    }
+
+    /**
+     * Returns the index of child n (a ring or collection element) of
+     * the given part. Linear in n.
+     */
+    std::size_t getChild(std::size_t part, std::size_t n) const;
+
+    /// Returns the number of coordinates in the whole geometry
+    std::size_t
+    getNumCoordinates() const
+    {
+        return static_cast<std::size_t>(header->numCoords);
+    }
+
+    /// Returns all the coordinates, getDimension() values per coordinate
+    const double*
+    getCoordinates() const
+    {
+        return coords;
+    }
+
+    /**
+     * Returns the coordinates of a Point, LineString or LinearRing part,
+     * getPart(part).count of them.
+     */
+    const double*
+    getCoordinates(std::size_t part) const
+    {
+        return coords + parts[part].coordStart * header->dimension;
+    }
+
+private:
+
+    /**
+     * Checks the subtree rooted at part i, whose coordinates should
+     * start at index start. Returns the number of coordinates in it.
+     */
+    std::uint64_t checkPart(std::size_t i, std::uint64_t start) const;
+
+    const Header* header;
+
+    const Part* parts;
+
+    const double* coords;
+};
+
+} // namespace geos::io
+} // namespace geos
+
+#endif // GEOS_IO_COMPACTGEOMETRYVIEW_H
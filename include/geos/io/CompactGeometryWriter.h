@@ -0,0 +1,95 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_COMPACTGEOMETRYWRITER_H
+#define GEOS_IO_COMPACTGEOMETRYWRITER_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class CoordinateSequence;
+class Geometry;
+}
+}
+
+namespace geos {
+namespace io { // geos::io
+
+/**
+ * \brief
+ * Writes a Geometry in the compact binary format described in
+ * CompactGeometryView.
+ *
+ * The format is meant for caching geometries between runs on the same
+ * kind of machine: reloading a record costs no parsing, it can be used
+ * in place through a CompactGeometryView or turned back into a Geometry
+ * by CompactGeometryReader with one copy of each coordinate sequence.
+ * Use WKB to exchange geometries with other systems.
+ *
+ * Z values are written if the coordinate dimension of the geometry is 3.
+ */
+class GEOS_DLL CompactGeometryWriter {
+
+public:
+
+    CompactGeometryWriter() {}
+
+    /**
+     * Returns the exact number of bytes write() produces for a Geometry,
+     * always a multiple of 8.
+     */
+    std::size_t getSize(const geom::Geometry& g) const;
+
+    /**
+     * Writes a Geometry to a caller-provided buffer, which should be
+     * 8-byte aligned for the record to be viewed in place.
+     *
+     * @param g the geometry to write
+     * @param buf the buffer to write to
+     * @param bufSize the capacity of buf, in bytes
+     * @return the number of bytes written
+     * @throws IllegalArgumentException if bufSize is too small
+     */
+    std::size_t write(const geom::Geometry& g, unsigned char* buf,
+                      std::size_t bufSize) const;
+
+    /// Writes a Geometry to an output stream
+    void write(const geom::Geometry& g, std::ostream& os) const;
+
+private:
+
+    struct Counts {
+        std::size_t numParts;
+        std::size_t numCoords;
+    };
+
+    static void count(const geom::Geometry& g, Counts& counts);
+
+    /// Writes the parts and coordinates of g, advancing the cursors
+    static void writeGeometry(const geom::Geometry& g, std::size_t dimension,
+                              unsigned char*& partOut, unsigned char*& coordOut,
+                              std::uint64_t& coordIndex);
+
+    static void writeCoordinates(const geom::CoordinateSequence& cs,
+                                 std::size_t dimension, unsigned char*& coordOut);
+};
+
+} // namespace geos::io
+} // namespace geos
+
+#endif // GEOS_IO_COMPACTGEOMETRYWRITER_H
@@ -0,0 +1,185 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IO_GEOMETRYSTREAMREADER_H
+#define GEOS_IO_GEOMETRYSTREAMREADER_H
+
+#include <geos/export.h>
+#include <geos/io/WKBReader.h> // for composition
+#include <geos/io/WKTReader.h> // for composition
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Geometry;
+class GeometryFactory;
+}
+}
+
+namespace geos {
+namespace io { // geos::io
+
+/**
+ * \brief
+ * Reads a sequence of geometries from a stream of WKB, WKT or HEXWKB
+ * records.
+ *
+ * The input is either a single memory block holding all the records,
+ * such as a memory-mapped file, which is read in place, or a series of
+ * chunks added as they arrive, in which records may span chunk
+ * boundaries.
+ *
+ * Geometries are returned one at a time by next(), or in batches by
+ * nextBatch(), which can decode the records of a batch on several
+ * threads while keeping them in input order.
+ *
+ * This class is not thread-safe.
+ */
+class GEOS_DLL GeometryStreamReader {
+
+public:
+
+    enum Format {
+        /// Each record is a 32-bit little-endian byte count followed by WKB
+        WKB,
+        /// One WKT geometry per line
+        WKT,
+        /// One HEX-encoded WKB geometry per line
+        HEXWKB
+    };
+
+    /**
+     * Creates a reader for the given record format.
+     *
+     * Blank lines are skipped in the line based formats, and line ends
+     * may be "\n" or "\r\n".
+     *
+     * @param factory the factory used to create the geometries
+     * @param format the format of the records
+     */
+    GeometryStreamReader(const geom::GeometryFactory& factory, Format format);
+
+    ~GeometryStreamReader();
+
+    /**
+     * Reads from the given memory block, which holds all the records
+     * and must remain valid while reading. It is not copied.
+     * Replaces any previous input.
+     */
+    void setInput(const unsigned char* data, std::size_t size);
+
+    /**
+     * Appends a chunk of input, which is copied.
+     * Call finish() once the last chunk has been added.
+     */
+    void addChunk(const unsigned char* data, std::size_t size);
+
+    /// Signals that no more chunks will be added
+    void finish();
+
+    /**
+     * Reads the next geometry.
+     *
+     * @return the geometry, or null if no complete record is available,
+     *         at the end of the input or while waiting for more chunks
+     * @throws ParseException if the record is malformed, or if the
+     *         input ends in the middle of a record
+     */
+    std::unique_ptr<geom::Geometry> next();
+
+    /**
+     * Reads up to maxCount of the available records, decoding them with
+     * up to numThreads threads.
+     *
+     * The geometries are appended to out in input order.
+     * If a record cannot be decoded, all records of the batch are still
+     * consumed and the error of the first malformed one is thrown.
+     *
+     * The records are decoded sequentially when the factory allocates
+     * from a util::Arena, which is not thread-safe.
+     *
+     * @param out vector to append the geometries to
+     * @param maxCount the maximum number of records to read
+     * @param numThreads maximum number of threads to use, including the
+     *                   calling one. 0 or 1 decodes sequentially.
+     * @return the number of geometries read, 0 if no complete record
+     *         is available
+     * @throws ParseException
+     */
+    std::size_t nextBatch(std::vector<std::unique_ptr<geom::Geometry>>& out,
+                          std::size_t maxCount, unsigned int numThreads = 1);
+
+    /// Returns the number of records read so far
+    std::size_t
+    getRecordCount() const
+    {
+        return recordCount;
+    }
+
+private:
+
+    struct Record {
+        const unsigned char* data;
+        std::size_t size;
+    };
+
+    /// Locates the next complete record, returns false if there is none
+    bool nextRecord(Record& rec);
+
+    /// Decodes one record using the given readers
+    std::unique_ptr<geom::Geometry> decode(const Record& rec,
+                                           WKBReader& wkbReader,
+                                           WKTReader& wktReader) const;
+
+    const geom::GeometryFactory& factory;
+
+    Format format;
+
+    /// Chunks not consumed yet, when reading with addChunk()
+    std::vector<unsigned char> buffer;
+
+    /// Input being read, either the setInput() block or buffer
+    const unsigned char* data;
+    std::size_t size;
+    std::size_t pos;
+
+    /// Whether no more input will be added after size
+    bool complete;
+
+    std::size_t recordCount;
+
+    WKBReader wkbReader;
+
+    WKTReader wktReader;
+
+    // Declare type as noncopyable
+    GeometryStreamReader(const GeometryStreamReader& other) = delete;
+    GeometryStreamReader& operator=(const GeometryStreamReader& rhs) = delete;
+};
+
+} // namespace geos::io
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_IO_GEOMETRYSTREAMREADER_H
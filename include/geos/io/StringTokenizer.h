@@ -22,6 +22,7 @@
 
 #include <geos/export.h>
 
+#include <cstddef>
 #include <string>
 
 #ifdef _MSC_VER
@@ -32,6 +33,16 @@
 namespace geos {
 namespace io {
 
+/**
+ * \brief
+ * Splits WKT text into numbers, words and the '(', ')' and ','
+ * separators.
+ *
+ * The tokenizer works on a range of characters it does not own and
+ * does not allocate while scanning: words are kept as a range into
+ * the input, and numbers are parsed in place independently of the
+ * current C locale.
+ */
 class GEOS_DLL StringTokenizer {
 public:
     enum {
@@ -40,18 +51,43 @@ public:
         TT_NUMBER,
         TT_WORD
     };
-    //StringTokenizer();
+
+    /// The string must outlive the tokenizer
     explicit StringTokenizer(const std::string& txt);
+
+    /// The len characters at txt must outlive the tokenizer
+    StringTokenizer(const char* txt, std::size_t len);
+
     ~StringTokenizer() {}
+
+    /// Consumes the next token and returns its type
     int nextToken();
+
+    /// Returns the type of the next token without consuming it
     int peekNextToken();
-    double getNVal();
-    std::string getSVal();
+
+    /// Value of the last TT_NUMBER token
+    double getNVal() const;
+
+    /// Text of the last TT_WORD token
+    std::string getSVal() const;
+
 private:
-    const std::string& str;
-    std::string stok;
+
+    /// Scans the token at iter into the tok* members
+    int scanToken();
+
+    const char* iter;
+    const char* const end;
+
+    // Last scanned token
+    int tokType;
     double ntok;
-    std::string::const_iterator iter;
+    const char* wordStart;
+    const char* wordEnd;
+
+    // Whether the last scanned token was peeked and not yet consumed
+    bool peeked;
 
     // Declare type as noncopyable
     StringTokenizer(const StringTokenizer& other) = delete;
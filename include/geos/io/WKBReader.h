@@ -23,9 +23,12 @@
 #include <geos/export.h>
 
 #include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Envelope.h> // for composition
+#include <geos/geom/PrecisionModel.h> // for unique_ptr
 #include <geos/io/ByteOrderDataInStream.h> // for composition
 
 #include <iosfwd> // ostream, istream
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -48,6 +51,7 @@ class Point;
 class LineString;
 class LinearRing;
 class Polygon;
+class GeometryPool;
 class MultiPoint;
 class MultiLineString;
 class MultiPolygon;
@@ -80,33 +84,111 @@ class GEOS_DLL WKBReader {
 
 public:
 
-    WKBReader(geom::GeometryFactory const& f): factory(f) {}
+    WKBReader(geom::GeometryFactory const& f): factory(f), pool(nullptr) {}
 
     /// Inizialize parser with default GeometryFactory.
     WKBReader();
 
+    /**
+     * \brief Initialize parser recycling storage from the given pool.
+     *
+     * Geometries are created with the pool factory, which keeps them
+     * and their coordinates in the arena of the pool. When decoding a
+     * stream of similar geometries, recycling each one with
+     * geom::GeometryPool::recycle() once done with it makes the reader
+     * stop allocating.
+     *
+     * @param p_pool the pool, which must outlive the reader
+     *               and the geometries read
+     */
+    explicit WKBReader(geom::GeometryPool& p_pool);
+
+    /**
+     * \brief Skips the geometries missing the given window.
+     *
+     * The reading functions then return null for a geometry whose
+     * envelope does not intersect the window. This is not an error:
+     * errors are always thrown. EMPTY geometries have a null envelope,
+     * which intersects no window, so they are always skipped while a
+     * window is set.
+     * The buffer and HEX overloads look at the coordinates only:
+     * nothing is built for the geometries they skip. read(std::istream&)
+     * cannot scan a stream twice, so it builds each geometry and drops
+     * those missing the window.
+     *
+     * @param env the window, which is copied, or null to read every
+     *            geometry (the default)
+     */
+    void setFilterEnvelope(const geom::Envelope* env);
+
+    /**
+     * \brief Reduces coordinates to the given precision while reading.
+     *
+     * X and Y values are rounded with this model instead of the one
+     * of the factory, and the consecutive repeated points it creates
+     * are dropped. As GeometryPrecisionReducer::reducePointwise does,
+     * lines and rings which would collapse keep all their points, and
+     * topology is not fixed: the result may be invalid.
+     *
+     * @param pm the precision model, which is copied, or null to use
+     *           the one of the factory (the default)
+     */
+    void setTargetPrecisionModel(const geom::PrecisionModel* pm);
+
     /**
      * \brief Reads a Geometry from an istream.
      *
      * @param is the stream to read from
-     * @return the Geometry read
+     * @return the Geometry read, or null if a filter envelope is set
+     *         and the geometry, EMPTY or not intersecting it, is skipped
      * @throws IOException
      * @throws ParseException
      */
     geom::Geometry* read(std::istream& is);
     // throws IOException, ParseException
 
+    /**
+     * \brief Reads a Geometry from a buffer in memory.
+     *
+     * This is the fastest way to read WKB: the buffer is decoded in
+     * place, without going through a std::istream, and runs of
+     * coordinates are copied in bulk when the WKB byte order matches
+     * the machine byte order. Element counts are checked against the
+     * number of bytes left before anything is allocated.
+     *
+     * @param buf the WKB bytes
+     * @param size the number of bytes in buf
+     * @return the Geometry read, or null if a filter envelope is set
+     *         and the geometry, EMPTY or not intersecting it, is skipped
+     * @throws ParseException
+     */
+    geom::Geometry* read(const unsigned char* buf, std::size_t size);
+    // throws ParseException
+
     /**
      * \brief Reads a Geometry from an istream in hex format.
      *
      * @param is the stream to read from
-     * @return the Geometry read
+     * @return the Geometry read, or null if a filter envelope is set
+     *         and the geometry, EMPTY or not intersecting it, is skipped
      * @throws IOException
      * @throws ParseException
      */
     geom::Geometry* readHEX(std::istream& is);
     // throws IOException, ParseException
 
+    /**
+     * \brief Reads a Geometry from size characters in hex format.
+     *
+     * @param hex the hex characters, not nul-terminated
+     * @param size the number of characters, which must be even
+     * @return the Geometry read, or null if a filter envelope is set
+     *         and the geometry, EMPTY or not intersecting it, is skipped
+     * @throws ParseException
+     */
+    geom::Geometry* readHEX(const char* hex, std::size_t size);
+    // throws ParseException
+
     /**
      * \brief Print WKB in HEX form to out stream
      *
@@ -119,6 +201,15 @@ private:
 
     const geom::GeometryFactory& factory;
 
+    /// Where filtered out geometries are recycled, if not null
+    geom::GeometryPool* pool;
+
+    /// Geometries missing it are skipped, unless it is null
+    geom::Envelope filterEnvelope;
+
+    /// Precision coordinates are reduced to, if not null
+    std::unique_ptr<geom::PrecisionModel> targetPrecisionModel;
+
     // for now support the WKB standard only - may be generalized later
     unsigned int inputDimension;
 
@@ -126,9 +217,26 @@ private:
 
     std::vector<double> ordValues;
 
+    /// Coordinates decoded for a factory copying them to its arena
+    std::vector<geom::Coordinate> coordBuffer;
+
+    /// Reads the byte order, type, dimension and SRID, returns the type
+    int readGeometryHeader(int& SRID);
+    // throws ParseException
+
     geom::Geometry* readGeometry();
     // throws IOException, ParseException
 
+    /**
+     * Reads past a geometry, adding its coordinates to env.
+     * Returns true as soon as one is found inside the filter envelope.
+     */
+    bool scanGeometry(geom::Envelope& env);
+    // throws ParseException
+
+    bool scanCoordinates(std::size_t size, geom::Envelope& env);
+    // throws ParseException
+
     geom::Point* readPoint();
     // throws IOException
 
@@ -153,7 +261,14 @@ private:
     geom::GeometryCollection* readGeometryCollection();
     // throws IOException, ParseException
 
-    std::unique_ptr<geom::CoordinateSequence> readCoordinateSequence(int); // throws IOException
+    /// minSize is the minimum length of the sequence when dropping repeated points
+    std::unique_ptr<geom::CoordinateSequence> readCoordinateSequence(std::size_t size,
+            std::size_t minSize); // throws IOException
+
+    static void removeRepeatedPoints(std::vector<geom::Coordinate>& coords,
+                                     std::size_t minSize);
+
+    std::size_t readCount(std::size_t minItemBytes); // throws ParseException
 
     void readCoordinate(); // throws IOException
 
@@ -23,6 +23,7 @@
 #include <geos/export.h>
 
 #include <geos/util/Machine.h> // for getMachineByteOrder
+#include <cstddef>
 #include <iosfwd>
 
 // Forward declarations
@@ -170,6 +171,31 @@ public:
     void writeHEX(const geom::Geometry& g, std::ostream& os);
     // throws IOException, ParseException
 
+    /**
+     * \brief Returns the exact number of bytes write() produces for
+     * a Geometry with the current settings.
+     *
+     * @param g the geometry to measure
+     * @throws IllegalArgumentException if g cannot be represented in WKB
+     */
+    std::size_t getWKBSize(const geom::Geometry& g) const;
+
+    /**
+     * \brief Write a Geometry to a caller-provided buffer.
+     *
+     * The output is serialized in place, with no intermediate stream
+     * or copy. Use getWKBSize() to size the buffer.
+     *
+     * @param g the geometry to write
+     * @param buf the buffer to write to
+     * @param bufSize the capacity of buf, in bytes
+     * @return the number of bytes written
+     * @throws IllegalArgumentException if bufSize is too small or
+     *         g cannot be represented in WKB
+     */
+    std::size_t write(const geom::Geometry& g, unsigned char* buf,
+                      std::size_t bufSize);
+
 private:
 
     int defaultOutputDimension;
@@ -179,9 +205,12 @@ private:
 
     bool includeSRID;
 
-    std::ostream* outStream;
+    // Write position in the output buffer
+    unsigned char* out;
+
+    std::size_t computeSize(const geom::Geometry& g, bool withSRID) const;
 
-    unsigned char buf[8];
+    void writeGeometry(const geom::Geometry& g);
 
     void writePoint(const geom::Point& p);
     // throws IOException
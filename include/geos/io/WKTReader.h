@@ -83,6 +83,9 @@ public:
     /// Parse a WKT string returning a Geometry
     geom::Geometry* read(const std::string& wellKnownText);
 
+    /// Parse size characters of WKT, not nul-terminated, returning a Geometry
+    geom::Geometry* read(const char* wellKnownText, std::size_t size);
+
 //	Geometry* read(Reader& reader);	//Not implemented yet
 
 protected:
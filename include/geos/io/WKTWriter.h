@@ -221,6 +221,9 @@ protected:
 
     std::string writeNumber(double d);
 
+    /// Appends writeNumber(d) to writer without a temporary string
+    void appendNumber(double d, Writer* writer);
+
     void appendLineStringText(
         const geom::LineString* lineString,
         int level, bool doIndent, Writer* writer);
@@ -0,0 +1,216 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2016 Vivid Solutions Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: math/DD.java (JTS-1.16)
+ *
+ **********************************************************************/
+
+#ifndef GEOS_MATH_DD_H
+#define GEOS_MATH_DD_H
+
+#include <geos/export.h>
+
+namespace geos {
+namespace math { // geos::math
+
+/**
+ * \brief
+ * Implements extended-precision floating-point numbers
+ * which maintain 106 bits (approximately 30 decimal digits) of precision.
+ *
+ * A DD uses a representation containing two double-precision values.
+ * A number x is represented as a pair of doubles, x.hi and x.lo,
+ * such that the number represented by x is x.hi + x.lo, where
+ *
+ *    |x.lo| <= 0.5*ulp(x.hi)
+ *
+ * and ulp(y) means "unit in the last place of y".
+ * The basic arithmetic operations are implemented using
+ * convenient properties of IEEE-754 floating-point arithmetic.
+ *
+ * The range of values which can be represented is the same as in IEEE-754.
+ * The precision of the representable numbers
+ * is twice as great as IEEE-754 double precision.
+ *
+ * The correctness of the arithmetic algorithms relies on operations
+ * being performed with standard IEEE-754 double precision and rounding.
+ * This is the Java standard arithmetic model, but for performance reasons
+ * may not be the default on some C platforms (e.g. x87 extended precision
+ * or builds using -ffast-math).
+ *
+ * The algorithms are due to T.J. Dekker and D. Priest, as
+ * collected by Yozo Hida, Xiaoye S. Li and David H. Bailey.
+ */
+class GEOS_DLL DD {
+
+private:
+
+    /**
+     * The value to split a double-precision value on during multiplication,
+     * 2^27 + 1 for IEEE-754 double precision.
+     */
+    static constexpr double SPLIT = 134217729.0;
+
+    double hi;
+    double lo;
+
+public:
+
+    DD(double p_hi, double p_lo) : hi(p_hi), lo(p_lo) {}
+
+    DD(double x) : hi(x), lo(0.0) {}
+
+    DD() : hi(0.0), lo(0.0) {}
+
+    bool operator==(const DD& rhs) const
+    {
+        return hi == rhs.hi && lo == rhs.lo;
+    }
+
+    bool operator!=(const DD& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    bool operator<(const DD& rhs) const
+    {
+        return (hi < rhs.hi) || (hi == rhs.hi && lo < rhs.lo);
+    }
+
+    bool operator>(const DD& rhs) const
+    {
+        return rhs < *this;
+    }
+
+    bool operator<=(const DD& rhs) const
+    {
+        return !(rhs < *this);
+    }
+
+    bool operator>=(const DD& rhs) const
+    {
+        return !(*this < rhs);
+    }
+
+    friend GEOS_DLL DD operator+ (const DD& lhs, const DD& rhs);
+    friend GEOS_DLL DD operator+ (const DD& lhs, double rhs);
+    friend GEOS_DLL DD operator- (const DD& lhs, const DD& rhs);
+    friend GEOS_DLL DD operator- (const DD& lhs, double rhs);
+    friend GEOS_DLL DD operator* (const DD& lhs, const DD& rhs);
+    friend GEOS_DLL DD operator* (const DD& lhs, double rhs);
+    friend GEOS_DLL DD operator/ (const DD& lhs, const DD& rhs);
+    friend GEOS_DLL DD operator/ (const DD& lhs, double rhs);
+
+    DD operator-() const
+    {
+        return DD(-hi, -lo);
+    }
+
+    DD& operator+=(const DD& d);
+    DD& operator+=(double d);
+    DD& operator-=(const DD& d);
+    DD& operator-=(double d);
+    DD& operator*=(const DD& d);
+    DD& operator*=(double d);
+    DD& operator/=(const DD& d);
+    DD& operator/=(double d);
+
+    /**
+     * Computes the determinant of the 2x2 matrix with the given entries.
+     *
+     * @return the determinant of the values x1 * y2 - y1 * x2
+     */
+    static DD determinant(const DD& x1, const DD& y1, const DD& x2, const DD& y2);
+    static DD determinant(double x1, double y1, double x2, double y2);
+
+    /**
+     * Returns the sign of this value: 1 if positive, -1 if negative,
+     * 0 if zero.
+     */
+    int signum() const
+    {
+        if(hi > 0) {
+            return 1;
+        }
+        if(hi < 0) {
+            return -1;
+        }
+        if(lo > 0) {
+            return 1;
+        }
+        if(lo < 0) {
+            return -1;
+        }
+        return 0;
+    }
+
+    bool isZero() const
+    {
+        return hi == 0.0 && lo == 0.0;
+    }
+
+    bool isNegative() const
+    {
+        return hi < 0.0 || (hi == 0.0 && lo < 0.0);
+    }
+
+    bool isNaN() const;
+
+    /// Returns the high-order component of the value.
+    double getHi() const
+    {
+        return hi;
+    }
+
+    /// Returns the low-order component of the value.
+    double getLo() const
+    {
+        return lo;
+    }
+
+    /// Converts this value to the nearest double-precision number.
+    double doubleValue() const
+    {
+        return hi + lo;
+    }
+
+    DD abs() const
+    {
+        return isNegative() ? -(*this) : *this;
+    }
+
+    DD reciprocal() const;
+
+    void selfAdd(const DD& d);
+    void selfAdd(double p_hi, double p_lo);
+    void selfAdd(double y);
+
+    void selfSubtract(const DD& d);
+    void selfSubtract(double p_hi, double p_lo);
+    void selfSubtract(double y);
+
+    void selfMultiply(const DD& d);
+    void selfMultiply(double p_hi, double p_lo);
+    void selfMultiply(double y);
+
+    void selfDivide(const DD& d);
+    void selfDivide(double p_hi, double p_lo);
+    void selfDivide(double y);
+};
+
+
+} // namespace geos::math
+} // namespace geos
+
+#endif // GEOS_MATH_DD_H
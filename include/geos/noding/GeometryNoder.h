@@ -42,8 +42,19 @@ public:
 
     static std::unique_ptr<geom::Geometry> node(const geom::Geometry& geom);
 
+    /// Nodes geom computing the intersections on numThreads threads
+    static std::unique_ptr<geom::Geometry> node(const geom::Geometry& geom,
+                                                unsigned int numThreads);
+
     GeometryNoder(const geom::Geometry& g);
 
+    /// Sets the number of threads computing the intersections (default 1)
+    void
+    setNumThreads(unsigned int n)
+    {
+        numThreads = n;
+    }
+
     std::unique_ptr<geom::Geometry> getNoded();
 
 private:
@@ -52,6 +63,8 @@ private:
 
     SegmentString::NonConstVect lineList;
 
+    unsigned int numThreads;
+
     static void extractSegmentStrings(const geom::Geometry& g,
                                       SegmentString::NonConstVect& to);
 
@@ -62,6 +62,7 @@ private:
     algorithm::LineIntersector li;
     std::vector<SegmentString*>* nodedSegStrings;
     int maxIter;
+    unsigned int numThreads;
 
     /**
      * Node the input segment strings once
@@ -70,13 +71,17 @@ private:
     void node(std::vector<SegmentString*>* segStrings,
               int* numInteriorIntersections);
 
+    void nodeParallel(std::vector<SegmentString*>* segStrings,
+                      int* numInteriorIntersections);
+
 public:
 
     IteratedNoder(const geom::PrecisionModel* newPm)
         :
         pm(newPm),
         li(pm),
-        maxIter(MAX_ITER)
+        maxIter(MAX_ITER),
+        numThreads(1)
     {
     }
 
@@ -97,6 +102,19 @@ public:
         maxIter = n;
     }
 
+    /**
+     * Sets the number of threads computing the intersections
+     * of each noding iteration (see MCIndexNoder::setSegmentIntersectors).
+     * The default is 1.
+     *
+     * @param n the number of threads to use
+     */
+    void
+    setNumThreads(unsigned int n)
+    {
+        numThreads = n;
+    }
+
     std::vector<SegmentString*>*
     getNodedSubstrings() const override
     {
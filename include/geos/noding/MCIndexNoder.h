@@ -28,6 +28,8 @@
 #include <geos/index/strtree/STRtree.h> // for composition
 #include <geos/util.h>
 
+#include <atomic>
+#include <cstddef>
 #include <vector>
 #include <iostream>
 
@@ -67,11 +69,19 @@ private:
     index::strtree::STRtree index;
     int idCounter;
     std::vector<SegmentString*>* nodedSegStrings;
+    std::vector<SegmentIntersector*> threadSegInts;
     // statistics
     int nOverlaps;
 
     void intersectChains();
 
+    void intersectChainsParallel();
+
+    /// Computes the overlaps of the chains in [begin, end) with si
+    /// and returns their number, stopping early if done becomes true
+    int intersectChains(std::size_t begin, std::size_t end,
+                        SegmentIntersector& si, std::atomic<bool>& done);
+
     void add(SegmentString* segStr);
 
 public:
@@ -99,6 +109,28 @@ public:
 
     void computeNodes(std::vector<SegmentString*>* inputSegmentStrings) override;
 
+    /** \brief
+     * Computes the chain overlaps on one thread per given
+     * SegmentIntersector, instead of serially with the one set
+     * by setSegmentIntersector().
+     *
+     * Each thread takes batches of query chains and feeds the overlaps
+     * to its own intersector. The nodes they add to NodedSegmentStrings
+     * are buffered (see NodedSegmentString::NodeBuffer) and added after
+     * all threads are done, in the order the serial computation finds
+     * them, so the noding does not depend on the scheduling unless an
+     * intersector reports isDone() early.
+     *
+     * The intersectors must not share state, and are owned by the caller,
+     * which may combine their results afterwards.
+     * An empty vector restores the serial computation.
+     */
+    void
+    setSegmentIntersectors(const std::vector<SegmentIntersector*>& intersectors)
+    {
+        threadSegInts = intersectors;
+    }
+
     class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction {
     public:
         SegmentOverlapAction(SegmentIntersector& newSi)
@@ -33,6 +33,7 @@
 #include <geos/geom/Coordinate.h>
 
 #include <cstddef>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -109,13 +110,12 @@ public:
     /**
      * Adds an intersection node for a given point and segment to this segment string.
      * If an intersection already exists for this exact location, the existing
-     * node will be returned.
+     * node is kept.
      *
      * @param intPt the location of the intersection
      * @param segmentIndex the index of the segment containing the intersection
-     * @return the intersection node for the point
      */
-    SegmentNode*
+    void
     addIntersectionNode(geom::Coordinate* intPt, std::size_t segmentIndex)
     {
         std::size_t normalizedSegmentIndex = segmentIndex;
@@ -134,8 +134,7 @@ public:
         }
 
         // Add the intersection point to edge intersection list.
-        SegmentNode* ei = getNodeList().add(*intPt, normalizedSegmentIndex);
-        return ei;
+        getNodeList().add(*intPt, normalizedSegmentIndex);
     }
 
     SegmentNodeList& getNodeList();
@@ -195,6 +194,58 @@ public:
     void addIntersection(const geom::Coordinate& intPt,
                          size_t segmentIndex);
 
+    /** \brief
+     * Holds the nodes added by addIntersection() on a thread
+     * while a NodeBuffer::Scope is active, instead of adding them
+     * to the node lists.
+     *
+     * Several threads can thus compute the intersections of the same
+     * segment strings, each one filling its own buffers, the nodes
+     * being added afterwards in a chosen order by flush().
+     */
+    class GEOS_DLL NodeBuffer {
+    public:
+
+        /// Diverts the nodes added by the calling thread to a buffer
+        class GEOS_DLL Scope {
+        public:
+            Scope(NodeBuffer& buffer);
+            ~Scope();
+        private:
+            NodeBuffer* previous;
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+        NodeBuffer() {}
+
+        /// Adds the buffered nodes to their segment strings, in the
+        /// order they were found, and empties the buffer.
+        void flush();
+
+        std::size_t
+        size() const
+        {
+            return nodes.size();
+        }
+
+    private:
+
+        friend class NodedSegmentString;
+
+        struct Node {
+            NodedSegmentString* segStr;
+            geom::Coordinate pt;
+            std::size_t segmentIndex;
+        };
+
+        std::vector<Node> nodes;
+
+        NodeBuffer(const NodeBuffer&) = delete;
+        NodeBuffer& operator=(const NodeBuffer&) = delete;
+    };
+
 
 private:
 
@@ -42,20 +42,14 @@ namespace noding { // geos.noding
  * \brief
  * Represents an intersection point between two NodedSegmentString.
  *
- * Final class.
+ * Final class, stored by value in SegmentNodeList.
  */
 class GEOS_DLL SegmentNode {
 private:
-    const NodedSegmentString& segString;
-
     int segmentOctant;
 
     bool isInteriorVar;
 
-    // Declare type as noncopyable
-    SegmentNode(const SegmentNode& other) = delete;
-    SegmentNode& operator=(const SegmentNode& rhs) = delete;
-
 public:
     friend std::ostream& operator<< (std::ostream& os, const SegmentNode& n);
 
@@ -103,7 +97,13 @@ public:
      * @return 1 this EdgeIntersection is located after the
      *           argument location
      */
-    int compareTo(const SegmentNode& other);
+    int compareTo(const SegmentNode& other) const;
+
+    bool
+    operator<(const SegmentNode& other) const
+    {
+        return compareTo(other) < 0;
+    }
 
     //string print() const;
 };
@@ -26,7 +26,6 @@
 #include <cassert>
 #include <iostream>
 #include <vector>
-#include <set>
 
 #include <geos/noding/SegmentNode.h> // for composition
 
@@ -52,14 +51,30 @@ namespace noding { // geos::noding
 /** \brief
  * A list of the SegmentNode present along a
  * NodedSegmentString.
+ *
+ * The const accessors begin(), end() and size() sort and deduplicate
+ * the nodes added since the last such call, so they modify the list:
+ * they are not safe to call from several threads at once, unlike
+ * the const members of most classes.
  */
 class GEOS_DLL SegmentNodeList {
 private:
-    std::set<SegmentNode*, SegmentNodeLT> nodeMap;
+    // nodes in insertion order until prepare() sorts and dedupes them
+    mutable std::vector<SegmentNode> nodeMap;
+
+    // true if nodeMap is sorted and has no duplicates
+    mutable bool ready;
+
+    // size of nodeMap after the last prepare()
+    mutable std::size_t preparedSize;
 
     // the parent edge
     const NodedSegmentString& edge;
 
+    /// Sorts the nodes and removes the duplicates, keeping the first
+    /// one added, if any node was added since the last call.
+    void prepare() const;
+
     /**
      * Checks the correctness of the set of split edges corresponding
      * to this edge
@@ -76,7 +91,7 @@ private:
      *
      * ownership of return value is transferred
      */
-    SegmentString* createSplitEdge(SegmentNode* ei0, SegmentNode* ei1);
+    SegmentString* createSplitEdge(const SegmentNode* ei0, const SegmentNode* ei1);
 
     /**
      * Adds nodes for any collapsed edge pairs.
@@ -105,7 +120,7 @@ private:
     void findCollapsesFromInsertedNodes(
         std::vector<std::size_t>& collapsedVertexIndexes);
 
-    bool findCollapseIndex(SegmentNode& ei0, SegmentNode& ei1,
+    bool findCollapseIndex(const SegmentNode& ei0, const SegmentNode& ei1,
                            size_t& collapsedVertexIndex);
 
     // Declare type as noncopyable
@@ -116,13 +131,13 @@ public:
 
     friend std::ostream& operator<< (std::ostream& os, const SegmentNodeList& l);
 
-    typedef std::set<SegmentNode*, SegmentNodeLT> container;
-    typedef container::iterator iterator;
+    typedef std::vector<SegmentNode> container;
+    typedef container::const_iterator iterator;
     typedef container::const_iterator const_iterator;
 
-    SegmentNodeList(const NodedSegmentString* newEdge): edge(*newEdge) {}
+    SegmentNodeList(const NodedSegmentString* newEdge): ready(true), preparedSize(0), edge(*newEdge) {}
 
-    SegmentNodeList(const NodedSegmentString& newEdge): edge(newEdge) {}
+    SegmentNodeList(const NodedSegmentString& newEdge): ready(true), preparedSize(0), edge(newEdge) {}
 
     const NodedSegmentString&
     getEdge() const
@@ -135,59 +150,44 @@ public:
     virtual ~SegmentNodeList();
 
     /**
-     * Adds an intersection into the list, if it isn't already there.
+     * Adds an intersection into the list, unless it is already there.
      * The input segmentIndex is expected to be normalized.
      *
-     * @return the SegmentIntersection found or added. It will be
-     *	   destroyed at SegmentNodeList destruction time.
+     * The node is appended, the list being sorted and deduplicated
+     * on the next ordered access (begin(), end() or size()), or once
+     * it has doubled in size. A node equal to the last one added is
+     * skipped right away.
      *
      * @param intPt the intersection Coordinate, will be copied
      * @param segmentIndex
      */
-    SegmentNode* add(const geom::Coordinate& intPt, std::size_t segmentIndex);
+    void add(const geom::Coordinate& intPt, std::size_t segmentIndex);
 
-    SegmentNode*
+    void
     add(const geom::Coordinate* intPt, std::size_t segmentIndex)
     {
-        return add(*intPt, segmentIndex);
-    }
-
-    /*
-     * returns the set of SegmentNodes
-     */
-    //replaces iterator()
-    // TODO: obsolete this function
-    std::set<SegmentNode*, SegmentNodeLT>*
-    getNodes()
-    {
-        return &nodeMap;
+        add(*intPt, segmentIndex);
     }
 
     /// Return the number of nodes in this list
     size_t
     size() const
     {
+        prepare();
         return nodeMap.size();
     }
 
-    container::iterator
-    begin()
-    {
-        return nodeMap.begin();
-    }
-    container::const_iterator
+    const_iterator
     begin() const
     {
+        prepare();
         return nodeMap.begin();
     }
-    container::iterator
-    end()
-    {
-        return nodeMap.end();
-    }
-    container::const_iterator
+
+    const_iterator
     end() const
     {
+        prepare();
         return nodeMap.end();
     }
 
@@ -68,6 +68,11 @@ public:
 
 protected:
 
+    /// Uses g0 as the graph of the first argument.
+    /// Ownership of g0 remains to the caller.
+    GeometryGraphOperation(geomgraph::GeometryGraph* g0,
+                           const geom::Geometry* g1);
+
     algorithm::LineIntersector li;
 
     const geom::PrecisionModel* resultPrecisionModel;
@@ -77,6 +82,9 @@ protected:
      */
     std::vector<geomgraph::GeometryGraph*> arg;
 
+    /// false if arg[0] is owned by the caller
+    bool ownArg0;
+
     void setComputationPrecision(const geom::PrecisionModel* pm);
 };
 
@@ -53,6 +53,7 @@ class Node;
 namespace operation {
 namespace overlay {
 class ElevationMatrix;
+class PreparedOverlay;
 }
 }
 }
@@ -152,6 +153,14 @@ public:
         return graph;
     }
 
+    /// Whether Z values are computed for the result, false when
+    /// both inputs are 2D
+    bool
+    isComputingZ() const
+    {
+        return computeZ;
+    }
+
     /** \brief
      * This method is used to decide if a point node should be included
      * in the result or not.
@@ -188,6 +197,17 @@ protected:
 
 private:
 
+    friend class PreparedOverlay;
+
+    /// Construct an OverlayOp of the geometry prepared in prep with g1.
+    //
+    /// The self-noded graph of prep is used as the first argument.
+    ///
+    OverlayOp(PreparedOverlay& prep, const geom::Geometry* g1);
+
+    /// The prepared first argument, or null
+    PreparedOverlay* prepared;
+
     algorithm::PointLocator ptLocator;
 
     const geom::GeometryFactory* geomFact;
@@ -391,8 +411,14 @@ private:
     double getAverageZ(int targetIndex);
     static double getAverageZ(const geom::Polygon* poly);
 
+    /// False when both inputs are 2D, then no elevation is computed
+    bool computeZ;
+
+    /// Null when computeZ is false
     ElevationMatrix* elevationMatrix;
 
+    void initElevation(const geom::Geometry* g0, const geom::Geometry* g1);
+
     /// Throw TopologyException if an obviously wrong result has
     /// been computed.
     void checkObviouslyWrongResult(OpCode opCode);
@@ -0,0 +1,157 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_OVERLAY_PREPAREDOVERLAY_H
+#define GEOS_OP_OVERLAY_PREPAREDOVERLAY_H
+
+#include <geos/export.h>
+
+#include <geos/operation/overlay/OverlayOp.h> // for OpCode
+#include <geos/algorithm/LineIntersector.h> // for composition
+#include <geos/geom/Envelope.h> // for composition
+#include <geos/geomgraph/EdgeIntersectionList.h> // for composition
+#include <geos/index/strtree/STRtree.h> // for composition
+
+#include <memory>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Geometry;
+}
+namespace geomgraph {
+class Edge;
+class GeometryGraph;
+namespace index {
+class MonotoneChainEdge;
+}
+}
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace overlay { // geos::operation::overlay
+
+/** \brief
+ * Computes repeated overlays of a fixed geometry with many others.
+ *
+ * The GeometryGraph of the prepared geometry is built and self-noded
+ * once, and the monotone chains of its edges are indexed in an STRtree.
+ * Each overlay then only self-nodes the other operand and intersects
+ * its edges with the indexed chains, instead of rebuilding and noding
+ * both graphs as OverlayOp does.
+ *
+ * The prepared geometry is always the first operand, so difference()
+ * computes the part of the prepared geometry not in the other.
+ * Results are the ones of the corresponding Geometry methods, including
+ * the snapping heuristics of BinaryOp when the overlay fails.
+ *
+ * The cached graph is updated by each overlay, so an instance must not
+ * be used by several threads at once.
+ */
+class GEOS_DLL PreparedOverlay {
+
+public:
+
+    /// Prepares geom, which must outlive this object
+    PreparedOverlay(const geom::Geometry& geom);
+
+    ~PreparedOverlay();
+
+    const geom::Geometry&
+    getGeometry() const
+    {
+        return geom;
+    }
+
+    /**
+     * Computes an overlay of the prepared geometry with other.
+     *
+     * @param other the second operand
+     * @param opCode the overlay operation to perform
+     * @return the result of the overlay operation
+     * @throws TopologyException if the overlay fails even with snapping
+     */
+    std::unique_ptr<geom::Geometry> overlay(const geom::Geometry& other,
+                                            OverlayOp::OpCode opCode);
+
+    /// Computes the intersection of the prepared geometry with other
+    std::unique_ptr<geom::Geometry> intersection(const geom::Geometry& other);
+
+    /// Computes the part of the prepared geometry not in other
+    std::unique_ptr<geom::Geometry> difference(const geom::Geometry& other);
+
+private:
+
+    friend class OverlayOp;
+
+    /// A monotone chain of an edge of the prepared graph
+    struct Chain {
+        geomgraph::Edge* edge;
+        geomgraph::index::MonotoneChainEdge* mce;
+        std::size_t chainIndex;
+    };
+
+    const geom::Geometry& geom;
+
+    algorithm::LineIntersector li;
+
+    std::unique_ptr<geomgraph::GeometryGraph> graph;
+
+    /// The self intersections of each edge of graph
+    std::vector<geomgraph::EdgeIntersectionList::container> selfNodes;
+
+    /// The isolated flag of each edge of graph after self-noding
+    std::vector<bool> isolated;
+
+    std::vector<Chain> chains;
+
+    std::vector<geom::Envelope> chainEnvs;
+
+    index::strtree::STRtree chainIndex;
+
+    /// Computes an overlay with OverlayOp, using the prepared graph
+    /// if g0 is the prepared geometry
+    geom::Geometry* computeOverlay(const geom::Geometry* g0,
+                                   const geom::Geometry* g1,
+                                   OverlayOp::OpCode opCode);
+
+    /// Restores the edges of the prepared graph as they were
+    /// after self-noding
+    void resetGraph();
+
+    /// Adds the intersections of the edges of other with the edges
+    /// of the prepared graph, skipping edges not intersecting env if any
+    void computeEdgeIntersections(geomgraph::GeometryGraph& other,
+                                  algorithm::LineIntersector& li,
+                                  const geom::Envelope* env);
+
+    // Declare type as noncopyable
+    PreparedOverlay(const PreparedOverlay& other) = delete;
+    PreparedOverlay& operator=(const PreparedOverlay& rhs) = delete;
+};
+
+} // namespace geos::operation::overlay
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_OP_OVERLAY_PREPAREDOVERLAY_H
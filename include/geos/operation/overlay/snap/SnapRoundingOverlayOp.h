@@ -0,0 +1,154 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_OVERLAY_SNAP_SNAPROUNDINGOVERLAYOP_H
+#define GEOS_OP_OVERLAY_SNAP_SNAPROUNDINGOVERLAYOP_H
+
+#include <geos/export.h>
+
+#include <geos/operation/overlay/OverlayOp.h> // for enums
+
+#include <memory> // for unique_ptr
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+namespace geom {
+class Geometry;
+class PrecisionModel;
+struct GeomPtrPair;
+}
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace overlay { // geos::operation::overlay
+namespace snap { // geos::operation::overlay::snap
+
+/** \brief
+ * Performs an overlay operation on the grid of a fixed precision model,
+ * using snap rounding to make it robust.
+ *
+ * The inputs are reduced to the grid, and the linework of both is
+ * noded together by noding::snapround::MCIndexSnapRounder, which puts
+ * every vertex and intersection on the grid. The polygons whose
+ * topology changed in the process are fixed, and the fixed inputs are
+ * noded again until none needs fixing. The overlay of the mutually
+ * noded inputs is then computed by OverlayOp, which has no new
+ * intersection to compute.
+ *
+ * If the inputs are still being fixed after a few passes, or OverlayOp
+ * fails on them, the overlay is computed in floating precision through
+ * geom::BinaryOp, with its snapping heuristics, and its result is
+ * reduced to the grid by precision::GeometryPrecisionReducer. That can
+ * still throw a util::TopologyException.
+ *
+ * The result lies on the grid, and the components of the inputs
+ * collapsing on it are dropped.
+ */
+class GEOS_DLL SnapRoundingOverlayOp {
+
+public:
+
+    static std::unique_ptr<geom::Geometry>
+    overlayOp(const geom::Geometry& g0, const geom::Geometry& g1,
+              OverlayOp::OpCode opCode, const geom::PrecisionModel& pm)
+    {
+        SnapRoundingOverlayOp op(g0, g1, pm);
+        return op.getResultGeometry(opCode);
+    }
+
+    static std::unique_ptr<geom::Geometry>
+    intersection(const geom::Geometry& g0, const geom::Geometry& g1,
+                 const geom::PrecisionModel& pm)
+    {
+        return overlayOp(g0, g1, OverlayOp::opINTERSECTION, pm);
+    }
+
+    static std::unique_ptr<geom::Geometry>
+    Union(const geom::Geometry& g0, const geom::Geometry& g1,
+          const geom::PrecisionModel& pm)
+    {
+        return overlayOp(g0, g1, OverlayOp::opUNION, pm);
+    }
+
+    static std::unique_ptr<geom::Geometry>
+    difference(const geom::Geometry& g0, const geom::Geometry& g1,
+               const geom::PrecisionModel& pm)
+    {
+        return overlayOp(g0, g1, OverlayOp::opDIFFERENCE, pm);
+    }
+
+    static std::unique_ptr<geom::Geometry>
+    symDifference(const geom::Geometry& g0, const geom::Geometry& g1,
+                  const geom::PrecisionModel& pm)
+    {
+        return overlayOp(g0, g1, OverlayOp::opSYMDIFFERENCE, pm);
+    }
+
+    /**
+     * @param g0 the first geometry argument
+     * @param g1 the second geometry argument
+     * @param pm the fixed precision model to snap round to,
+     *           which must outlive this object
+     * @throws IllegalArgumentException if pm is floating
+     */
+    SnapRoundingOverlayOp(const geom::Geometry& g0, const geom::Geometry& g1,
+                          const geom::PrecisionModel& pm);
+
+    typedef std::unique_ptr<geom::Geometry> GeomPtr;
+
+    GeomPtr getResultGeometry(OverlayOp::OpCode opCode);
+
+private:
+
+    /// Reduces g0 and g1 to the grid and nodes them together,
+    /// returns whether any of them had to be fixed
+    bool snapRound(const geom::Geometry& g0, const geom::Geometry& g1,
+                   geom::GeomPtrPair& ret);
+
+    /// Computes the overlay with the snapping heuristics of
+    /// geom::BinaryOp and reduces the result to the grid
+    GeomPtr getFallbackResult(OverlayOp::OpCode opCode);
+
+    /// Number of noding passes after which the snap rounded
+    /// inputs are given up if fixing them keeps changing them
+    static const int MAX_SNAP_ROUND_PASSES = 4;
+
+    /// Fixes a noded polygonal geometry made invalid by snap rounding,
+    /// setting fixed if it did
+    static GeomPtr fixTopology(GeomPtr geom, bool& fixed);
+
+    const geom::Geometry& geom0;
+    const geom::Geometry& geom1;
+
+    const geom::PrecisionModel& pm;
+
+    // Declare type as noncopyable
+    SnapRoundingOverlayOp(const SnapRoundingOverlayOp& other) = delete;
+    SnapRoundingOverlayOp& operator=(const SnapRoundingOverlayOp& rhs) = delete;
+};
+
+} // namespace geos::operation::overlay::snap
+} // namespace geos::operation::overlay
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_OP_OVERLAY_SNAP_SNAPROUNDINGOVERLAYOP_H
@@ -56,13 +56,13 @@ protected:
 
     void createEdgeEndForPrev(geomgraph::Edge* edge,
                               std::vector<geomgraph::EdgeEnd*>* l,
-                              geomgraph::EdgeIntersection* eiCurr,
-                              geomgraph::EdgeIntersection* eiPrev);
+                              const geomgraph::EdgeIntersection* eiCurr,
+                              const geomgraph::EdgeIntersection* eiPrev);
 
     void createEdgeEndForNext(geomgraph::Edge* edge,
                               std::vector<geomgraph::EdgeEnd*>* l,
-                              geomgraph::EdgeIntersection* eiCurr,
-                              geomgraph::EdgeIntersection* eiNext);
+                              const geomgraph::EdgeIntersection* eiCurr,
+                              const geomgraph::EdgeIntersection* eiNext);
 };
 
 } // namespace geos:operation:relate
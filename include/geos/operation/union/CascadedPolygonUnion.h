@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 #include "GeometryListHolder.h"
@@ -43,6 +44,11 @@ namespace strtree {
 class ItemsList;
 }
 }
+namespace operation {
+namespace geounion {
+class UnionTaskQueue;
+}
+}
 }
 
 namespace geos {
@@ -68,12 +74,31 @@ namespace geounion {  // geos::operation::geounion
  * The best case for buffer(0) is the trivial case
  * where there is <i>no</i> overlap between the input geometries.
  * However, this case is likely rare in practice.
+ *
+ * Unioning can optionally be spread over several threads.
+ * Sibling subtrees of the STRtree, and the two halves of each binary
+ * union, are independent, so at each of these points all the branches
+ * but one are queued for a fixed set of worker threads, started once
+ * per union, and the last one runs on the current thread. A queued
+ * branch no worker has picked up yet when the current thread needs
+ * its result runs on the current thread. The order in which partial
+ * results are unioned does not depend on the number of threads, so
+ * the result is the same as the one computed sequentially.
+ * Parallel mode is not used for geometries created by a
+ * GeometryFactory backed by a geos::util::Arena.
  */
 class GEOS_DLL CascadedPolygonUnion {
 private:
     std::vector<geom::Polygon*>* inputPolys;
     geom::GeometryFactory const* geomFactory;
 
+    /// Maximum number of threads unioning at the same time
+    std::size_t numThreads;
+
+    /// Workers running the queued branches, null when unioning
+    /// sequentially
+    UnionTaskQueue* taskQueue;
+
     /**
      * The effectiveness of the index is somewhat sensitive
      * to the node capacity.
@@ -112,6 +137,20 @@ public:
      */
     static geom::Geometry* Union(std::vector<geom::Polygon*>* polys);
 
+    /**
+     * Computes the union of
+     * a collection of {@link geom::Polygonal} {@link geom::Geometry}s,
+     * using up to the given number of threads.
+     *
+     * @param polys a collection of {@link geom::Polygonal}
+     *              {@link geom::Geometry}s.
+     *              ownership of elements _and_ vector are left to caller.
+     * @param numThreads maximum number of threads to use, including the
+     *                   calling one. 0 or 1 unions sequentially.
+     */
+    static geom::Geometry* Union(std::vector<geom::Polygon*>* polys,
+                                 std::size_t numThreads);
+
     /**
      * Computes the union of a set of {@link geom::Polygonal}
      * {@link geom::Geometry}s.
@@ -119,17 +158,18 @@ public:
      * @tparam T an iterator yelding something castable to const Polygon *
      * @param start start iterator
      * @param end end iterator
+     * @param numThreads maximum number of threads to use
      */
     template <class T>
     static geom::Geometry*
-    Union(T start, T end)
+    Union(T start, T end, std::size_t numThreads = 1)
     {
         std::vector<geom::Polygon*> polys;
         for(T i = start; i != end; ++i) {
             const geom::Polygon* p = dynamic_cast<const geom::Polygon*>(*i);
             polys.push_back(const_cast<geom::Polygon*>(p));
         }
-        return Union(&polys);
+        return Union(&polys, numThreads);
     }
 
     /**
@@ -152,7 +192,28 @@ public:
      */
     CascadedPolygonUnion(std::vector<geom::Polygon*>* polys)
         : inputPolys(polys),
-          geomFactory(nullptr)
+          geomFactory(nullptr),
+          numThreads(1),
+          taskQueue(nullptr)
+    {}
+
+    /**
+     * Creates a new instance to union
+     * the given collection of {@link geom::Geometry}s
+     * using up to numThreads threads.
+     *
+     * @param polys a collection of {@link geom::Polygonal}
+     *              {@link geom::Geometry}s.
+     *              Ownership of elements _and_ vector are left to caller.
+     * @param numThreads_in maximum number of threads to use, including
+     *                      the calling one. 0 or 1 unions sequentially.
+     */
+    CascadedPolygonUnion(std::vector<geom::Polygon*>* polys,
+                         std::size_t numThreads_in)
+        : inputPolys(polys),
+          geomFactory(nullptr),
+          numThreads(numThreads_in > 1 ? numThreads_in : 1),
+          taskQueue(nullptr)
     {}
 
     /**
@@ -194,6 +255,16 @@ private:
      */
     GeometryListHolder* reduceToGeometries(index::strtree::ItemsList* geomTree);
 
+    /**
+     * Runs independent tasks, queueing all but the last one for the
+     * worker threads and running the last one on the calling thread.
+     * Without workers, all run on the calling thread.
+     *
+     * Returns once all tasks are done. If any task threw, the exception
+     * of the first such task (in vector order) is rethrown.
+     */
+    void runTasks(std::vector<std::function<void()>>& tasks);
+
     /**
      * Computes the union of two geometries,
      * either of both of which may be null.
@@ -109,10 +109,26 @@ public:
         return op.Union();
     }
 
+    /**
+     * \brief
+     * Unions the components of a geometry, unioning polygons with
+     * up to numThreads threads.
+     *
+     * @see setNumThreads
+     */
+    static std::unique_ptr<geom::Geometry>
+    Union(const geom::Geometry& geom, std::size_t numThreads)
+    {
+        UnaryUnionOp op(geom);
+        op.setNumThreads(numThreads);
+        return op.Union();
+    }
+
     template <class T>
     UnaryUnionOp(const T& geoms, geom::GeometryFactory& geomFactIn)
         :
-        geomFact(&geomFactIn)
+        geomFact(&geomFactIn),
+        numThreads(1)
     {
         extractGeoms(geoms);
     }
@@ -120,18 +136,35 @@ public:
     template <class T>
     UnaryUnionOp(const T& geoms)
         :
-        geomFact(nullptr)
+        geomFact(nullptr),
+        numThreads(1)
     {
         extractGeoms(geoms);
     }
 
     UnaryUnionOp(const geom::Geometry& geom)
         :
-        geomFact(geom.getFactory())
+        geomFact(geom.getFactory()),
+        numThreads(1)
     {
         extract(geom);
     }
 
+    /**
+     * \brief
+     * Sets the maximum number of threads used to union polygons.
+     *
+     * Polygonal components are unioned by a CascadedPolygonUnion
+     * running in parallel mode when numThreads is greater than 1.
+     * The result does not depend on the number of threads.
+     * Defaults to 1 (sequential).
+     */
+    void
+    setNumThreads(std::size_t numThreads_in)
+    {
+        numThreads = numThreads_in;
+    }
+
     /**
      * \brief
      * Gets the union of the input geometries.
@@ -217,6 +250,8 @@ private:
 
     const geom::GeometryFactory* geomFact;
 
+    std::size_t numThreads;
+
     std::unique_ptr<geom::Geometry> empty;
 };
 
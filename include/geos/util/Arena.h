@@ -0,0 +1,236 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_UTIL_ARENA_H
+#define GEOS_UTIL_ARENA_H
+
+#include <geos/export.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace util { // geos::util
+
+/**
+ * \brief
+ * A monotonic (bump pointer) allocator.
+ *
+ * Memory is handed out sequentially from large blocks. Memory given
+ * back with deallocate() is reused by the next allocation of the same
+ * size; release() makes all of it available again in one call, and the
+ * blocks go back to the system when the Arena is destroyed.
+ *
+ * Geometry and CoordinateSequence objects can be placed in an Arena
+ * (see GeometryFactory::create(const PrecisionModel*, int, Arena&)),
+ * together with their coordinates. Deleting such an object runs its
+ * destructor and keeps its memory for the next object of the same size,
+ * so a loop creating and deleting similar geometries reaches a steady
+ * state without new allocations.
+ *
+ * Lifetime rules: release() and the destructor free the memory of
+ * the objects still allocated in the Arena without running their
+ * destructors. Such objects are abandoned: they must not be used, nor
+ * deleted, afterwards. Abandoning them leaks nothing as long as all
+ * they own is in the Arena or is an owned object (see newOwned()),
+ * which is the case of geometries created by an arena GeometryFactory.
+ * Heap objects (e.g. clones of arena geometries) are unaffected.
+ *
+ * An Arena is not thread-safe: allocations, deletions of its objects
+ * and release() must not run concurrently. getNumLiveObjects() may be
+ * called from any thread.
+ */
+class GEOS_DLL Arena {
+
+public:
+
+    /// Alignment required by the objects allocated with allocateObject()
+    static constexpr std::size_t OBJECT_ALIGNMENT = 8;
+
+    /**
+     * @param blockSize size in bytes of the blocks memory is
+     *                  carved from (larger requests get their own block)
+     */
+    explicit Arena(std::size_t blockSize = 64 * 1024);
+
+    /// Frees all blocks, abandoning the objects still allocated
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Returns a block of at least the given size, suitably aligned
+     * for any fundamental type.
+     */
+    void* allocate(std::size_t bytes);
+
+    /**
+     * Gives back memory obtained from allocate() with the same size,
+     * for reuse by a later allocation of that size.
+     */
+    void deallocate(void* p, std::size_t bytes);
+
+    /**
+     * Makes all memory allocated so far available for reuse.
+     *
+     * Objects allocated with allocateObject() and not yet deleted are
+     * abandoned: their destructors are not run and they must not be
+     * used or deleted afterwards.
+     */
+    void release();
+
+    /**
+     * Creates an object in the Arena whose destructor release() runs
+     * if it is still alive, for objects owning memory elsewhere (such
+     * as the component lists of arena geometries).
+     *
+     * It must be destroyed with deleteOwned().
+     */
+    template<class T, class... Args>
+    T*
+    newOwned(Args&& ... args)
+    {
+        void* p = allocateOwned(sizeof(T), &destroyOwned<T>);
+        try {
+            return new(p) T(std::forward<Args>(args)...);
+        }
+        catch(...) {
+            deallocateOwned(p, sizeof(T));
+            throw;
+        }
+    }
+
+    /// Destroys an object created by newOwned()
+    template<class T>
+    void
+    deleteOwned(T* p)
+    {
+        if(p) {
+            p->~T();
+            deallocateOwned(p, sizeof(T));
+        }
+    }
+
+    /// Number of bytes carved from the blocks since construction or the last release()
+    std::size_t
+    getBytesUsed() const
+    {
+        return bytesUsed;
+    }
+
+    /// Number of bytes reserved from the system
+    std::size_t getBytesReserved() const;
+
+    /// Number of objects allocated with allocateObject() and not yet deallocated
+    std::size_t
+    getNumLiveObjects() const
+    {
+        return liveObjects.load();
+    }
+
+    /**
+     * Allocates memory for an object, from the given arena or from
+     * the heap if arena is null. The memory must be returned with
+     * deallocateObject(), which finds out where it came from.
+     *
+     * Only objects from an arena carry a header recording it: arena
+     * objects are placed at addresses heap objects never have.
+     *
+     * This is the implementation of the class-specific operator new
+     * of arena-aware classes, whose alignment must not exceed
+     * OBJECT_ALIGNMENT.
+     */
+    static void* allocateObject(std::size_t size, Arena* arena);
+
+    /**
+     * Releases memory obtained from allocateObject() with the same size
+     * (the implementation of a class-specific sized operator delete).
+     */
+    static void deallocateObject(void* p, std::size_t size);
+
+    /**
+     * Releases memory obtained from allocateObject() when its size is
+     * not known, as after a constructor threw. Memory from an arena is
+     * then only reused after release().
+     */
+    static void deallocateObject(void* p);
+
+private:
+
+    /// Placed in front of the objects created by newOwned()
+    struct OwnedHeader {
+        OwnedHeader* prev;
+        OwnedHeader* next;
+        void (*destroy)(void*);
+    };
+
+    template<class T>
+    static void
+    destroyOwned(void* p)
+    {
+        static_cast<T*>(p)->~T();
+    }
+
+    void* allocateOwned(std::size_t size, void (*destroy)(void*));
+
+    void deallocateOwned(void* p, std::size_t size);
+
+    /// Runs the destructors of the owned objects still alive
+    void destroyAllOwned();
+
+    struct Block {
+        /// Memory obtained from the system
+        char* raw;
+        /// First byte of the block suitably aligned
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+
+    /// Memory given back, by size, linked through its first bytes
+    std::unordered_map<std::size_t, void*> freeLists;
+
+    /// Index of the block currently allocated from
+    std::size_t current;
+
+    /// Offset of the first free byte in the current block
+    std::size_t offset;
+
+    std::size_t blockSize;
+
+    std::size_t bytesUsed;
+
+    std::atomic<std::size_t> liveObjects;
+
+    /// Objects created by newOwned() and not yet deleted
+    OwnedHeader* owned;
+};
+
+} // namespace geos::util
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_UTIL_ARENA_H
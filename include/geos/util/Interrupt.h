@@ -17,11 +17,69 @@
 
 #include <geos/export.h>
 
+#include <atomic>
+#include <cstdint>
+
 namespace geos {
 namespace util { // geos::util
 
 #define GEOS_CHECK_FOR_INTERRUPTS() geos::util::Interrupt::process()
 
+/**
+ * \brief
+ * Interruption request and deadline of one user of the library,
+ * such as a C API context handle.
+ *
+ * Unlike the process-wide Interrupt::request(), an InterruptState only
+ * affects the threads it is installed on with an Interrupt::Scope.
+ * request() and cancel() may be called from any thread.
+ *
+ * A request stays pending once it has interrupted an operation, so
+ * that every thread working on the same call stops. It is cleared by
+ * cancel(), or by the Scope starting the next call.
+ */
+class GEOS_DLL InterruptState {
+
+public:
+
+    InterruptState();
+
+    /** Request interruption of the operations using this state */
+    void request();
+
+    /** Cancel a pending interruption request */
+    void cancel();
+
+    /** Check if an interruption request is pending */
+    bool check() const;
+
+    /**
+     * Interrupt the operations using this state once the given number
+     * of seconds, counted from now, has elapsed.
+     * A value of zero or less removes the deadline.
+     */
+    void setTimeout(double seconds);
+
+    /** Check if the deadline, if any, has passed */
+    bool isExpired() const;
+
+private:
+
+    friend class Interrupt;
+
+    std::atomic<bool> requested;
+
+    /// Whether the pending request has interrupted an operation
+    std::atomic<bool> delivered;
+
+    /// steady_clock time in nanoseconds, INT64_MAX if there is none
+    std::atomic<std::int64_t> deadline;
+
+    // Declare type as noncopyable
+    InterruptState(const InterruptState& other) = delete;
+    InterruptState& operator=(const InterruptState& rhs) = delete;
+};
+
 /** Used to manage interruption requests and callbacks */
 class GEOS_DLL Interrupt {
 
@@ -52,6 +110,9 @@ public:
      *
      * The callback can be used to call Interrupt::request()
      *
+     * The callback is only invoked on the thread running an
+     * operation, never on the worker threads helping with it
+     * (see Interrupt::Scope).
      */
     static Callback* registerCallback(Callback* cb);
 
@@ -64,6 +125,36 @@ public:
     /* Perform the actual interruption (simply throw an exception) */
     static void interrupt();
 
+    /**
+     * \brief
+     * Installs an InterruptState on the calling thread while in scope.
+     *
+     * process() then also interrupts on requests made through that
+     * state, or once its deadline has passed. The previously installed
+     * state, if any, is restored when the scope ends.
+     *
+     * A scope starting a new call clears a request which has already
+     * interrupted an earlier call, unless the thread is already running
+     * with that state. Worker threads helping with a call pass
+     * newCall = false, so that they stop on the same request; the
+     * callback registered with registerCallback() is not invoked on
+     * them while the scope lasts.
+     */
+    class GEOS_DLL Scope {
+    public:
+        explicit Scope(InterruptState* state, bool newCall = true);
+        ~Scope();
+    private:
+        InterruptState* previous;
+        bool previousHelper;
+
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& rhs) = delete;
+    };
+
+    /** Returns the InterruptState installed on the calling thread, if any */
+    static InterruptState* currentState();
+
 };
 
 
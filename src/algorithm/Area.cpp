@@ -20,6 +20,7 @@
 #include <vector>
 
 #include <geos/algorithm/Area.h>
+#include <geos/geom/PackedCoordinateSequence.h>
 
 namespace geos {
 namespace algorithm { // geos.algorithm
@@ -74,6 +75,21 @@ Area::ofRingSigned(const geom::CoordinateSequence* ring)
     * Based on the Shoelace formula.
     * http://en.wikipedia.org/wiki/Shoelace_formula
     */
+    if(const geom::PackedCoordinateSequence* packed =
+                dynamic_cast<const geom::PackedCoordinateSequence*>(ring)) {
+        const double* xy = packed->data();
+        const size_t stride = packed->stride();
+        double x0 = xy[0];
+        double sum = 0.0;
+        for(size_t i = 1; i < n - 1; i++) {
+            double x = xy[i * stride] - x0;
+            double y1 = xy[(i + 1) * stride + 1];
+            double y2 = xy[(i - 1) * stride + 1];
+            sum += x * (y2 - y1);
+        }
+        return sum / 2.0;
+    }
+
     geom::Coordinate p0, p1, p2;
     p1 = ring->getAt(0);
     p2 = ring->getAt(1);
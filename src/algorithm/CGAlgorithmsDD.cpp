@@ -19,11 +19,14 @@
 
 #include <geos/algorithm/CGAlgorithmsDD.h>
 #include <geos/geom/Coordinate.h>
+#include <geos/math/DD.h>
 #include <geos/util/IllegalArgumentException.h>
-#include <sstream>
+
+#include <cmath>
 
 using namespace geos::geom;
 using namespace geos::algorithm;
+using geos::math::DD;
 
 namespace {
 
@@ -36,22 +39,17 @@ double constexpr DP_SAFE_EPSILON =  1e-15;
 inline int
 OrientationDD(DD const& dd)
 {
-    static DD const zero(0.0);
-    if(dd < zero) {
+    int sign = dd.signum();
+    if(sign < 0) {
         return CGAlgorithmsDD::RIGHT;
     }
 
-    if(dd > zero) {
+    if(sign > 0) {
         return CGAlgorithmsDD::LEFT;
     }
 
     return CGAlgorithmsDD::STRAIGHT;
 }
-
-// inline std::string ToStringDD(DD const& dd)
-// {
-//     return dd.ToString();
-// }
 }
 
 namespace geos {
@@ -74,24 +72,22 @@ CGAlgorithmsDD::orientationIndex(const Coordinate& p1,
     }
 
     // normalize coordinates
-    DD dx1 = DD(p2.x) + DD(-p1.x);
-    DD dy1 = DD(p2.y) + DD(-p1.y);
-    DD dx2 = DD(q.x) + DD(-p2.x);
-    DD dy2 = DD(q.y) + DD(-p2.y);
+    DD dx1 = DD(p2.x) + -p1.x;
+    DD dy1 = DD(p2.y) + -p1.y;
+    DD dx2 = DD(q.x) + -p2.x;
+    DD dy2 = DD(q.y) + -p2.y;
 
     // sign of determinant - inlined for performance
-    DD mx1y2(dx1 * dy2);
-    DD my1x2(dy1 * dx2);
-    DD d = mx1y2 - my1x2;
-    return OrientationDD(d);
+    dx1.selfMultiply(dy2);
+    dy1.selfMultiply(dx2);
+    dx1.selfSubtract(dy1);
+    return OrientationDD(dx1);
 }
 
 int
-CGAlgorithmsDD::signOfDet2x2(DD& x1, DD& y1, DD& x2, DD& y2)
+CGAlgorithmsDD::signOfDet2x2(const DD& x1, const DD& y1, const DD& x2, const DD& y2)
 {
-    DD mx1y2(x1 * y2);
-    DD my1x2(y1 * x2);
-    DD d = mx1y2 - my1x2;
+    DD d = DD::determinant(x1, y1, x2, y2);
     return OrientationDD(d);
 }
 
@@ -175,21 +171,21 @@ CGAlgorithmsDD::intersection(const Coordinate& p1, const Coordinate& p2,
      * - intersection point lies within line segment p if fracP is between 0 and 1
      * - intersection point lies within line segment q if fracQ is between 0 and 1
      */
-    DD numx1 = (q2x - q1x) * (p1y - q1y);
-    DD numx2 = (q2y - q1y) * (p1x - q1x);
+    DD numx1 = qdx * (p1y - q1y);
+    DD numx2 = qdy * (p1x - q1x);
     DD numx = numx1 - numx2;
     DD fracP = numx / denom;
 
-    DD x = p1x + (p2x - p1x) * fracP;
+    DD x = p1x + pdx * fracP;
 
-    DD numy1 = (p2x - p1x) * (p1y - q1y);
-    DD numy2 = (p2y - p1y) * (p1x - q1x);
+    DD numy1 = pdx * (p1y - q1y);
+    DD numy2 = pdy * (p1x - q1x);
     DD numy = numy1 - numy2;
     DD fracQ = numy / denom;
-    DD y = q1y + (q2y - q1y) * fracQ;
+    DD y = q1y + qdy * fracQ;
 
-    rv.x = x.ToDouble();
-    rv.y = y.ToDouble();
+    rv.x = x.doubleValue();
+    rv.y = y.doubleValue();
 }
 
 
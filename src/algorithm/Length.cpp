@@ -20,6 +20,7 @@
 #include <vector>
 
 #include <geos/algorithm/Length.h>
+#include <geos/geom/PackedCoordinateSequence.h>
 
 namespace geos {
 namespace algorithm { // geos.algorithm
@@ -36,6 +37,19 @@ Length::ofLine(const geom::CoordinateSequence* pts)
 
     double len = 0.0;
 
+    // packed ordinates can be walked without per-point virtual calls
+    if(const geom::PackedCoordinateSequence* packed =
+                dynamic_cast<const geom::PackedCoordinateSequence*>(pts)) {
+        const double* xy = packed->data();
+        const size_t stride = packed->stride();
+        for(size_t i = 1; i < n; i++) {
+            double dx = xy[i * stride] - xy[(i - 1) * stride];
+            double dy = xy[i * stride + 1] - xy[(i - 1) * stride + 1];
+            len += std::sqrt(dx * dx + dy * dy);
+        }
+        return len;
+    }
+
     const geom::Coordinate& p = pts->getAt(0);
     double x0 = p.x;
     double y0 = p.y;
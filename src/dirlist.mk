@@ -23,6 +23,7 @@ GEOS_DIRLIST =  \
 	index\sweepline \
 	io \
 	linearref \
+	math \
 	noding \
 	noding\snapround \
 	operation \
@@ -0,0 +1,269 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/ArenaCoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/Arena.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <vector>
+
+namespace geos {
+namespace geom { // geos::geom
+
+ArenaCoordinateSequence::ArenaCoordinateSequence(util::Arena& p_arena,
+        std::size_t n, std::size_t dimension_in)
+    :
+    arena(&p_arena),
+    coords(nullptr),
+    size(0),
+    capacity(0),
+    dimension(dimension_in)
+{
+    reserve(n);
+    std::uninitialized_fill_n(coords, n, Coordinate());
+    size = n;
+}
+
+ArenaCoordinateSequence::ArenaCoordinateSequence(util::Arena& p_arena,
+        const std::vector<Coordinate>& v, std::size_t dimension_in)
+    :
+    arena(&p_arena),
+    coords(nullptr),
+    size(0),
+    capacity(0),
+    dimension(dimension_in)
+{
+    setPoints(v);
+}
+
+ArenaCoordinateSequence::ArenaCoordinateSequence(util::Arena& p_arena,
+        const CoordinateSequence& seq)
+    :
+    CoordinateSequence(seq),
+    arena(&p_arena),
+    coords(nullptr),
+    size(0),
+    capacity(0),
+    dimension(seq.getDimension())
+{
+    const std::size_t n = seq.size();
+    reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        new(coords + i) Coordinate();
+        seq.getAt(i, coords[i]);
+    }
+    size = n;
+}
+
+ArenaCoordinateSequence::~ArenaCoordinateSequence()
+{
+    // Coordinate is trivially destructible, only the memory goes back
+    arena->deallocate(coords, capacity * sizeof(Coordinate));
+}
+
+/*private*/
+void
+ArenaCoordinateSequence::reserve(std::size_t n)
+{
+    if(n <= capacity) {
+        return;
+    }
+    std::size_t newCapacity = std::max(n, capacity * 2);
+    Coordinate* newCoords = static_cast<Coordinate*>(
+                                arena->allocate(newCapacity * sizeof(Coordinate)));
+    std::uninitialized_copy(coords, coords + size, newCoords);
+    arena->deallocate(coords, capacity * sizeof(Coordinate));
+    coords = newCoords;
+    capacity = newCapacity;
+}
+
+std::unique_ptr<CoordinateSequence>
+ArenaCoordinateSequence::clone() const
+{
+    return detail::make_unique<CoordinateArraySequence>(*this);
+}
+
+void
+ArenaCoordinateSequence::getAt(std::size_t pos, Coordinate& c) const
+{
+    c = coords[pos];
+}
+
+void
+ArenaCoordinateSequence::toVector(std::vector<Coordinate>& out) const
+{
+    out.insert(out.end(), coords, coords + size);
+}
+
+void
+ArenaCoordinateSequence::add(const Coordinate& c)
+{
+    // c may live in the array moved by reserve()
+    const Coordinate copy = c;
+    reserve(size + 1);
+    new(coords + size) Coordinate(copy);
+    ++size;
+}
+
+void
+ArenaCoordinateSequence::add(const Coordinate& c, bool allowRepeated)
+{
+    if(!allowRepeated && size > 0 && coords[size - 1].equals2D(c)) {
+        return;
+    }
+    add(c);
+}
+
+void
+ArenaCoordinateSequence::add(std::size_t i, const Coordinate& coord,
+                             bool allowRepeated)
+{
+    // don't add duplicate coordinates
+    if(! allowRepeated && size > 0) {
+        if(i > 0 && coords[i - 1].equals2D(coord)) {
+            return;
+        }
+        if(i < size && coords[i].equals2D(coord)) {
+            return;
+        }
+    }
+
+    const Coordinate copy = coord;
+    reserve(size + 1);
+    new(coords + size) Coordinate();
+    std::copy_backward(coords + i, coords + size, coords + size + 1);
+    coords[i] = copy;
+    ++size;
+}
+
+void
+ArenaCoordinateSequence::setAt(const Coordinate& c, std::size_t pos)
+{
+    coords[pos] = c;
+}
+
+void
+ArenaCoordinateSequence::setPoints(const std::vector<Coordinate>& v)
+{
+    if(v.size() > capacity) {
+        arena->deallocate(coords, capacity * sizeof(Coordinate));
+        coords = nullptr;
+        size = 0;
+        capacity = 0;
+        reserve(v.size());
+    }
+    std::uninitialized_copy(v.begin(), v.end(), coords);
+    size = v.size();
+}
+
+std::size_t
+ArenaCoordinateSequence::getDimension() const
+{
+    if(dimension != 0) {
+        return dimension;
+    }
+
+    if(size == 0) {
+        return 3;
+    }
+
+    dimension = std::isnan(coords[0].z) ? 2 : 3;
+    return dimension;
+}
+
+double
+ArenaCoordinateSequence::getOrdinate(std::size_t index, std::size_t ordinateIndex) const
+{
+    switch(ordinateIndex) {
+    case CoordinateSequence::X:
+        return coords[index].x;
+    case CoordinateSequence::Y:
+        return coords[index].y;
+    case CoordinateSequence::Z:
+        return coords[index].z;
+    default:
+        return DoubleNotANumber;
+    }
+}
+
+void
+ArenaCoordinateSequence::setOrdinate(std::size_t index, std::size_t ordinateIndex,
+                                     double value)
+{
+    switch(ordinateIndex) {
+    case CoordinateSequence::X:
+        coords[index].x = value;
+        break;
+    case CoordinateSequence::Y:
+        coords[index].y = value;
+        break;
+    case CoordinateSequence::Z:
+        coords[index].z = value;
+        break;
+    default: {
+        std::stringstream ss;
+        ss << "Unknown ordinate index " << ordinateIndex;
+        throw util::IllegalArgumentException(ss.str());
+    }
+    }
+}
+
+void
+ArenaCoordinateSequence::expandEnvelope(Envelope& env) const
+{
+    if(size == 0) {
+        return;
+    }
+
+    double minx = coords[0].x;
+    double maxx = coords[0].x;
+    double miny = coords[0].y;
+    double maxy = coords[0].y;
+    for(std::size_t i = 1; i < size; ++i) {
+        minx = minx < coords[i].x ? minx : coords[i].x;
+        maxx = maxx > coords[i].x ? maxx : coords[i].x;
+        miny = miny < coords[i].y ? miny : coords[i].y;
+        maxy = maxy > coords[i].y ? maxy : coords[i].y;
+    }
+    env.expandToInclude(minx, miny);
+    env.expandToInclude(maxx, maxy);
+}
+
+void
+ArenaCoordinateSequence::apply_rw(const CoordinateFilter* filter)
+{
+    for(std::size_t i = 0; i < size; ++i) {
+        filter->filter_rw(&coords[i]);
+    }
+    dimension = 0; // re-check, as CoordinateArraySequence does
+}
+
+void
+ArenaCoordinateSequence::apply_ro(CoordinateFilter* filter) const
+{
+    for(std::size_t i = 0; i < size; ++i) {
+        filter->filter_ro(&coords[i]);
+    }
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -190,9 +190,24 @@ CoordinateArraySequence::~CoordinateArraySequence()
 void
 CoordinateArraySequence::expandEnvelope(Envelope& env) const
 {
-    for(size_t i = 0, n = vect->size(); i < n; ++i) {
-        env.expandToInclude((*vect)[i]);
+    const size_t n = vect->size();
+    if(n == 0) {
+        return;
+    }
+
+    const Coordinate* c = vect->data();
+    double minx = c[0].x;
+    double maxx = c[0].x;
+    double miny = c[0].y;
+    double maxy = c[0].y;
+    for(size_t i = 1; i < n; ++i) {
+        minx = minx < c[i].x ? minx : c[i].x;
+        maxx = maxx > c[i].x ? maxx : c[i].x;
+        miny = miny < c[i].y ? miny : c[i].y;
+        maxy = maxy > c[i].y ? maxy : c[i].y;
     }
+    env.expandToInclude(minx, miny);
+    env.expandToInclude(maxx, maxy);
 }
 
 double
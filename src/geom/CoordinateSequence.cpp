@@ -19,6 +19,7 @@
 #include <geos/geom/CoordinateArraySequenceFactory.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Envelope.h>
+#include <geos/util/Arena.h>
 
 #include <cstdio>
 #include <algorithm>
@@ -36,6 +37,32 @@ namespace geom { // geos::geom
 static Profiler* profiler = Profiler::instance();
 #endif
 
+void*
+CoordinateSequence::operator new(std::size_t size)
+{
+    static_assert(alignof(CoordinateSequence) <= geos::util::Arena::OBJECT_ALIGNMENT,
+                  "CoordinateSequence objects are too strictly aligned for an Arena");
+    return geos::util::Arena::allocateObject(size, nullptr);
+}
+
+void*
+CoordinateSequence::operator new(std::size_t size, geos::util::Arena& arena)
+{
+    return geos::util::Arena::allocateObject(size, &arena);
+}
+
+void
+CoordinateSequence::operator delete(void* p, std::size_t size)
+{
+    geos::util::Arena::deallocateObject(p, size);
+}
+
+void
+CoordinateSequence::operator delete(void* p, geos::util::Arena&)
+{
+    geos::util::Arena::deallocateObject(p);
+}
+
 bool
 CoordinateSequence::hasRepeatedPoints() const
 {
@@ -33,6 +33,7 @@
 #include <geos/geom/MultiLineString.h>
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/IntersectionMatrix.h>
+#include <geos/util/Arena.h>
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/algorithm/Centroid.h>
 #include <geos/algorithm/InteriorPointPoint.h>
@@ -48,6 +49,7 @@
 #include <geos/operation/overlay/OverlayOp.h>
 #include <geos/operation/union/UnaryUnionOp.h>
 #include <geos/operation/overlay/snap/SnapIfNeededOverlayOp.h>
+#include <geos/operation/overlay/snap/SnapRoundingOverlayOp.h>
 #include <geos/operation/buffer/BufferOp.h>
 #include <geos/operation/distance/DistanceOp.h>
 #include <geos/operation/IsSimpleOp.h>
@@ -108,7 +110,8 @@ Geometry::GeometryChangedFilter Geometry::geometryChangedFilter;
 
 Geometry::Geometry(const GeometryFactory* newFactory)
     :
-    envelope(nullptr),
+    envelopeComputed(false),
+    holdsFactoryRef(true),
     _factory(newFactory),
     _userData(nullptr)
 {
@@ -121,15 +124,14 @@ Geometry::Geometry(const GeometryFactory* newFactory)
 
 Geometry::Geometry(const Geometry& geom)
     :
+    envelope(geom.envelope),
+    envelopeComputed(geom.envelopeComputed),
+    holdsFactoryRef(true),
     SRID(geom.getSRID()),
     _factory(geom._factory),
     _userData(nullptr)
 {
-    if(geom.envelope.get()) {
-        envelope.reset(new Envelope(*(geom.envelope)));
-    }
     //factory=geom.factory;
-    //envelope(new Envelope(*(geom.envelope.get())));
     //SRID=geom.getSRID();
     //_userData=NULL;
     _factory->addRef();
@@ -265,8 +267,7 @@ Geometry::geometryChanged()
 void
 Geometry::geometryChangedAction()
 {
-    //delete envelope;
-    envelope.reset(nullptr);
+    envelopeComputed = false;
 }
 
 bool
@@ -284,10 +285,11 @@ Geometry::getEnvelope() const
 const Envelope*
 Geometry::getEnvelopeInternal() const
 {
-    if(!envelope.get()) {
+    if(!envelopeComputed) {
         envelope = computeEnvelopeInternal();
+        envelopeComputed = true;
     }
-    return envelope.get();
+    return &envelope;
 }
 
 bool
@@ -578,6 +580,12 @@ Geometry::intersection(const Geometry* other) const
     return BinaryOp(this, other, overlayOp(OverlayOp::opINTERSECTION));
 }
 
+std::unique_ptr<Geometry>
+Geometry::intersection(const Geometry* other, const PrecisionModel& pm) const
+{
+    return SnapRoundingOverlayOp::overlayOp(*this, *other, OverlayOp::opINTERSECTION, pm);
+}
+
 std::unique_ptr<Geometry>
 Geometry::Union(const Geometry* other) const
 {
@@ -630,6 +638,12 @@ Geometry::Union(const Geometry* other) const
     return BinaryOp(this, other, overlayOp(OverlayOp::opUNION));
 }
 
+std::unique_ptr<Geometry>
+Geometry::Union(const Geometry* other, const PrecisionModel& pm) const
+{
+    return SnapRoundingOverlayOp::overlayOp(*this, *other, OverlayOp::opUNION, pm);
+}
+
 /* public */
 Geometry::Ptr
 Geometry::Union() const
@@ -653,6 +667,12 @@ Geometry::difference(const Geometry* other) const
     return BinaryOp(this, other, overlayOp(OverlayOp::opDIFFERENCE));
 }
 
+std::unique_ptr<Geometry>
+Geometry::difference(const Geometry* other, const PrecisionModel& pm) const
+{
+    return SnapRoundingOverlayOp::overlayOp(*this, *other, OverlayOp::opDIFFERENCE, pm);
+}
+
 std::unique_ptr<Geometry>
 Geometry::symDifference(const Geometry* other) const
 {
@@ -701,6 +721,12 @@ Geometry::symDifference(const Geometry* other) const
     return BinaryOp(this, other, overlayOp(OverlayOp::opSYMDIFFERENCE));
 }
 
+std::unique_ptr<Geometry>
+Geometry::symDifference(const Geometry* other, const PrecisionModel& pm) const
+{
+    return SnapRoundingOverlayOp::overlayOp(*this, *other, OverlayOp::opSYMDIFFERENCE, pm);
+}
+
 int
 Geometry::compareTo(const Geometry* geom) const
 {
@@ -842,9 +868,75 @@ Geometry::getLength() const
     return 0.0;
 }
 
+/*protected*/
+vector<Geometry*>*
+Geometry::adoptComponents(vector<Geometry*>* list) const
+{
+    geos::util::Arena* arena = _factory->getArena();
+    if(!arena) {
+        return list ? list : new vector<Geometry*>();
+    }
+
+    // release() frees the storage of the list if the geometry is
+    // abandoned with it
+    vector<Geometry*>* arenaList = arena->newOwned<vector<Geometry*>>();
+    if(list) {
+        try {
+            arenaList->assign(list->begin(), list->end());
+        }
+        catch(...) {
+            arena->deleteOwned(arenaList);
+            throw;
+        }
+        delete list;
+    }
+    return arenaList;
+}
+
+/*protected*/
+void
+Geometry::deleteComponents(vector<Geometry*>* list) const
+{
+    // only geometries in an arena hold no reference on their factory
+    if(!holdsFactoryRef) {
+        _factory->getArena()->deleteOwned(list);
+    }
+    else {
+        delete list;
+    }
+}
+
 Geometry::~Geometry()
 {
-    _factory->dropRef();
+    if(holdsFactoryRef) {
+        _factory->dropRef();
+    }
+}
+
+void*
+Geometry::operator new(std::size_t size)
+{
+    static_assert(alignof(Geometry) <= geos::util::Arena::OBJECT_ALIGNMENT,
+                  "Geometry objects are too strictly aligned for an Arena");
+    return geos::util::Arena::allocateObject(size, nullptr);
+}
+
+void*
+Geometry::operator new(std::size_t size, geos::util::Arena& arena)
+{
+    return geos::util::Arena::allocateObject(size, &arena);
+}
+
+void
+Geometry::operator delete(void* p, std::size_t size)
+{
+    geos::util::Arena::deallocateObject(p, size);
+}
+
+void
+Geometry::operator delete(void* p, geos::util::Arena&)
+{
+    geos::util::Arena::deallocateObject(p);
 }
 
 bool
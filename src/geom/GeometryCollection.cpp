@@ -59,14 +59,14 @@ GeometryCollection::GeometryCollection(vector<Geometry*>* newGeoms, const Geomet
     Geometry(factory)
 {
     if(newGeoms == nullptr) {
-        geometries = new vector<Geometry*>();
+        geometries = adoptComponents(nullptr);
         return;
     }
     if(hasNullElements(newGeoms)) {
         throw  util::IllegalArgumentException("geometries must not contain null elements\n");
         return;
     }
-    geometries = newGeoms;
+    geometries = adoptComponents(newGeoms);
 
     // Set SRID for inner geoms
     size_t ngeoms = geometries->size();
@@ -249,13 +249,13 @@ GeometryCollection::normalize()
     sort(geometries->begin(), geometries->end(), GeometryGreaterThen());
 }
 
-Envelope::Ptr
+Envelope
 GeometryCollection::computeEnvelopeInternal() const
 {
-    Envelope::Ptr p_envelope(new Envelope());
+    Envelope p_envelope;
     for(size_t i = 0; i < geometries->size(); i++) {
         const Envelope* env = (*geometries)[i]->getEnvelopeInternal();
-        p_envelope->expandToInclude(env);
+        p_envelope.expandToInclude(env);
     }
     return p_envelope;
 }
@@ -264,7 +264,22 @@ int
 GeometryCollection::compareToSameClass(const Geometry* g) const
 {
     const GeometryCollection* gc = dynamic_cast<const GeometryCollection*>(g);
-    return compare(*geometries, *(gc->geometries));
+    // compare(vector, vector) would copy both lists
+    const vector<Geometry*>& a = *geometries;
+    const vector<Geometry*>& b = *(gc->geometries);
+    for(size_t i = 0, n = min(a.size(), b.size()); i < n; ++i) {
+        int comparison = a[i]->compareTo(b[i]);
+        if(comparison != 0) {
+            return comparison;
+        }
+    }
+    if(a.size() > b.size()) {
+        return 1;
+    }
+    if(a.size() < b.size()) {
+        return -1;
+    }
+    return 0;
 }
 
 const Coordinate*
@@ -365,7 +380,7 @@ GeometryCollection::~GeometryCollection()
     for(size_t i = 0; i < geometries->size(); ++i) {
         delete(*geometries)[i];
     }
-    delete geometries;
+    deleteComponents(geometries);
 }
 
 GeometryTypeId
@@ -35,6 +35,7 @@
 #include <geos/geom/util/CoordinateOperation.h>
 #include <geos/geom/util/GeometryEditor.h>
 #include <geos/util.h>
+#include <geos/util/Arena.h>
 
 #include <cassert>
 #include <vector>
@@ -75,8 +76,114 @@ public:
     }
 };
 
+/// Copies a geometry down to its coordinates with the given factory,
+/// unlike Geometry::clone() which keeps the factory of the original
+Geometry*
+copyGeometry(const Geometry& g, const GeometryFactory& factory)
+{
+    const CoordinateSequenceFactory* csf = factory.getCoordinateSequenceFactory();
+    switch(g.getGeometryTypeId()) {
+    case GEOS_POINT:
+        if(g.isEmpty()) {
+            return factory.createPoint();
+        }
+        return factory.createPoint(
+                   csf->create(*dynamic_cast<const Point&>(g).getCoordinatesRO()).release());
+    case GEOS_LINESTRING:
+        return factory.createLineString(
+                   csf->create(*dynamic_cast<const LineString&>(g).getCoordinatesRO()).release());
+    case GEOS_LINEARRING:
+        return factory.createLinearRing(
+                   csf->create(*dynamic_cast<const LinearRing&>(g).getCoordinatesRO()).release());
+    case GEOS_POLYGON: {
+        const Polygon& poly = dynamic_cast<const Polygon&>(g);
+        LinearRing* shell = dynamic_cast<LinearRing*>(
+                                copyGeometry(*poly.getExteriorRing(), factory));
+        vector<Geometry*>* holes = new vector<Geometry*>;
+        try {
+            holes->reserve(poly.getNumInteriorRing());
+            for(size_t i = 0; i < poly.getNumInteriorRing(); i++) {
+                holes->push_back(copyGeometry(*poly.getInteriorRingN(i), factory));
+            }
+            return factory.createPolygon(shell, holes);
+        }
+        catch(...) {
+            delete shell;
+            for(Geometry* hole : *holes) {
+                delete hole;
+            }
+            delete holes;
+            throw;
+        }
+    }
+    default: {
+        vector<Geometry*>* geoms = new vector<Geometry*>;
+        try {
+            geoms->reserve(g.getNumGeometries());
+            for(size_t i = 0; i < g.getNumGeometries(); i++) {
+                geoms->push_back(copyGeometry(*g.getGeometryN(i), factory));
+            }
+            switch(g.getGeometryTypeId()) {
+            case GEOS_MULTIPOINT:
+                return factory.createMultiPoint(geoms);
+            case GEOS_MULTILINESTRING:
+                return factory.createMultiLineString(geoms);
+            case GEOS_MULTIPOLYGON:
+                return factory.createMultiPolygon(geoms);
+            default:
+                return factory.createGeometryCollection(geoms);
+            }
+        }
+        catch(...) {
+            for(Geometry* geom : *geoms) {
+                delete geom;
+            }
+            delete geoms;
+            throw;
+        }
+    }
+    }
+}
+
 } // anonymous namespace
 
+/*private*/
+template<class T, class... Args>
+T*
+GeometryFactory::newGeometry(Args&& ... args) const
+{
+    if(arena) {
+        T* g = new(*arena) T(std::forward<Args>(args)...);
+        // Arena::release() may abandon the geometry without running its
+        // destructor: rely on the factory outliving the arena instead
+        g->holdsFactoryRef = false;
+        dropRef();
+        return g;
+    }
+    return new T(std::forward<Args>(args)...);
+}
+
+/*private*/
+Geometry*
+GeometryFactory::copyComponent(const Geometry& g) const
+{
+    // a clone would be on the heap, with the factory of g
+    if(arena) {
+        return copyGeometry(g, *this);
+    }
+    return g.clone().release();
+}
+
+/*private*/
+CoordinateSequence::Ptr
+GeometryFactory::copyCoordinates(const CoordinateSequence& seq) const
+{
+    if(arena) {
+        return coordinateListFactory->create(seq);
+    }
+    return seq.clone();
+}
+
 
 
 /*protected*/
@@ -221,6 +328,34 @@ GeometryFactory::create(const PrecisionModel* pm, int newSRID)
            );
 }
 
+/*protected*/
+GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID,
+                                 geos::util::Arena& p_arena)
+    :
+    SRID(newSRID),
+    arena(&p_arena),
+    arenaSequenceFactory(new CoordinateArraySequenceFactory(&p_arena))
+    , _refCount(0), _autoDestroy(false)
+{
+    if(! pm) {
+        precisionModel = new PrecisionModel();
+    }
+    else {
+        precisionModel = new PrecisionModel(*pm);
+    }
+    coordinateListFactory = arenaSequenceFactory.get();
+}
+
+/*public static*/
+GeometryFactory::Ptr
+GeometryFactory::create(const PrecisionModel* pm, int newSRID,
+                        geos::util::Arena& p_arena)
+{
+    return GeometryFactory::Ptr(
+               new GeometryFactory(pm, newSRID, p_arena)
+           );
+}
+
 /*protected*/
 GeometryFactory::GeometryFactory(const GeometryFactory& gf)
 {
@@ -228,6 +363,11 @@ GeometryFactory::GeometryFactory(const GeometryFactory& gf)
     precisionModel = new PrecisionModel(*(gf.precisionModel));
     SRID = gf.SRID;
     coordinateListFactory = gf.coordinateListFactory;
+    arena = gf.arena;
+    if(arena) {
+        arenaSequenceFactory.reset(new CoordinateArraySequenceFactory(arena));
+        coordinateListFactory = arenaSequenceFactory.get();
+    }
     _autoDestroy = false;
     _refCount = 0;
 }
@@ -309,7 +449,7 @@ GeometryFactory::getPrecisionModel() const
 Point*
 GeometryFactory::createPoint() const
 {
-    return new Point(nullptr, this);
+    return newGeometry<Point>(nullptr, this);
 }
 
 /*public*/
@@ -321,8 +461,8 @@ GeometryFactory::createPoint(const Coordinate& coordinate) const
     }
     else {
         std::size_t dim = std::isnan(coordinate.z) ? 2 : 3;
-        auto cl = coordinateListFactory->create(new vector<Coordinate>(1, coordinate), dim);
-        //cl->setAt(coordinate, 0);
+        auto cl = coordinateListFactory->create(std::size_t(1), dim);
+        cl->setAt(coordinate, 0);
         Point* ret = createPoint(cl.release());
         return ret;
     }
@@ -332,15 +472,15 @@ GeometryFactory::createPoint(const Coordinate& coordinate) const
 Point*
 GeometryFactory::createPoint(CoordinateSequence* newCoords) const
 {
-    return new Point(newCoords, this);
+    return newGeometry<Point>(newCoords, this);
 }
 
 /*public*/
 Point*
 GeometryFactory::createPoint(const CoordinateSequence& fromCoords) const
 {
-    auto newCoords = fromCoords.clone();
-    return new Point(newCoords.release(), this);
+    auto newCoords = copyCoordinates(fromCoords);
+    return newGeometry<Point>(newCoords.release(), this);
 
 }
 
@@ -348,7 +488,7 @@ GeometryFactory::createPoint(const CoordinateSequence& fromCoords) const
 MultiLineString*
 GeometryFactory::createMultiLineString() const
 {
-    return new MultiLineString(nullptr, this);
+    return newGeometry<MultiLineString>(nullptr, this);
 }
 
 /*public*/
@@ -356,7 +496,7 @@ MultiLineString*
 GeometryFactory::createMultiLineString(vector<Geometry*>* newLines)
 const
 {
-    return new MultiLineString(newLines, this);
+    return newGeometry<MultiLineString>(newLines, this);
 }
 
 /*public*/
@@ -370,11 +510,11 @@ const
         if(! line) {
             throw geos::util::IllegalArgumentException("createMultiLineString called with a vector containing non-LineStrings");
         }
-        (*newGeoms)[i] = new LineString(*line);
+        (*newGeoms)[i] = createLineString(*line).release();
     }
     MultiLineString* g = nullptr;
     try {
-        g = new MultiLineString(newGeoms, this);
+        g = newGeometry<MultiLineString>(newGeoms, this);
     }
     catch(...) {
         for(size_t i = 0; i < newGeoms->size(); i++) {
@@ -390,21 +530,21 @@ const
 GeometryCollection*
 GeometryFactory::createGeometryCollection() const
 {
-    return new GeometryCollection(nullptr, this);
+    return newGeometry<GeometryCollection>(nullptr, this);
 }
 
 /*public*/
 Geometry*
 GeometryFactory::createEmptyGeometry() const
 {
-    return new GeometryCollection(nullptr, this);
+    return newGeometry<GeometryCollection>(nullptr, this);
 }
 
 /*public*/
 GeometryCollection*
 GeometryFactory::createGeometryCollection(vector<Geometry*>* newGeoms) const
 {
-    return new GeometryCollection(newGeoms, this);
+    return newGeometry<GeometryCollection>(newGeoms, this);
 }
 
 /*public*/
@@ -413,11 +553,11 @@ GeometryFactory::createGeometryCollection(const vector<Geometry*>& fromGeoms) co
 {
     vector<Geometry*>* newGeoms = new vector<Geometry*>(fromGeoms.size());
     for(size_t i = 0; i < fromGeoms.size(); i++) {
-        (*newGeoms)[i] = fromGeoms[i]->clone().release();
+        (*newGeoms)[i] = copyComponent(*fromGeoms[i]);
     }
     GeometryCollection* g = nullptr;
     try {
-        g = new GeometryCollection(newGeoms, this);
+        g = newGeometry<GeometryCollection>(newGeoms, this);
     }
     catch(...) {
         for(size_t i = 0; i < newGeoms->size(); i++) {
@@ -433,14 +573,14 @@ GeometryFactory::createGeometryCollection(const vector<Geometry*>& fromGeoms) co
 MultiPolygon*
 GeometryFactory::createMultiPolygon() const
 {
-    return new MultiPolygon(nullptr, this);
+    return newGeometry<MultiPolygon>(nullptr, this);
 }
 
 /*public*/
 MultiPolygon*
 GeometryFactory::createMultiPolygon(vector<Geometry*>* newPolys) const
 {
-    return new MultiPolygon(newPolys, this);
+    return newGeometry<MultiPolygon>(newPolys, this);
 }
 
 /*public*/
@@ -449,11 +589,11 @@ GeometryFactory::createMultiPolygon(const vector<Geometry*>& fromPolys) const
 {
     vector<Geometry*>* newGeoms = new vector<Geometry*>(fromPolys.size());
     for(size_t i = 0; i < fromPolys.size(); i++) {
-        (*newGeoms)[i] = fromPolys[i]->clone().release();
+        (*newGeoms)[i] = copyComponent(*fromPolys[i]);
     }
     MultiPolygon* g = nullptr;
     try {
-        g = new MultiPolygon(newGeoms, this);
+        g = newGeometry<MultiPolygon>(newGeoms, this);
     }
     catch(...) {
         for(size_t i = 0; i < newGeoms->size(); i++) {
@@ -469,31 +609,31 @@ GeometryFactory::createMultiPolygon(const vector<Geometry*>& fromPolys) const
 LinearRing*
 GeometryFactory::createLinearRing() const
 {
-    return new LinearRing(nullptr, this);
+    return newGeometry<LinearRing>(nullptr, this);
 }
 
 /*public*/
 LinearRing*
 GeometryFactory::createLinearRing(CoordinateSequence* newCoords) const
 {
-    return new LinearRing(newCoords, this);
+    return newGeometry<LinearRing>(newCoords, this);
 }
 
 /*public*/
 Geometry::Ptr
 GeometryFactory::createLinearRing(CoordinateSequence::Ptr newCoords) const
 {
-    return Geometry::Ptr(new LinearRing(std::move(newCoords), this));
+    return Geometry::Ptr(newGeometry<LinearRing>(std::move(newCoords), this));
 }
 
 /*public*/
 LinearRing*
 GeometryFactory::createLinearRing(const CoordinateSequence& fromCoords) const
 {
-    auto newCoords = fromCoords.clone();
+    auto newCoords = copyCoordinates(fromCoords);
     LinearRing* g = nullptr;
     // construction failure will delete newCoords
-    g = new LinearRing(newCoords.release(), this);
+    g = newGeometry<LinearRing>(newCoords.release(), this);
     return g;
 }
 
@@ -501,7 +641,7 @@ GeometryFactory::createLinearRing(const CoordinateSequence& fromCoords) const
 MultiPoint*
 GeometryFactory::createMultiPoint(vector<Geometry*>* newPoints) const
 {
-    return new MultiPoint(newPoints, this);
+    return newGeometry<MultiPoint>(newPoints, this);
 }
 
 /*public*/
@@ -510,12 +650,12 @@ GeometryFactory::createMultiPoint(const vector<Geometry*>& fromPoints) const
 {
     vector<Geometry*>* newGeoms = new vector<Geometry*>(fromPoints.size());
     for(size_t i = 0; i < fromPoints.size(); i++) {
-        (*newGeoms)[i] = fromPoints[i]->clone().release();
+        (*newGeoms)[i] = copyComponent(*fromPoints[i]);
     }
 
     MultiPoint* g = nullptr;
     try {
-        g = new MultiPoint(newGeoms, this);
+        g = newGeometry<MultiPoint>(newGeoms, this);
     }
     catch(...) {
         for(size_t i = 0; i < newGeoms->size(); i++) {
@@ -531,7 +671,7 @@ GeometryFactory::createMultiPoint(const vector<Geometry*>& fromPoints) const
 MultiPoint*
 GeometryFactory::createMultiPoint() const
 {
-    return new MultiPoint(nullptr, this);
+    return newGeometry<MultiPoint>(nullptr, this);
 }
 
 /*public*/
@@ -588,7 +728,7 @@ GeometryFactory::createMultiPoint(const std::vector<Coordinate>& fromCoords) con
 Polygon*
 GeometryFactory::createPolygon() const
 {
-    return new Polygon(nullptr, nullptr, this);
+    return newGeometry<Polygon>(nullptr, nullptr, this);
 }
 
 /*public*/
@@ -596,7 +736,7 @@ Polygon*
 GeometryFactory::createPolygon(LinearRing* shell, vector<Geometry*>* holes)
 const
 {
-    return new Polygon(shell, holes, this);
+    return newGeometry<Polygon>(shell, holes, this);
 }
 
 /*public*/
@@ -604,14 +744,14 @@ Polygon*
 GeometryFactory::createPolygon(const LinearRing& shell, const vector<Geometry*>& holes)
 const
 {
-    LinearRing* newRing = dynamic_cast<LinearRing*>(shell.clone().release());
+    LinearRing* newRing = dynamic_cast<LinearRing*>(copyComponent(shell));
     vector<Geometry*>* newHoles = new vector<Geometry*>(holes.size());
     for(size_t i = 0; i < holes.size(); i++) {
-        (*newHoles)[i] = holes[i]->clone().release();
+        (*newHoles)[i] = copyComponent(*holes[i]);
     }
     Polygon* g = nullptr;
     try {
-        g = new Polygon(newRing, newHoles, this);
+        g = newGeometry<Polygon>(newRing, newHoles, this);
     }
     catch(...) {
         delete newRing;
@@ -628,15 +768,19 @@ const
 LineString*
 GeometryFactory::createLineString() const
 {
-    return new LineString(nullptr, this);
+    return newGeometry<LineString>(nullptr, this);
 }
 
 /*public*/
 std::unique_ptr<LineString>
 GeometryFactory::createLineString(const LineString& ls) const
 {
+    if(arena) {
+        // the copy constructor would keep the factory of ls
+        return std::unique_ptr<LineString>(
+                   createLineString(copyCoordinates(*ls.getCoordinatesRO()).release()));
+    }
     return std::unique_ptr<LineString>(new LineString(ls));
-    //return make_unique<LineString>(ls); // TODO why doesn't this work?
 }
 
 /*public*/
@@ -644,7 +788,7 @@ LineString*
 GeometryFactory::createLineString(CoordinateSequence* newCoords)
 const
 {
-    return new LineString(newCoords, this);
+    return newGeometry<LineString>(newCoords, this);
 }
 
 /*public*/
@@ -652,7 +796,7 @@ Geometry::Ptr
 GeometryFactory::createLineString(CoordinateSequence::Ptr newCoords)
 const
 {
-    return Geometry::Ptr(new LineString(std::move(newCoords), this));
+    return Geometry::Ptr(newGeometry<LineString>(std::move(newCoords), this));
 }
 
 /*public*/
@@ -660,10 +804,10 @@ LineString*
 GeometryFactory::createLineString(const CoordinateSequence& fromCoords)
 const
 {
-    auto newCoords = fromCoords.clone();
+    auto newCoords = copyCoordinates(fromCoords);
     LineString* g = nullptr;
     // construction failure will delete newCoords
-    g = new LineString(newCoords.release(), this);
+    g = newGeometry<LineString>(newCoords.release(), this);
     return g;
 }
 
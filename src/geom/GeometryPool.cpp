@@ -0,0 +1,33 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/GeometryPool.h>
+#include <geos/geom/Geometry.h>
+
+namespace geos {
+namespace geom { // geos::geom
+
+GeometryPool::GeometryPool(const PrecisionModel* pm, int srid)
+    :
+    factory(GeometryFactory::create(pm, srid, arena))
+{
+}
+
+void
+GeometryPool::recycle(std::unique_ptr<Geometry> g)
+{
+    // the Arena keeps the memory of the geometry objects
+    g.reset();
+}
+
+} // namespace geos::geom
+} // namespace geos
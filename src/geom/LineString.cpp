@@ -200,7 +200,13 @@ LineString::isClosed() const
     if(isEmpty()) {
         return false;
     }
-    return getCoordinateN(0).equals2D(getCoordinateN(getNumPoints() - 1));
+    // copies, as sequences may have to build the references
+    // getCoordinateN returns
+    Coordinate first;
+    Coordinate last;
+    points->getAt(0, first);
+    points->getAt(points->size() - 1, last);
+    return first.equals2D(last);
 }
 
 bool
@@ -248,36 +254,18 @@ LineString::isCoordinate(Coordinate& pt) const
 }
 
 /*protected*/
-Envelope::Ptr
+Envelope
 LineString::computeEnvelopeInternal() const
 {
+    Envelope env;
     if(isEmpty()) {
-        // We don't return NULL here
-        // as it would indicate "unknown"
-        // envelope. In this case we
-        // *know* the envelope is EMPTY.
-        return Envelope::Ptr(new Envelope());
+        // We *know* the envelope is EMPTY.
+        return env;
     }
 
     assert(points.get());
-    const Coordinate& c = points->getAt(0);
-    double minx = c.x;
-    double miny = c.y;
-    double maxx = c.x;
-    double maxy = c.y;
-    std::size_t npts = points->getSize();
-    for(std::size_t i = 1; i < npts; i++) {
-        const Coordinate& c1 = points->getAt(i);
-        minx = minx < c1.x ? minx : c1.x;
-        maxx = maxx > c1.x ? maxx : c1.x;
-        miny = miny < c1.y ? miny : c1.y;
-        maxy = maxy > c1.y ? maxy : c1.y;
-    }
-
-    // caller expects a newly allocated Envelope.
-    // this function won't be called twice, unless
-    // cached Envelope is invalidated (set to NULL)
-    return Envelope::Ptr(new Envelope(minx, maxx, miny, maxy));
+    points->expandEnvelope(env);
+    return env;
 }
 
 bool
@@ -0,0 +1,406 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util.h>
+
+#include <cassert>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace geos {
+namespace geom { // geos::geom
+
+namespace {
+
+std::size_t
+packedDimension(std::size_t requested)
+{
+    return requested == 3 ? 3 : 2;
+}
+
+bool
+hasZ(const Coordinate& c)
+{
+    return !std::isnan(c.z);
+}
+
+// Guards building the mirrors, which is rare
+std::mutex mirrorMutex;
+
+}
+
+PackedCoordinateSequence::PackedCoordinateSequence()
+    :
+    dimension(2),
+    coordRefs(nullptr)
+{
+}
+
+PackedCoordinateSequence::PackedCoordinateSequence(std::size_t n,
+        std::size_t dimension_in)
+    :
+    dimension(packedDimension(dimension_in)),
+    coordRefs(nullptr)
+{
+    coords.resize(n * dimension, 0.0);
+    if(dimension == 3) {
+        for(std::size_t i = 0; i < n; ++i) {
+            coords[i * 3 + 2] = DoubleNotANumber;
+        }
+    }
+}
+
+PackedCoordinateSequence::PackedCoordinateSequence(std::vector<double>&& coords_in,
+        std::size_t dimension_in)
+    :
+    coords(std::move(coords_in)),
+    dimension(dimension_in),
+    coordRefs(nullptr)
+{
+    if(dimension != 2 && dimension != 3) {
+        throw util::IllegalArgumentException("PackedCoordinateSequence dimension must be 2 or 3");
+    }
+    if(coords.size() % dimension != 0) {
+        throw util::IllegalArgumentException("Packed array does not contain an integral number of coordinates");
+    }
+}
+
+PackedCoordinateSequence::PackedCoordinateSequence(
+    const std::vector<Coordinate>& coords_in, std::size_t dimension_in)
+    :
+    dimension(packedDimension(dimension_in)),
+    coordRefs(nullptr)
+{
+    setPoints(coords_in);
+}
+
+PackedCoordinateSequence::PackedCoordinateSequence(
+    const PackedCoordinateSequence& seq)
+    :
+    CoordinateSequence(seq),
+    coords(seq.coords),
+    dimension(seq.dimension),
+    coordRefs(nullptr)
+{
+}
+
+PackedCoordinateSequence::PackedCoordinateSequence(
+    const CoordinateSequence& seq)
+    :
+    CoordinateSequence(seq),
+    dimension(2),
+    coordRefs(nullptr)
+{
+    const std::size_t n = seq.size();
+    Coordinate c;
+    for(std::size_t i = 0; i < n; ++i) {
+        seq.getAt(i, c);
+        if(hasZ(c)) {
+            dimension = 3;
+            break;
+        }
+    }
+
+    coords.resize(n * dimension);
+    for(std::size_t i = 0; i < n; ++i) {
+        seq.getAt(i, c);
+        coords[i * dimension] = c.x;
+        coords[i * dimension + 1] = c.y;
+        if(dimension == 3) {
+            coords[i * 3 + 2] = c.z;
+        }
+    }
+}
+
+PackedCoordinateSequence::~PackedCoordinateSequence()
+{
+    delete coordRefs.load();
+}
+
+std::unique_ptr<CoordinateSequence>
+PackedCoordinateSequence::clone() const
+{
+    return detail::make_unique<PackedCoordinateSequence>(*this);
+}
+
+/*private*/
+void
+PackedCoordinateSequence::promoteToXYZ()
+{
+    assert(dimension == 2);
+    const std::size_t n = getSize();
+    std::vector<double> xyz(n * 3);
+    for(std::size_t i = 0; i < n; ++i) {
+        xyz[i * 3] = coords[i * 2];
+        xyz[i * 3 + 1] = coords[i * 2 + 1];
+        xyz[i * 3 + 2] = DoubleNotANumber;
+    }
+    coords.swap(xyz);
+    dimension = 3;
+}
+
+/*private*/
+const Coordinate*
+PackedCoordinateSequence::coordinateArray() const
+{
+    // the packed doubles are not Coordinate objects, so even XYZ
+    // storage is not read through a Coordinate pointer
+    std::vector<Coordinate>* refs = coordRefs.load(std::memory_order_acquire);
+    if(!refs) {
+        // concurrent const readers may get here together
+        std::lock_guard<std::mutex> lock(mirrorMutex);
+        refs = coordRefs.load(std::memory_order_relaxed);
+        if(!refs) {
+            refs = new std::vector<Coordinate>();
+            toVector(*refs);
+            coordRefs.store(refs, std::memory_order_release);
+        }
+    }
+    return refs->data();
+}
+
+/*private*/
+void
+PackedCoordinateSequence::dropMirror()
+{
+    delete coordRefs.exchange(nullptr);
+}
+
+const Coordinate&
+PackedCoordinateSequence::getAt(std::size_t pos) const
+{
+    return coordinateArray()[pos];
+}
+
+void
+PackedCoordinateSequence::getAt(std::size_t pos, Coordinate& c) const
+{
+    const double* p = &coords[pos * dimension];
+    c.x = p[0];
+    c.y = p[1];
+    c.z = dimension == 3 ? p[2] : DoubleNotANumber;
+}
+
+void
+PackedCoordinateSequence::toVector(std::vector<Coordinate>& out) const
+{
+    const std::size_t n = getSize();
+    out.reserve(out.size() + n);
+    Coordinate c;
+    for(std::size_t i = 0; i < n; ++i) {
+        getAt(i, c);
+        out.push_back(c);
+    }
+}
+
+void
+PackedCoordinateSequence::add(const Coordinate& c)
+{
+    if(dimension == 2 && hasZ(c)) {
+        promoteToXYZ();
+    }
+    coords.push_back(c.x);
+    coords.push_back(c.y);
+    if(dimension == 3) {
+        coords.push_back(c.z);
+    }
+    if(std::vector<Coordinate>* refs = coordRefs.load()) {
+        refs->push_back(c);
+    }
+}
+
+void
+PackedCoordinateSequence::add(const Coordinate& c, bool allowRepeated)
+{
+    if(!allowRepeated && !isEmpty()) {
+        const std::size_t last = getSize() - 1;
+        if(getX(last) == c.x && getY(last) == c.y) {
+            return;
+        }
+    }
+    add(c);
+}
+
+void
+PackedCoordinateSequence::add(std::size_t i, const Coordinate& coord,
+                              bool allowRepeated)
+{
+    // don't add duplicate coordinates
+    if(! allowRepeated) {
+        std::size_t sz = getSize();
+        if(sz > 0) {
+            if(i > 0 && getX(i - 1) == coord.x && getY(i - 1) == coord.y) {
+                return;
+            }
+            if(i < sz && getX(i) == coord.x && getY(i) == coord.y) {
+                return;
+            }
+        }
+    }
+
+    if(dimension == 2 && hasZ(coord)) {
+        promoteToXYZ();
+    }
+    double xyz[3] = { coord.x, coord.y, coord.z };
+    coords.insert(coords.begin() + static_cast<std::ptrdiff_t>(i * dimension),
+                  xyz, xyz + dimension);
+    if(std::vector<Coordinate>* refs = coordRefs.load()) {
+        refs->insert(refs->begin() + static_cast<std::ptrdiff_t>(i), coord);
+    }
+}
+
+void
+PackedCoordinateSequence::setAt(const Coordinate& c, std::size_t pos)
+{
+    if(dimension == 2 && hasZ(c)) {
+        promoteToXYZ();
+    }
+    double* p = &coords[pos * dimension];
+    p[0] = c.x;
+    p[1] = c.y;
+    if(dimension == 3) {
+        p[2] = c.z;
+    }
+    if(std::vector<Coordinate>* refs = coordRefs.load()) {
+        (*refs)[pos] = c;
+    }
+}
+
+void
+PackedCoordinateSequence::setPoints(const std::vector<Coordinate>& v)
+{
+    coords.clear();
+    dropMirror();
+    if(dimension == 2) {
+        for(const Coordinate& c : v) {
+            if(hasZ(c)) {
+                dimension = 3;
+                break;
+            }
+        }
+    }
+    coords.reserve(v.size() * dimension);
+    for(const Coordinate& c : v) {
+        coords.push_back(c.x);
+        coords.push_back(c.y);
+        if(dimension == 3) {
+            coords.push_back(c.z);
+        }
+    }
+}
+
+double
+PackedCoordinateSequence::getOrdinate(std::size_t index, std::size_t ordinateIndex) const
+{
+    if(ordinateIndex < dimension) {
+        return coords[index * dimension + ordinateIndex];
+    }
+    return DoubleNotANumber;
+}
+
+void
+PackedCoordinateSequence::setOrdinate(std::size_t index, std::size_t ordinateIndex,
+                                      double value)
+{
+    switch(ordinateIndex) {
+    case CoordinateSequence::X:
+    case CoordinateSequence::Y:
+        break;
+    case CoordinateSequence::Z:
+        if(dimension == 2) {
+            if(std::isnan(value)) {
+                return;
+            }
+            promoteToXYZ();
+        }
+        break;
+    default: {
+        std::stringstream ss;
+        ss << "Unknown ordinate index " << ordinateIndex;
+        throw util::IllegalArgumentException(ss.str());
+    }
+    }
+
+    coords[index * dimension + ordinateIndex] = value;
+    if(std::vector<Coordinate>* refs = coordRefs.load()) {
+        Coordinate& c = (*refs)[index];
+        switch(ordinateIndex) {
+        case CoordinateSequence::X:
+            c.x = value;
+            break;
+        case CoordinateSequence::Y:
+            c.y = value;
+            break;
+        default:
+            c.z = value;
+            break;
+        }
+    }
+}
+
+void
+PackedCoordinateSequence::expandEnvelope(Envelope& env) const
+{
+    const std::size_t n = getSize();
+    if(n == 0) {
+        return;
+    }
+
+    const double* p = coords.data();
+    double minx = p[0];
+    double maxx = p[0];
+    double miny = p[1];
+    double maxy = p[1];
+    for(std::size_t i = 1; i < n; ++i) {
+        const double x = p[i * dimension];
+        const double y = p[i * dimension + 1];
+        minx = x < minx ? x : minx;
+        maxx = x > maxx ? x : maxx;
+        miny = y < miny ? y : miny;
+        maxy = y > maxy ? y : maxy;
+    }
+    env.expandToInclude(minx, miny);
+    env.expandToInclude(maxx, maxy);
+}
+
+void
+PackedCoordinateSequence::apply_rw(const CoordinateFilter* filter)
+{
+    const std::size_t n = getSize();
+    Coordinate c;
+    for(std::size_t i = 0; i < n; ++i) {
+        getAt(i, c);
+        filter->filter_rw(&c);
+        setAt(c, i);
+    }
+}
+
+void
+PackedCoordinateSequence::apply_ro(CoordinateFilter* filter) const
+{
+    // Filters may keep the pointers they are given, so hand
+    // out the persistent Coordinate array.
+    const Coordinate* array = coordinateArray();
+    for(std::size_t i = 0, n = getSize(); i < n; ++i) {
+        filter->filter_ro(&array[i]);
+    }
+}
+
+} // namespace geos::geom
+} // namespace geos
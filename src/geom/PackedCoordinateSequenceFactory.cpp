@@ -0,0 +1,63 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/PackedCoordinateSequenceFactory.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+
+namespace geos {
+namespace geom { // geos::geom
+
+static PackedCoordinateSequenceFactory packedCoordinateSequenceFactory;
+
+std::unique_ptr<CoordinateSequence>
+PackedCoordinateSequenceFactory::create() const
+{
+    return std::unique_ptr<CoordinateSequence>(
+            new PackedCoordinateSequence());
+}
+
+std::unique_ptr<CoordinateSequence>
+PackedCoordinateSequenceFactory::create(std::vector<Coordinate>* coords,
+                                        std::size_t dimension) const
+{
+    // We take ownership of the vector but store the ordinates packed
+    std::unique_ptr<std::vector<Coordinate>> owned(coords);
+    if(!owned) {
+        return create();
+    }
+    return std::unique_ptr<CoordinateSequence>(
+            new PackedCoordinateSequence(*owned, dimension));
+}
+
+std::unique_ptr<CoordinateSequence>
+PackedCoordinateSequenceFactory::create(std::size_t size, std::size_t dimension) const
+{
+    return std::unique_ptr<CoordinateSequence>(
+            new PackedCoordinateSequence(size, dimension));
+}
+
+std::unique_ptr<CoordinateSequence>
+PackedCoordinateSequenceFactory::create(const CoordinateSequence& seq) const
+{
+    return std::unique_ptr<CoordinateSequence>(
+            new PackedCoordinateSequence(seq));
+}
+
+const CoordinateSequenceFactory*
+PackedCoordinateSequenceFactory::instance()
+{
+    return &packedCoordinateSequenceFactory;
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -83,10 +83,7 @@ Polygon::Polygon(LinearRing* newShell, vector<Geometry*>* newHoles,
         shell = newShell;
     }
 
-    if(newHoles == nullptr) {
-        holes = new vector<Geometry*>();
-    }
-    else {
+    if(newHoles != nullptr) {
         if(hasNullElements(newHoles)) {
             throw util::IllegalArgumentException("holes must not contain null elements");
         }
@@ -94,8 +91,8 @@ Polygon::Polygon(LinearRing* newShell, vector<Geometry*>* newHoles,
             if((*newHoles)[i]->getGeometryTypeId() != GEOS_LINEARRING) {
                 throw util::IllegalArgumentException("holes must be LinearRings");
             }
-        holes = newHoles;
     }
+    holes = adoptComponents(newHoles);
 }
 
 std::unique_ptr<CoordinateSequence>
@@ -230,10 +227,10 @@ Polygon::getBoundary() const
     return std::unique_ptr<Geometry>(ret);
 }
 
-Envelope::Ptr
+Envelope
 Polygon::computeEnvelopeInternal() const
 {
-    return Envelope::Ptr(new Envelope(*(shell->getEnvelopeInternal())));
+    return *(shell->getEnvelopeInternal());
 }
 
 bool
@@ -449,7 +446,7 @@ Polygon::~Polygon()
     for(size_t i = 0, n = holes->size(); i < n; ++i) {
         delete(*holes)[i];
     }
-    delete holes;
+    deleteComponents(holes);
 }
 
 GeometryTypeId
@@ -28,8 +28,8 @@
 
 #include <sstream>
 #include <string>
+#include <algorithm>
 #include <vector>
-#include <set>
 #include <utility> // std::pair
 
 #ifndef GEOS_DEBUG
@@ -47,33 +47,50 @@ namespace geos {
 namespace geomgraph { // geos.geomgraph
 
 EdgeIntersectionList::EdgeIntersectionList(Edge* newEdge):
+    ready(true),
+    preparedSize(0),
     edge(newEdge)
 {
 }
 
 EdgeIntersectionList::~EdgeIntersectionList()
 {
-    for(EdgeIntersectionList::iterator it = nodeMap.begin(),
-            endIt = nodeMap.end();
-            it != endIt; ++it) {
-        delete *it;
-    }
 }
 
-EdgeIntersection*
+void
 EdgeIntersectionList::add(const Coordinate& coord,
                           size_t segmentIndex, double dist)
 {
-    EdgeIntersection* eiNew = new EdgeIntersection(coord, segmentIndex, dist);
+    // the same intersection is often reported several times in a row
+    if(!nodeMap.empty() && nodeMap.back().segmentIndex == segmentIndex
+            && nodeMap.back().dist == dist) {
+        return;
+    }
+    nodeMap.emplace_back(coord, segmentIndex, dist);
+    ready = false;
 
-    pair<EdgeIntersectionList::iterator, bool> p = nodeMap.insert(eiNew);
-    if(p.second) {    // new EdgeIntersection inserted
-        return eiNew;
+    // bound the duplicates kept between two ordered accesses
+    if(nodeMap.size() >= 2 * max<size_t>(preparedSize, 16)) {
+        prepare();
     }
-    else {
-        delete eiNew;
-        return *(p.first);
+}
+
+/*private*/
+void
+EdgeIntersectionList::prepare() const
+{
+    if(ready) {
+        return;
     }
+
+    // stable, so that the first intersection added survives deduplication
+    stable_sort(nodeMap.begin(), nodeMap.end());
+    nodeMap.erase(unique(nodeMap.begin(), nodeMap.end(),
+    [](const EdgeIntersection & a, const EdgeIntersection & b) {
+        return !(a < b);
+    }), nodeMap.end());
+    ready = true;
+    preparedSize = nodeMap.size();
 }
 
 bool
@@ -85,13 +102,9 @@ EdgeIntersectionList::isEmpty() const
 bool
 EdgeIntersectionList::isIntersection(const Coordinate& pt) const
 {
-    EdgeIntersectionList::const_iterator
-    it = nodeMap.begin(),
-    endIt = nodeMap.end();
-
-    for(; it != endIt; ++it) {
-        EdgeIntersection* ei = *it;
-        if(ei->coord == pt) {
+    // no need for the order here
+    for(const EdgeIntersection& ei : nodeMap) {
+        if(ei.coord == pt) {
             return true;
         }
     }
@@ -113,14 +126,14 @@ EdgeIntersectionList::addSplitEdges(vector<Edge*>* edgeList)
     // of the edge
     addEndpoints();
 
-    EdgeIntersectionList::iterator it = nodeMap.begin();
+    EdgeIntersectionList::const_iterator it = begin();
 
     // there should always be at least two entries in the list
-    EdgeIntersection* eiPrev = *it;
+    const EdgeIntersection* eiPrev = &*it;
     ++it;
 
-    while(it != nodeMap.end()) {
-        EdgeIntersection* ei = *it;
+    while(it != end()) {
+        const EdgeIntersection* ei = &*it;
         Edge* newEdge = createSplitEdge(eiPrev, ei);
         edgeList->push_back(newEdge);
         eiPrev = ei;
@@ -129,8 +142,8 @@ EdgeIntersectionList::addSplitEdges(vector<Edge*>* edgeList)
 }
 
 Edge*
-EdgeIntersectionList::createSplitEdge(EdgeIntersection* ei0,
-                                      EdgeIntersection* ei1)
+EdgeIntersectionList::createSplitEdge(const EdgeIntersection* ei0,
+                                      const EdgeIntersection* ei1)
 {
 #if GEOS_DEBUG
     cerr << "[" << this << "] EdgeIntersectionList::createSplitEdge()" << endl;
@@ -190,8 +203,7 @@ operator<< (std::ostream& os, const EdgeIntersectionList& e)
     os << "Intersections:" << std::endl;
     EdgeIntersectionList::const_iterator it = e.begin(), endIt = e.end();
     for(; it != endIt; ++it) {
-        EdgeIntersection* ei = *it;
-        os << *ei << endl;
+        os << *it << endl;
     }
     return os;
 }
@@ -491,7 +491,7 @@ GeometryGraph::addSelfIntersectionNodes(int p_argIndex)
         for(EdgeIntersectionList::iterator
                 eiIt = eiL.begin(), eiEnd = eiL.end();
                 eiIt != eiEnd; ++eiIt) {
-            EdgeIntersection* ei = *eiIt;
+            const EdgeIntersection* ei = &*eiIt;
             addSelfIntersectionNode(p_argIndex, ei->coord, eLoc);
             GEOS_CHECK_FOR_INTERRUPTS();
         }
@@ -19,6 +19,7 @@
 #include <geos/index/chain/MonotoneChainBuilder.h>
 #include <geos/index/chain/MonotoneChain.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/PackedCoordinateSequence.h>
 #include <geos/geomgraph/Quadrant.h>
 
 #include <cassert>
@@ -37,6 +38,55 @@ using namespace std;
 using namespace geos::geomgraph;
 using namespace geos::geom;
 
+namespace {
+
+/*
+ * findChainEnd() working directly on the ordinates of a
+ * PackedCoordinateSequence, avoiding a virtual call per point.
+ */
+std::size_t
+findPackedChainEnd(const PackedCoordinateSequence& pts, std::size_t start)
+{
+    const std::size_t npts = pts.getSize();
+    const double* xy = pts.data();
+    const std::size_t stride = pts.stride();
+
+    assert(start < npts);
+
+    std::size_t safeStart = start;
+
+    // skip any zero-length segments at the start of the sequence
+    while(safeStart < npts - 1
+            && xy[safeStart * stride] == xy[(safeStart + 1) * stride]
+            && xy[safeStart * stride + 1] == xy[(safeStart + 1) * stride + 1]) {
+        ++safeStart;
+    }
+
+    // check if there are NO non-zero-length segments
+    if(safeStart >= npts - 1) {
+        return npts - 1;
+    }
+
+    int chainQuad = Quadrant::quadrant(
+                        xy[(safeStart + 1) * stride] - xy[safeStart * stride],
+                        xy[(safeStart + 1) * stride + 1] - xy[safeStart * stride + 1]);
+    std::size_t last = start + 1;
+    while(last < npts) {
+        double dx = xy[last * stride] - xy[(last - 1) * stride];
+        double dy = xy[last * stride + 1] - xy[(last - 1) * stride + 1];
+        // skip zero-length segments, but include them in the chain
+        if(dx != 0.0 || dy != 0.0) {
+            if(Quadrant::quadrant(dx, dy) != chainQuad) {
+                break;
+            }
+        }
+        ++last;
+    }
+    return last - 1;
+}
+
+}
+
 namespace geos {
 namespace index { // geos.index
 namespace chain { // geos.index.chain
@@ -77,6 +127,16 @@ MonotoneChainBuilder::getChainStartIndices(const CoordinateSequence& pts,
     std::size_t start = 0;
     startIndexList.push_back(start);
     const std::size_t n = pts.getSize() - 1;
+    if(const PackedCoordinateSequence* packed =
+                dynamic_cast<const PackedCoordinateSequence*>(&pts)) {
+        do {
+            std::size_t last = findPackedChainEnd(*packed, start);
+            startIndexList.push_back(last);
+            start = last;
+        }
+        while(start < n);
+        return;
+    }
     do {
         std::size_t last = findChainEnd(pts, start);
         startIndexList.push_back(last);
@@ -0,0 +1,215 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/AbstractNode.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+
+#include <algorithm>
+#include <cassert>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using geos::geom::Envelope;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+/*public*/
+FrozenSTRtree::FrozenSTRtree(STRtree& tree)
+{
+    AbstractSTRtree& source = tree;
+    source.build();
+
+    // Copy nodes breadth-first, so that the children of each node
+    // end up next to each other
+    std::vector<AbstractNode*> queue;
+    queue.push_back(source.getRoot());
+    nodes.resize(1);
+
+    for(std::size_t i = 0; i < queue.size(); ++i) {
+        AbstractNode* node = queue[i];
+        const Envelope* bounds = static_cast<const Envelope*>(node->getBounds());
+        if(bounds) {
+            nodes[i].env = *bounds;
+        }
+
+        const std::vector<Boundable*>& children = *(node->getChildBoundables());
+        nodes[i].childCount = children.size();
+        nodes[i].isLeaf = (node->getLevel() == 0);
+
+        if(nodes[i].isLeaf) {
+            nodes[i].childStart = items.size();
+            for(Boundable* child : children) {
+                const ItemBoundable* ib = static_cast<const ItemBoundable*>(child);
+                itemEnvs.push_back(*static_cast<const Envelope*>(ib->getBounds()));
+                items.push_back(ib->getItem());
+            }
+        }
+        else {
+            nodes[i].childStart = nodes.size();
+            nodes.resize(nodes.size() + children.size());
+            for(Boundable* child : children) {
+                queue.push_back(static_cast<AbstractNode*>(child));
+            }
+        }
+    }
+    assert(nodes.size() == queue.size());
+}
+
+/*private*/
+template<class Visitor>
+void
+FrozenSTRtree::visitIds(const Envelope& searchEnv, Visitor& visitId) const
+{
+    if(items.empty()) {
+        return;
+    }
+
+    std::vector<std::size_t> stack;
+    stack.push_back(0);
+    while(!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+
+        if(!node.env.intersects(searchEnv)) {
+            continue;
+        }
+
+        std::size_t end = node.childStart + node.childCount;
+        if(node.isLeaf) {
+            for(std::size_t id = node.childStart; id < end; ++id) {
+                if(itemEnvs[id].intersects(searchEnv)) {
+                    visitId(id);
+                }
+            }
+        }
+        else {
+            // push in reverse so that children are visited in order
+            for(std::size_t child = end; child > node.childStart; --child) {
+                stack.push_back(child - 1);
+            }
+        }
+    }
+}
+
+/*public*/
+void
+FrozenSTRtree::query(const Envelope& searchEnv, std::vector<void*>& matches) const
+{
+    auto collect = [this, &matches](std::size_t id) {
+        matches.push_back(items[id]);
+    };
+    visitIds(searchEnv, collect);
+}
+
+/*public*/
+void
+FrozenSTRtree::query(const Envelope& searchEnv, ItemVisitor& visitor) const
+{
+    auto visit = [this, &visitor](std::size_t id) {
+        visitor.visitItem(items[id]);
+    };
+    visitIds(searchEnv, visit);
+}
+
+/*public*/
+void
+FrozenSTRtree::queryIds(const Envelope& searchEnv, std::vector<std::size_t>& ids) const
+{
+    auto collect = [&ids](std::size_t id) {
+        ids.push_back(id);
+    };
+    visitIds(searchEnv, collect);
+}
+
+/*private*/
+void
+FrozenSTRtree::queryRange(const std::vector<Envelope>& searchEnvs,
+                          std::size_t start, std::size_t end,
+                          std::vector<std::size_t>& counts,
+                          std::vector<std::size_t>& ids) const
+{
+    for(std::size_t i = start; i < end; ++i) {
+        std::size_t before = ids.size();
+        queryIds(searchEnvs[i], ids);
+        counts[i] = ids.size() - before;
+    }
+}
+
+/*public*/
+void
+FrozenSTRtree::queryBatch(const std::vector<Envelope>& searchEnvs,
+                          std::vector<std::size_t>& offsets,
+                          std::vector<std::size_t>& ids,
+                          std::size_t numThreads) const
+{
+    std::size_t n = searchEnvs.size();
+    std::vector<std::size_t> counts(n);
+    ids.clear();
+
+    if(numThreads > n) {
+        numThreads = n;
+    }
+
+    if(numThreads <= 1) {
+        queryRange(searchEnvs, 0, n, counts, ids);
+    }
+    else {
+        // Each thread queries a contiguous chunk of the envelopes;
+        // chunk results are then concatenated in order.
+        std::size_t chunkSize = (n + numThreads - 1) / numThreads;
+        std::vector<std::vector<std::size_t>> chunkIds(numThreads);
+        std::vector<std::thread> workers;
+        for(std::size_t t = 1; t < numThreads; ++t) {
+            std::size_t start = t * chunkSize;
+            std::size_t end = std::min(n, start + chunkSize);
+            try {
+                workers.emplace_back([this, &searchEnvs, &counts, &chunkIds, t, start, end]() {
+                    queryRange(searchEnvs, start, end, counts, chunkIds[t]);
+                });
+            }
+            catch(const std::system_error&) {
+                // no more threads, query the chunk here
+                queryRange(searchEnvs, start, end, counts, chunkIds[t]);
+            }
+        }
+        queryRange(searchEnvs, 0, std::min(n, chunkSize), counts, chunkIds[0]);
+        for(std::thread& w : workers) {
+            w.join();
+        }
+
+        std::size_t total = 0;
+        for(const auto& c : chunkIds) {
+            total += c.size();
+        }
+        ids.reserve(total);
+        for(const auto& c : chunkIds) {
+            ids.insert(ids.end(), c.begin(), c.end());
+        }
+    }
+
+    offsets.resize(n + 1);
+    offsets[0] = 0;
+    for(std::size_t i = 0; i < n; ++i) {
+        offsets[i + 1] = offsets[i] + counts[i];
+    }
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
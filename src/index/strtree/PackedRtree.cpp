@@ -0,0 +1,336 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/PackedRtree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/IllegalStateException.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using geos::geom::Envelope;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+/**
+ * Returns the distance along a Hilbert curve of order 16 of
+ * the cell (x, y), with x and y in [0, 65535].
+ */
+std::uint64_t
+hilbertCode(std::uint32_t x, std::uint32_t y)
+{
+    const std::uint32_t n = 1u << 16;
+    std::uint64_t d = 0;
+    for(std::uint32_t s = n / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) ? 1 : 0;
+        std::uint32_t ry = (y & s) ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        // rotate the quadrant
+        if(ry == 0) {
+            if(rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Maps v from [min, min + range] to a cell index in [0, 65535]
+std::uint32_t
+toCell(double v, double min, double range)
+{
+    if(range <= 0) {
+        return 0;
+    }
+    double cell = std::floor((v - min) / range * 65535.0);
+    if(cell < 0) {
+        return 0;
+    }
+    if(cell > 65535.0) {
+        return 65535;
+    }
+    return static_cast<std::uint32_t>(cell);
+}
+
+} // anonymous namespace
+
+/*public*/
+PackedRtree::PackedRtree(std::size_t nodeCapacity_in, Packing packing_in)
+    : nodeCapacity(nodeCapacity_in),
+      packing(packing_in),
+      built(false)
+{
+    if(nodeCapacity < 2) {
+        throw util::IllegalArgumentException("PackedRtree node capacity must be at least 2");
+    }
+}
+
+/*public*/
+void
+PackedRtree::insert(const Envelope* itemEnv, void* item)
+{
+    if(built) {
+        throw util::IllegalStateException("Cannot insert items into a PackedRtree after it has been built");
+    }
+    if(itemEnv->isNull()) {
+        return;
+    }
+    items.push_back(item);
+    minX.push_back(itemEnv->getMinX());
+    minY.push_back(itemEnv->getMinY());
+    maxX.push_back(itemEnv->getMaxX());
+    maxY.push_back(itemEnv->getMaxY());
+}
+
+/*private*/
+std::vector<std::size_t>
+PackedRtree::sortItems() const
+{
+    std::size_t n = items.size();
+    std::vector<std::size_t> order(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        order[i] = i;
+    }
+
+    // twice the centres, which sorts the same way
+    std::vector<double> cx(n);
+    std::vector<double> cy(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        cx[i] = minX[i] + maxX[i];
+        cy[i] = minY[i] + maxY[i];
+    }
+
+    if(packing == HILBERT) {
+        Envelope extent;
+        for(std::size_t i = 0; i < n; ++i) {
+            extent.expandToInclude(cx[i], cy[i]);
+        }
+        std::vector<std::uint64_t> codes(n);
+        for(std::size_t i = 0; i < n; ++i) {
+            codes[i] = hilbertCode(
+                           toCell(cx[i], extent.getMinX(), extent.getWidth()),
+                           toCell(cy[i], extent.getMinY(), extent.getHeight()));
+        }
+        std::sort(order.begin(), order.end(), [&codes](std::size_t a, std::size_t b) {
+            return codes[a] < codes[b] || (codes[a] == codes[b] && a < b);
+        });
+        return order;
+    }
+
+    // Sort-Tile-Recursive: sort by X, cut into vertical slices of
+    // whole leaves, and sort each slice by Y
+    std::sort(order.begin(), order.end(), [&cx](std::size_t a, std::size_t b) {
+        return cx[a] < cx[b] || (cx[a] == cx[b] && a < b);
+    });
+
+    std::size_t numLeaves = (n + nodeCapacity - 1) / nodeCapacity;
+    std::size_t numSlices = static_cast<std::size_t>(
+                                std::ceil(std::sqrt(static_cast<double>(numLeaves))));
+    std::size_t sliceSize = nodeCapacity * ((numLeaves + numSlices - 1) / numSlices);
+    for(std::size_t start = 0; start < n; start += sliceSize) {
+        auto first = order.begin() + static_cast<std::ptrdiff_t>(start);
+        auto last = order.begin() + static_cast<std::ptrdiff_t>(std::min(n, start + sliceSize));
+        std::sort(first, last, [&cy](std::size_t a, std::size_t b) {
+            return cy[a] < cy[b] || (cy[a] == cy[b] && a < b);
+        });
+    }
+    return order;
+}
+
+/*private*/
+void
+PackedRtree::expandNode(std::size_t pos, std::size_t i)
+{
+    minX[pos] = std::min(minX[pos], minX[i]);
+    minY[pos] = std::min(minY[pos], minY[i]);
+    maxX[pos] = std::max(maxX[pos], maxX[i]);
+    maxY[pos] = std::max(maxY[pos], maxY[i]);
+}
+
+/*public*/
+void
+PackedRtree::build()
+{
+    if(built) {
+        return;
+    }
+    built = true;
+
+    std::size_t n = items.size();
+    if(n == 0) {
+        return;
+    }
+
+    // Reorder the leaf entries
+    std::vector<std::size_t> order = sortItems();
+    std::vector<double> sMinX(n), sMinY(n), sMaxX(n), sMaxY(n);
+    indices.resize(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        std::size_t k = order[i];
+        sMinX[i] = minX[k];
+        sMinY[i] = minY[k];
+        sMaxX[i] = maxX[k];
+        sMaxY[i] = maxY[k];
+        indices[i] = k;
+    }
+    // items keep their insertion order, to map ids back to items
+    minX.swap(sMinX);
+    minY.swap(sMinY);
+    maxX.swap(sMaxX);
+    maxY.swap(sMaxY);
+
+    // Total number of entries, so that the arrays are allocated once
+    std::size_t total = n;
+    for(std::size_t count = n; count > 1;) {
+        count = (count + nodeCapacity - 1) / nodeCapacity;
+        total += count;
+    }
+    minX.reserve(total);
+    minY.reserve(total);
+    maxX.reserve(total);
+    maxY.reserve(total);
+    indices.reserve(total);
+
+    levelEnds.push_back(n);
+    std::size_t levelStart = 0;
+    while(levelEnds.back() - levelStart > 1) {
+        std::size_t levelEnd = levelEnds.back();
+        for(std::size_t child = levelStart; child < levelEnd; child += nodeCapacity) {
+            std::size_t pos = minX.size();
+            minX.push_back(std::numeric_limits<double>::infinity());
+            minY.push_back(std::numeric_limits<double>::infinity());
+            maxX.push_back(-std::numeric_limits<double>::infinity());
+            maxY.push_back(-std::numeric_limits<double>::infinity());
+            indices.push_back(child);
+            std::size_t childEnd = std::min(levelEnd, child + nodeCapacity);
+            for(std::size_t i = child; i < childEnd; ++i) {
+                expandNode(pos, i);
+            }
+        }
+        levelStart = levelEnd;
+        levelEnds.push_back(minX.size());
+    }
+    assert(minX.size() == total);
+}
+
+/*private*/
+template<class Visitor>
+void
+PackedRtree::visitIds(const Envelope& searchEnv, Visitor& visitId) const
+{
+    if(!built) {
+        throw util::IllegalStateException("PackedRtree must be built before querying");
+    }
+    if(items.empty() || searchEnv.isNull()) {
+        return;
+    }
+
+    const double qMinX = searchEnv.getMinX();
+    const double qMinY = searchEnv.getMinY();
+    const double qMaxX = searchEnv.getMaxX();
+    const double qMaxY = searchEnv.getMaxY();
+    auto intersects = [&](std::size_t i) {
+        return !(minX[i] > qMaxX || maxX[i] < qMinX ||
+                 minY[i] > qMaxY || maxY[i] < qMinY);
+    };
+
+    std::size_t root = minX.size() - 1;
+    std::size_t rootLevel = levelEnds.size() - 1;
+    if(!intersects(root)) {
+        return;
+    }
+    if(rootLevel == 0) {
+        visitId(indices[root]);
+        return;
+    }
+
+    // (position, level) of the intersecting nodes left to visit
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.emplace_back(root, rootLevel);
+
+    while(!stack.empty()) {
+        std::size_t pos = stack.back().first;
+        std::size_t level = stack.back().second;
+        stack.pop_back();
+
+        std::size_t start = indices[pos];
+        std::size_t end = std::min(start + nodeCapacity, levelEnds[level - 1]);
+        for(std::size_t i = start; i < end; ++i) {
+            if(!intersects(i)) {
+                continue;
+            }
+            if(level == 1) {
+                visitId(indices[i]);
+            }
+            else {
+                stack.emplace_back(i, level - 1);
+            }
+        }
+    }
+}
+
+/*public*/
+void
+PackedRtree::query(const Envelope& searchEnv, std::vector<void*>& matches) const
+{
+    auto collect = [this, &matches](std::size_t id) {
+        matches.push_back(items[id]);
+    };
+    visitIds(searchEnv, collect);
+}
+
+/*public*/
+void
+PackedRtree::query(const Envelope& searchEnv, ItemVisitor& visitor) const
+{
+    auto visit = [this, &visitor](std::size_t id) {
+        visitor.visitItem(items[id]);
+    };
+    visitIds(searchEnv, visit);
+}
+
+/*public*/
+void
+PackedRtree::queryIds(const Envelope& searchEnv, std::vector<std::size_t>& ids) const
+{
+    auto collect = [&ids](std::size_t id) {
+        ids.push_back(id);
+    };
+    visitIds(searchEnv, collect);
+}
+
+/*public*/
+std::size_t
+PackedRtree::getMemoryUsage() const
+{
+    return items.capacity() * sizeof(void*)
+           + (minX.capacity() + minY.capacity() + maxX.capacity() + maxY.capacity()) * sizeof(double)
+           + indices.capacity() * sizeof(std::size_t)
+           + levelEnds.capacity() * sizeof(std::size_t);
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -27,6 +27,7 @@
 #include <algorithm> // std::sort
 #include <iostream> // for debugging
 #include <limits>
+#include <memory>
 #include <geos/util/GEOSException.h>
 
 using namespace std;
@@ -291,6 +292,92 @@ STRtree::nearestNeighbour(BoundablePair* initBndPair, double maxDistance)
     return std::pair<const void*, const void*>(item0, item1);
 }
 
+/*public*/
+std::vector<const void*>
+STRtree::kNearest(const Envelope* env, const void* item, std::size_t k,
+                  ItemDistance* itemDist)
+{
+    std::vector<const void*> result;
+    nearestItems(env, item, itemDist, k,
+                 std::numeric_limits<double>::infinity(), result);
+    return result;
+}
+
+/*public*/
+std::vector<const void*>
+STRtree::withinDistance(const Envelope* env, const void* item, double maxDistance,
+                        ItemDistance* itemDist)
+{
+    std::vector<const void*> result;
+    nearestItems(env, item, itemDist, std::numeric_limits<std::size_t>::max(),
+                 maxDistance, result);
+    return result;
+}
+
+/*private*/
+void
+STRtree::nearestItems(const Envelope* env, const void* item,
+                      ItemDistance* itemDist, std::size_t maxCount,
+                      double maxDistance, std::vector<const void*>& result)
+{
+    build();
+
+    if(maxCount == 0 || getRoot()->getChildBoundables()->empty()) {
+        return;
+    }
+
+    ItemBoundable bnd(env, const_cast<void*>(item));
+
+    // expandToQueue keeps pairs strictly closer than its bound
+    double expandBound = std::nextafter(maxDistance, std::numeric_limits<double>::infinity());
+
+    BoundablePair::BoundablePairQueue priQ;
+    priQ.push(new BoundablePair(getRoot(), &bnd, itemDist));
+
+    /**
+     * Pairs come out of the queue in order of increasing distance,
+     * and the distance of a node pair is a lower bound of the
+     * distance of the item pairs below it. So leaf pairs are
+     * found nearest first, and the search can stop as soon as
+     * enough of them are found or the queue holds only pairs
+     * farther than maxDistance.
+     */
+    try {
+        while(!priQ.empty()) {
+            std::unique_ptr<BoundablePair> bndPair(priQ.top());
+            priQ.pop();
+
+            if(bndPair->getDistance() > maxDistance) {
+                break;
+            }
+
+            if(bndPair->isLeaves()) {
+                const ItemBoundable* ib = static_cast<const ItemBoundable*>(bndPair->getBoundable(0));
+                result.push_back(ib->getItem());
+                if(result.size() == maxCount) {
+                    break;
+                }
+            }
+            else {
+                bndPair->expandToQueue(priQ, expandBound);
+            }
+        }
+    }
+    catch(...) {
+        while(!priQ.empty()) {
+            delete priQ.top();
+            priQ.pop();
+        }
+        throw;
+    }
+
+    /* Free any remaining BoundablePairs in the queue */
+    while(!priQ.empty()) {
+        delete priQ.top();
+        priQ.pop();
+    }
+}
+
 /*public*/
 bool
 STRtree::isWithinDistance(STRtree* tree, ItemDistance* itemDist, double maxDistance)
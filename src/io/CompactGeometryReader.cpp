@@ -0,0 +1,179 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/CompactGeometryReader.h>
+#include <geos/io/CompactGeometryView.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/PackedCoordinateSequenceFactory.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/PrecisionModel.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+CompactGeometryReader::CompactGeometryReader()
+    :
+    factory(*(GeometryFactory::getDefaultInstance()))
+{}
+
+std::unique_ptr<Geometry>
+CompactGeometryReader::read(const unsigned char* buf, std::size_t size) const
+{
+    if(reinterpret_cast<std::uintptr_t>(buf) % alignof(double) == 0) {
+        return read(CompactGeometryView(buf, size));
+    }
+
+    std::vector<double> aligned((size + sizeof(double) - 1) / sizeof(double));
+    if(size > 0) {
+        std::memcpy(aligned.data(), buf, size);
+    }
+    return read(CompactGeometryView(
+                    reinterpret_cast<const unsigned char*>(aligned.data()), size));
+}
+
+std::unique_ptr<Geometry>
+CompactGeometryReader::read(const CompactGeometryView& view) const
+{
+    std::unique_ptr<Geometry> g = readPart(view, 0);
+    g->setSRID(view.getSRID());
+    return g;
+}
+
+/* private */
+std::unique_ptr<Geometry>
+CompactGeometryReader::readPart(const CompactGeometryView& view, std::size_t part) const
+{
+    const CompactGeometryView::Part& p = view.getPart(part);
+
+    switch(view.getGeometryTypeId(part)) {
+    case GEOS_POINT:
+        if(p.count == 0) {
+            return std::unique_ptr<Geometry>(factory.createPoint());
+        }
+        return std::unique_ptr<Geometry>(factory.createPoint(readCoordinates(view, part).release()));
+    case GEOS_LINESTRING:
+        return factory.createLineString(readCoordinates(view, part));
+    case GEOS_LINEARRING:
+        return factory.createLinearRing(readCoordinates(view, part));
+    case GEOS_POLYGON: {
+        if(p.count == 0) {
+            return std::unique_ptr<Geometry>(factory.createPolygon());
+        }
+        std::size_t child = part + 1;
+        std::unique_ptr<Geometry> shell = readPart(view, child);
+        std::unique_ptr<std::vector<Geometry*>> holes(new std::vector<Geometry*>());
+        holes->reserve(p.count - 1);
+        try {
+            for(std::uint32_t i = 1; i < p.count; ++i) {
+                child += view.getPart(child).extent;
+                holes->push_back(readPart(view, child).release());
+            }
+        }
+        catch(...) {
+            for(Geometry* hole : *holes) {
+                delete hole;
+            }
+            throw;
+        }
+        return std::unique_ptr<Geometry>(factory.createPolygon(
+                                             dynamic_cast<LinearRing*>(shell.release()), holes.release()));
+    }
+    default:
+        break;
+    }
+
+    std::unique_ptr<std::vector<Geometry*>> geoms(new std::vector<Geometry*>());
+    geoms->reserve(p.count);
+    try {
+        std::size_t child = part + 1;
+        for(std::uint32_t i = 0; i < p.count; ++i) {
+            geoms->push_back(readPart(view, child).release());
+            child += view.getPart(child).extent;
+        }
+    }
+    catch(...) {
+        for(Geometry* g : *geoms) {
+            delete g;
+        }
+        throw;
+    }
+
+    switch(view.getGeometryTypeId(part)) {
+    case GEOS_MULTIPOINT:
+        return std::unique_ptr<Geometry>(factory.createMultiPoint(geoms.release()));
+    case GEOS_MULTILINESTRING:
+        return std::unique_ptr<Geometry>(factory.createMultiLineString(geoms.release()));
+    case GEOS_MULTIPOLYGON:
+        return std::unique_ptr<Geometry>(factory.createMultiPolygon(geoms.release()));
+    default:
+        return std::unique_ptr<Geometry>(factory.createGeometryCollection(geoms.release()));
+    }
+}
+
+/* private */
+std::unique_ptr<CoordinateSequence>
+CompactGeometryReader::readCoordinates(const CompactGeometryView& view, std::size_t part) const
+{
+    const std::size_t size = view.getPart(part).count;
+    const std::size_t dimension = view.getDimension();
+    const double* ords = view.getCoordinates(part);
+    const PrecisionModel& pm = *factory.getPrecisionModel();
+    const CoordinateSequenceFactory* csf = factory.getCoordinateSequenceFactory();
+
+    if(pm.isFloating() && dynamic_cast<const PackedCoordinateSequenceFactory*>(csf)) {
+        std::vector<double> packed(ords, ords + size * dimension);
+        return std::unique_ptr<CoordinateSequence>(
+                   new PackedCoordinateSequence(std::move(packed), dimension));
+    }
+
+    std::unique_ptr<std::vector<Coordinate>> coords(new std::vector<Coordinate>(size));
+    if(dimension == 3) {
+        if(size > 0) {
+            std::memcpy(&(*coords)[0].x, ords, size * 3 * sizeof(double));
+        }
+    }
+    else {
+        for(std::size_t i = 0; i < size; ++i) {
+            (*coords)[i].x = ords[2 * i];
+            (*coords)[i].y = ords[2 * i + 1];
+        }
+    }
+
+    if(!pm.isFloating()) {
+        for(Coordinate& c : *coords) {
+            c.x = pm.makePrecise(c.x);
+            c.y = pm.makePrecise(c.y);
+        }
+    }
+
+    return csf->create(coords.release(), dimension);
+}
+
+} // namespace geos.io
+} // namespace geos
@@ -0,0 +1,162 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/CompactGeometryView.h>
+#include <geos/io/ParseException.h>
+#include <geos/util/Machine.h>
+
+#include <cstring>
+
+using geos::geom::Envelope;
+
+namespace geos {
+namespace io { // geos.io
+
+static_assert(sizeof(CompactGeometryView::Header) == 64,
+              "unexpected padding in CompactGeometryView::Header");
+static_assert(sizeof(CompactGeometryView::Part) == 24,
+              "unexpected padding in CompactGeometryView::Part");
+
+const char CompactGeometryView::MAGIC[4] = { 'G', 'C', 'G', '1' };
+
+CompactGeometryView::CompactGeometryView(const unsigned char* data, std::size_t size)
+{
+    if(reinterpret_cast<std::uintptr_t>(data) % alignof(double)) {
+        throw ParseException("Compact geometry record is not 8-byte aligned");
+    }
+    if(size < sizeof(Header)) {
+        throw ParseException("Premature end of compact geometry header");
+    }
+
+    header = reinterpret_cast<const Header*>(data);
+    if(std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw ParseException("Not a compact geometry record");
+    }
+    if(header->byteOrder != getMachineByteOrder()) {
+        throw ParseException("Compact geometry record written with a different byte order");
+    }
+    if(header->dimension != 2 && header->dimension != 3) {
+        throw ParseException("Invalid compact geometry dimension", header->dimension);
+    }
+
+    // the counts come from the file, check them without overflowing
+    const std::uint64_t partsSize = std::uint64_t(header->numParts) * sizeof(Part);
+    const std::uint64_t maxCoords = (size - sizeof(Header)) / (header->dimension * sizeof(double));
+    if(header->numParts == 0 || header->numCoords > maxCoords ||
+            header->size != sizeof(Header) + partsSize
+            + header->numCoords * header->dimension * sizeof(double)) {
+        throw ParseException("Invalid compact geometry record size");
+    }
+    if(header->size > size) {
+        throw ParseException("Premature end of compact geometry record");
+    }
+
+    parts = reinterpret_cast<const Part*>(data + sizeof(Header));
+    coords = reinterpret_cast<const double*>(data + sizeof(Header) + partsSize);
+
+    if(parts[0].extent != header->numParts ||
+            checkPart(0, 0) != header->numCoords) {
+        throw ParseException("Invalid compact geometry part table");
+    }
+}
+
+Envelope
+CompactGeometryView::getEnvelope() const
+{
+    if(header->numCoords == 0) {
+        return Envelope();
+    }
+    return Envelope(header->minx, header->maxx, header->miny, header->maxy);
+}
+
+std::size_t
+CompactGeometryView::getChild(std::size_t part, std::size_t n) const
+{
+    std::size_t child = part + 1;
+    for(std::size_t i = 0; i < n; ++i) {
+        child += parts[child].extent;
+    }
+    return child;
+}
+
+/* private */
+std::uint64_t
+CompactGeometryView::checkPart(std::size_t i, std::uint64_t start) const
+{
+    const Part& p = parts[i];
+    if(p.extent == 0 || p.extent > header->numParts - i || p.coordStart != start) {
+        throw ParseException("Invalid compact geometry part", double(i));
+    }
+
+    switch(p.type) {
+    case geom::GEOS_POINT:
+    case geom::GEOS_LINESTRING:
+    case geom::GEOS_LINEARRING:
+        if(p.extent != 1 || (p.type == geom::GEOS_POINT && p.count > 1) ||
+                p.count > header->numCoords - start) {
+            throw ParseException("Invalid compact geometry part", double(i));
+        }
+        return p.count;
+    case geom::GEOS_POLYGON:
+    case geom::GEOS_MULTIPOINT:
+    case geom::GEOS_MULTILINESTRING:
+    case geom::GEOS_MULTIPOLYGON:
+    case geom::GEOS_GEOMETRYCOLLECTION:
+        break;
+    default:
+        throw ParseException("Invalid compact geometry type", double(p.type));
+    }
+
+    // element type required by the container, if any
+    int childType = -1;
+    switch(p.type) {
+    case geom::GEOS_POLYGON:
+        childType = geom::GEOS_LINEARRING;
+        break;
+    case geom::GEOS_MULTIPOINT:
+        childType = geom::GEOS_POINT;
+        break;
+    case geom::GEOS_MULTILINESTRING:
+        childType = geom::GEOS_LINESTRING;
+        break;
+    case geom::GEOS_MULTIPOLYGON:
+        childType = geom::GEOS_POLYGON;
+        break;
+    default:
+        break;
+    }
+
+    std::uint64_t numCoords = 0;
+    std::size_t child = i + 1;
+    for(std::uint32_t n = 0; n < p.count; ++n) {
+        if(child >= i + p.extent) {
+            throw ParseException("Invalid compact geometry part", double(i));
+        }
+        std::uint32_t type = parts[child].type;
+        // a LinearRing is a LineString
+        if(type == geom::GEOS_LINEARRING && childType == geom::GEOS_LINESTRING) {
+            type = geom::GEOS_LINESTRING;
+        }
+        if(childType >= 0 && type != std::uint32_t(childType)) {
+            throw ParseException("Invalid compact geometry part", double(i));
+        }
+        numCoords += checkPart(child, start + numCoords);
+        child += parts[child].extent;
+    }
+    if(child != i + p.extent) {
+        throw ParseException("Invalid compact geometry part", double(i));
+    }
+    return numCoords;
+}
+
+} // namespace geos.io
+} // namespace geos
@@ -0,0 +1,230 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/CompactGeometryWriter.h>
+#include <geos/io/CompactGeometryView.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Polygon.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/Machine.h>
+
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace io { // geos.io
+
+typedef CompactGeometryView::Header Header;
+typedef CompactGeometryView::Part Part;
+
+namespace {
+
+/// Returns the coordinates of a Point or LineString, null for other types
+const CoordinateSequence*
+leafCoordinates(const Geometry& g)
+{
+    switch(g.getGeometryTypeId()) {
+    case GEOS_POINT:
+        return dynamic_cast<const Point&>(g).getCoordinatesRO();
+    case GEOS_LINESTRING:
+    case GEOS_LINEARRING:
+        return dynamic_cast<const LineString&>(g).getCoordinatesRO();
+    default:
+        return nullptr;
+    }
+}
+
+void
+writePart(unsigned char*& out, GeometryTypeId type, std::size_t count,
+          std::size_t extent, std::uint64_t coordStart)
+{
+    Part p;
+    p.type = static_cast<std::uint32_t>(type);
+    p.count = static_cast<std::uint32_t>(count);
+    p.extent = static_cast<std::uint32_t>(extent);
+    p.reserved = 0;
+    p.coordStart = coordStart;
+    std::memcpy(out, &p, sizeof(Part));
+    out += sizeof(Part);
+}
+
+} // anonymous namespace
+
+/* private static */
+void
+CompactGeometryWriter::count(const Geometry& g, Counts& counts)
+{
+    ++counts.numParts;
+    if(const CoordinateSequence* cs = leafCoordinates(g)) {
+        counts.numCoords += cs->getSize();
+        return;
+    }
+
+    if(g.getGeometryTypeId() == GEOS_POLYGON) {
+        const Polygon& poly = dynamic_cast<const Polygon&>(g);
+        if(poly.isEmpty()) {
+            return;
+        }
+        count(*poly.getExteriorRing(), counts);
+        for(std::size_t i = 0, n = poly.getNumInteriorRing(); i < n; ++i) {
+            count(*poly.getInteriorRingN(i), counts);
+        }
+        return;
+    }
+
+    for(std::size_t i = 0, n = g.getNumGeometries(); i < n; ++i) {
+        count(*g.getGeometryN(i), counts);
+    }
+}
+
+std::size_t
+CompactGeometryWriter::getSize(const Geometry& g) const
+{
+    Counts counts = { 0, 0 };
+    count(g, counts);
+    std::size_t dimension = g.getCoordinateDimension() == 3 ? 3 : 2;
+    return sizeof(Header) + counts.numParts * sizeof(Part)
+           + counts.numCoords * dimension * sizeof(double);
+}
+
+std::size_t
+CompactGeometryWriter::write(const Geometry& g, unsigned char* buf,
+                             std::size_t bufSize) const
+{
+    Counts counts = { 0, 0 };
+    count(g, counts);
+    std::size_t dimension = g.getCoordinateDimension() == 3 ? 3 : 2;
+    std::size_t size = sizeof(Header) + counts.numParts * sizeof(Part)
+                       + counts.numCoords * dimension * sizeof(double);
+    if(bufSize < size) {
+        throw util::IllegalArgumentException("CompactGeometryWriter: buffer too small");
+    }
+
+    Header h;
+    std::memcpy(h.magic, CompactGeometryView::MAGIC, sizeof(h.magic));
+    h.byteOrder = static_cast<std::uint8_t>(getMachineByteOrder());
+    h.dimension = static_cast<std::uint8_t>(dimension);
+    h.reserved = 0;
+    h.srid = g.getSRID();
+    h.numParts = static_cast<std::uint32_t>(counts.numParts);
+    h.numCoords = counts.numCoords;
+    h.size = size;
+    const Envelope* env = g.getEnvelopeInternal();
+    if(env->isNull()) {
+        h.minx = h.miny = h.maxx = h.maxy = 0.0;
+    }
+    else {
+        h.minx = env->getMinX();
+        h.miny = env->getMinY();
+        h.maxx = env->getMaxX();
+        h.maxy = env->getMaxY();
+    }
+    std::memcpy(buf, &h, sizeof(Header));
+
+    unsigned char* partOut = buf + sizeof(Header);
+    unsigned char* coordOut = partOut + counts.numParts * sizeof(Part);
+    std::uint64_t coordIndex = 0;
+    writeGeometry(g, dimension, partOut, coordOut, coordIndex);
+
+    return size;
+}
+
+void
+CompactGeometryWriter::write(const Geometry& g, std::ostream& os) const
+{
+    std::vector<unsigned char> buf(getSize(g));
+    write(g, buf.data(), buf.size());
+    os.write(reinterpret_cast<const char*>(buf.data()),
+             static_cast<std::streamsize>(buf.size()));
+}
+
+/* private static */
+void
+CompactGeometryWriter::writeGeometry(const Geometry& g, std::size_t dimension,
+                                     unsigned char*& partOut, unsigned char*& coordOut,
+                                     std::uint64_t& coordIndex)
+{
+    GeometryTypeId type = g.getGeometryTypeId();
+
+    if(const CoordinateSequence* cs = leafCoordinates(g)) {
+        writePart(partOut, type, cs->getSize(), 1, coordIndex);
+        writeCoordinates(*cs, dimension, coordOut);
+        coordIndex += cs->getSize();
+        return;
+    }
+
+    // the extent of a subtree is only known once it has been written
+    unsigned char* partStart = partOut;
+    std::uint64_t coordStart = coordIndex;
+    std::size_t numChildren = 0;
+    partOut += sizeof(Part);
+
+    if(type == GEOS_POLYGON) {
+        const Polygon& poly = dynamic_cast<const Polygon&>(g);
+        if(!poly.isEmpty()) {
+            numChildren = 1 + poly.getNumInteriorRing();
+            writeGeometry(*poly.getExteriorRing(), dimension, partOut, coordOut, coordIndex);
+            for(std::size_t i = 0; i + 1 < numChildren; ++i) {
+                writeGeometry(*poly.getInteriorRingN(i), dimension, partOut, coordOut, coordIndex);
+            }
+        }
+    }
+    else {
+        numChildren = g.getNumGeometries();
+        for(std::size_t i = 0; i < numChildren; ++i) {
+            writeGeometry(*g.getGeometryN(i), dimension, partOut, coordOut, coordIndex);
+        }
+    }
+
+    std::size_t extent = static_cast<std::size_t>(partOut - partStart) / sizeof(Part);
+    writePart(partStart, type, numChildren, extent, coordStart);
+}
+
+/* private static */
+void
+CompactGeometryWriter::writeCoordinates(const CoordinateSequence& cs,
+                                        std::size_t dimension, unsigned char*& coordOut)
+{
+    std::size_t size = cs.getSize();
+    const std::size_t coordBytes = dimension * sizeof(double);
+
+    const PackedCoordinateSequence* packed =
+        dynamic_cast<const PackedCoordinateSequence*>(&cs);
+    if(packed && packed->stride() == dimension) {
+        if(size > 0) {
+            std::memcpy(coordOut, packed->data(), size * coordBytes);
+        }
+        coordOut += size * coordBytes;
+        return;
+    }
+
+    static_assert(sizeof(Coordinate) == 3 * sizeof(double),
+                  "Coordinate is expected to be three packed doubles");
+    Coordinate c;
+    for(std::size_t i = 0; i < size; ++i) {
+        cs.getAt(i, c);
+        std::memcpy(coordOut, &c, coordBytes);
+        coordOut += coordBytes;
+    }
+}
+
+} // namespace geos.io
+} // namespace geos
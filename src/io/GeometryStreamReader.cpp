@@ -0,0 +1,272 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/io/GeometryStreamReader.h>
+#include <geos/io/ByteOrderValues.h>
+#include <geos/io/ParseException.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/util/GEOSException.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <system_error>
+#include <thread>
+
+using geos::geom::Geometry;
+
+namespace geos {
+namespace io { // geos.io
+
+namespace {
+
+/// Size of the length prefix of WKB records
+const std::size_t WKB_PREFIX_SIZE = 4;
+
+bool
+isBlank(unsigned char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string
+recordName(std::size_t recordNumber)
+{
+    return "Record " + std::to_string(recordNumber);
+}
+
+} // anonymous namespace
+
+GeometryStreamReader::GeometryStreamReader(const geom::GeometryFactory& p_factory,
+        Format p_format)
+    :
+    factory(p_factory),
+    format(p_format),
+    data(nullptr),
+    size(0),
+    pos(0),
+    complete(false),
+    recordCount(0),
+    wkbReader(p_factory),
+    wktReader(p_factory)
+{}
+
+GeometryStreamReader::~GeometryStreamReader() {}
+
+void
+GeometryStreamReader::setInput(const unsigned char* p_data, std::size_t p_size)
+{
+    buffer.clear();
+    data = p_data;
+    size = p_size;
+    pos = 0;
+    complete = true;
+}
+
+void
+GeometryStreamReader::addChunk(const unsigned char* p_data, std::size_t p_size)
+{
+    if(complete) {
+        throw util::GEOSException("GeometryStreamReader: input already complete");
+    }
+
+    // drop the consumed bytes before growing the buffer, so that it
+    // only ever holds the unread records
+    if(pos > 0) {
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+        pos = 0;
+    }
+    buffer.insert(buffer.end(), p_data, p_data + p_size);
+    data = buffer.data();
+    size = buffer.size();
+}
+
+void
+GeometryStreamReader::finish()
+{
+    complete = true;
+}
+
+/* private */
+bool
+GeometryStreamReader::nextRecord(Record& rec)
+{
+    if(format == WKB) {
+        if(size - pos < WKB_PREFIX_SIZE) {
+            if(complete && pos < size) {
+                throw ParseException(recordName(recordCount + 1),
+                                     "Premature end of length prefix");
+            }
+            return false;
+        }
+        std::size_t recSize = static_cast<uint32_t>(
+                                  ByteOrderValues::getInt(data + pos, ByteOrderValues::ENDIAN_LITTLE));
+        if(size - pos - WKB_PREFIX_SIZE < recSize) {
+            if(complete) {
+                throw ParseException(recordName(recordCount + 1),
+                                     "Premature end of WKB record");
+            }
+            return false;
+        }
+        rec.data = data + pos + WKB_PREFIX_SIZE;
+        rec.size = recSize;
+        pos += WKB_PREFIX_SIZE + recSize;
+        return true;
+    }
+
+    // line based formats
+    while(pos < size) {
+        const unsigned char* start = data + pos;
+        const unsigned char* nl = static_cast<const unsigned char*>(
+                                      std::memchr(start, '\n', size - pos));
+        const unsigned char* end;
+        if(nl) {
+            end = nl;
+            pos = static_cast<std::size_t>(nl - data) + 1;
+        }
+        else if(complete) {
+            // last line without a line end
+            end = data + size;
+            pos = size;
+        }
+        else {
+            return false;
+        }
+
+        while(start < end && isBlank(*start)) {
+            ++start;
+        }
+        while(end > start && isBlank(*(end - 1))) {
+            --end;
+        }
+        if(start < end) {
+            rec.data = start;
+            rec.size = static_cast<std::size_t>(end - start);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* private */
+std::unique_ptr<Geometry>
+GeometryStreamReader::decode(const Record& rec, WKBReader& p_wkbReader,
+                             WKTReader& p_wktReader) const
+{
+    switch(format) {
+    case WKB:
+        return std::unique_ptr<Geometry>(p_wkbReader.read(rec.data, rec.size));
+    case HEXWKB:
+        return std::unique_ptr<Geometry>(p_wkbReader.readHEX(
+                                             reinterpret_cast<const char*>(rec.data), rec.size));
+    case WKT:
+    default:
+        return std::unique_ptr<Geometry>(p_wktReader.read(
+                                             reinterpret_cast<const char*>(rec.data), rec.size));
+    }
+}
+
+std::unique_ptr<Geometry>
+GeometryStreamReader::next()
+{
+    Record rec;
+    if(!nextRecord(rec)) {
+        return nullptr;
+    }
+    std::size_t recordNumber = ++recordCount;
+    try {
+        return decode(rec, wkbReader, wktReader);
+    }
+    catch(const util::GEOSException& e) {
+        throw ParseException(recordName(recordNumber), e.what());
+    }
+}
+
+std::size_t
+GeometryStreamReader::nextBatch(std::vector<std::unique_ptr<Geometry>>& out,
+                                std::size_t maxCount, unsigned int numThreads)
+{
+    // framing is sequential, only the decoding is spread over threads
+    std::vector<Record> records;
+    Record rec;
+    while(records.size() < maxCount && nextRecord(rec)) {
+        records.push_back(rec);
+    }
+
+    const std::size_t n = records.size();
+    const std::size_t firstRecord = recordCount + 1;
+    recordCount += n;
+
+    std::vector<std::unique_ptr<Geometry>> geoms(n);
+    std::vector<std::exception_ptr> errors(n);
+
+    auto decodeSlice = [&](std::size_t begin, std::size_t end,
+                           WKBReader & p_wkbReader, WKTReader & p_wktReader) {
+        for(std::size_t i = begin; i < end; ++i) {
+            try {
+                geoms[i] = decode(records[i], p_wkbReader, p_wktReader);
+            }
+            catch(...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    // Arena allocation is not thread-safe
+    if(factory.getArena()) {
+        numThreads = 1;
+    }
+    std::size_t nslices = std::max<std::size_t>(1, std::min<std::size_t>(numThreads, n));
+    std::vector<std::thread> workers;
+    std::size_t begin = 0;
+    // slices are contiguous, the last one is decoded on the calling thread
+    for(std::size_t s = 0; s + 1 < nslices; ++s) {
+        std::size_t end = begin + (n - begin) / (nslices - s);
+        try {
+            workers.emplace_back([this, &decodeSlice, begin, end]() {
+                WKBReader threadWkbReader(factory);
+                WKTReader threadWktReader(factory);
+                decodeSlice(begin, end, threadWkbReader, threadWktReader);
+            });
+        }
+        catch(const std::system_error&) {
+            decodeSlice(begin, end, wkbReader, wktReader);
+        }
+        begin = end;
+    }
+    decodeSlice(begin, n, wkbReader, wktReader);
+
+    for(std::thread& t : workers) {
+        t.join();
+    }
+
+    for(std::size_t i = 0; i < n; ++i) {
+        if(errors[i]) {
+            try {
+                std::rethrow_exception(errors[i]);
+            }
+            catch(const util::GEOSException& e) {
+                throw ParseException(recordName(firstRecord + i), e.what());
+            }
+        }
+    }
+
+    for(std::unique_ptr<Geometry>& g : geoms) {
+        out.push_back(std::move(g));
+    }
+    return n;
+}
+
+} // namespace geos.io
+} // namespace geos
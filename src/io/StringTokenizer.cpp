@@ -19,25 +19,19 @@
 
 #include <geos/io/StringTokenizer.h>
 
-#include <string>
+#include <clocale>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <string>
+#include <vector>
 
 using namespace std;
 
 namespace geos {
 namespace io { // geos.io
 
-/*public*/
-StringTokenizer::StringTokenizer(const string& txt)
-    :
-    str(txt),
-    stok(""),
-    ntok(0.0)
-{
-    iter = str.begin();
-}
-
 double
 strtod_with_vc_fix(const char* str, char** str_end)
 {
@@ -74,128 +68,510 @@ strtod_with_vc_fix(const char* str, char** str_end)
     return dbl;
 }
 
-/*public*/
-int
-StringTokenizer::nextToken()
+namespace {
+
+inline bool
+isSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline bool
+isDelimiter(char c)
 {
-    string tok = "";
-    if(iter == str.end()) {
-        return StringTokenizer::TT_EOF;
+    return isSpace(c) || c == '(' || c == ')' || c == ',';
+}
+
+// Powers of ten exactly representable as doubles
+const double exactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int smallestPowerOfFive = -342;
+const int largestPowerOfFive = 308;
+
+/*
+ * 128-bit approximations of 5^q for q in [-342, 308], normalized so
+ * that the most significant bit is set, as used by the Eisel-Lemire
+ * algorithm. Positive powers are truncated, negative ones are
+ * 2^b / 5^-q rounded up. Computed once with a minimal big integer
+ * rather than stored as a 1300 entry literal table.
+ */
+class PowersOfFive {
+public:
+    PowersOfFive()
+    {
+        for(int q = smallestPowerOfFive; q <= largestPowerOfFive; ++q) {
+            Big c;
+            if(q >= 0) {
+                c.limbs.push_back(1);
+                for(int i = 0; i < q; ++i) {
+                    c.mulSmall(5);
+                }
+            }
+            else {
+                Big power5;
+                power5.limbs.push_back(1);
+                for(int i = 0; i < -q; ++i) {
+                    power5.mulSmall(5);
+                }
+                int z = power5.bitLength(); // 5^-q < 2^z
+                int b = (q >= -27) ? z + 127 : 2 * z + 128;
+                c.setPowerOfTwo(b);
+                for(int i = 0; i < -q; ++i) {
+                    c.divSmall(5);
+                }
+                c.addOne();
+            }
+            int shift = c.bitLength() - 128;
+            std::size_t k = static_cast<std::size_t>(q - smallestPowerOfFive);
+            hi[k] = c.bits(shift + 64);
+            lo[k] = c.bits(shift);
+        }
     }
-    switch(*iter) {
-    case '(':
-    case ')':
-    case ',':
-        return *iter++;
-    case '\n':
-    case '\r':
-    case '\t':
-    case ' ':
-        string::size_type pos = str.find_first_not_of(" \n\r\t",
-                                iter - str.begin());
-        if(pos == string::npos) {
-            return StringTokenizer::TT_EOF;
+
+    uint64_t hi[largestPowerOfFive - smallestPowerOfFive + 1];
+    uint64_t lo[largestPowerOfFive - smallestPowerOfFive + 1];
+
+private:
+    struct Big {
+        std::vector<uint32_t> limbs; // little endian
+
+        void mulSmall(uint32_t m)
+        {
+            uint64_t carry = 0;
+            for(uint32_t& l : limbs) {
+                uint64_t v = static_cast<uint64_t>(l) * m + carry;
+                l = static_cast<uint32_t>(v);
+                carry = v >> 32;
+            }
+            if(carry) {
+                limbs.push_back(static_cast<uint32_t>(carry));
+            }
+        }
+
+        void divSmall(uint32_t d)
+        {
+            uint64_t rem = 0;
+            for(std::size_t i = limbs.size(); i-- > 0;) {
+                uint64_t v = (rem << 32) | limbs[i];
+                limbs[i] = static_cast<uint32_t>(v / d);
+                rem = v % d;
+            }
+            while(!limbs.empty() && limbs.back() == 0) {
+                limbs.pop_back();
+            }
+        }
+
+        void addOne()
+        {
+            for(uint32_t& l : limbs) {
+                if(++l != 0) {
+                    return;
+                }
+            }
+            limbs.push_back(1);
+        }
+
+        void setPowerOfTwo(int e)
+        {
+            limbs.assign(static_cast<std::size_t>(e / 32) + 1, 0);
+            limbs.back() = uint32_t(1) << (e % 32);
+        }
+
+        int bitLength() const
+        {
+            if(limbs.empty()) {
+                return 0;
+            }
+            int n = static_cast<int>(limbs.size() - 1) * 32;
+            for(uint32_t top = limbs.back(); top; top >>= 1) {
+                ++n;
+            }
+            return n;
         }
-        else {
-            iter = str.begin() + pos;
-            return nextToken();
+
+        // The 64 bits starting at bit position from (bits below 0 are 0)
+        uint64_t bits(int from) const
+        {
+            uint64_t r = 0;
+            for(int i = 63; i >= 0; --i) {
+                int pos = from + i;
+                uint64_t bit = 0;
+                if(pos >= 0 && static_cast<std::size_t>(pos / 32) < limbs.size()) {
+                    bit = (limbs[static_cast<std::size_t>(pos / 32)] >> (pos % 32)) & 1;
+                }
+                r = (r << 1) | bit;
+            }
+            return r;
         }
+    };
+};
+
+const PowersOfFive&
+powersOfFive()
+{
+    static const PowersOfFive table;
+    return table;
+}
+
+// Full 64x64 -> 128 bit product
+inline void
+multiply128(uint64_t a, uint64_t b, uint64_t& high, uint64_t& low)
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    uint128 r = static_cast<uint128>(a) * b;
+    high = static_cast<uint64_t>(r >> 64);
+    low = static_cast<uint64_t>(r);
+#else
+    uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+    uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+    uint64_t ll = aLo * bLo;
+    uint64_t lh = aLo * bHi;
+    uint64_t hl = aHi * bLo;
+    uint64_t hh = aHi * bHi;
+    uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+    high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    low = (mid << 32) | (ll & 0xFFFFFFFF);
+#endif
+}
+
+/*
+ * Eisel-Lemire conversion of w * 10^q to the nearest double.
+ * Returns false in the rare cases where the 128-bit approximation
+ * cannot decide the rounding; the caller must then fall back to an
+ * exact conversion.
+ */
+bool
+eiselLemire(uint64_t w, int q, bool negative, double& result)
+{
+    if(q < smallestPowerOfFive || q > largestPowerOfFive) {
+        return false;
+    }
+    const PowersOfFive& table = powersOfFive();
+    std::size_t k = static_cast<std::size_t>(q - smallestPowerOfFive);
+
+    int lz = 0;
+    while(!(w & (uint64_t(1) << 63))) {
+        w <<= 1;
+        ++lz;
     }
-    string::size_type pos = str.find_first_of("\n\r\t() ,",
-                            iter - str.begin());
-    if(pos == string::npos) {
-        if(iter != str.end()) {
-            tok.assign(iter, str.end());
-            iter = str.end();
+
+    uint64_t upper, lower;
+    multiply128(w, table.hi[k], upper, lower);
+    if((upper & 0x1FF) == 0x1FF && lower + w < lower) {
+        uint64_t secondHigh, secondLow;
+        multiply128(w, table.lo[k], secondHigh, secondLow);
+        uint64_t middle = lower + secondHigh;
+        if(middle < lower) {
+            ++upper;
         }
-        else {
-            return StringTokenizer::TT_EOF;
+        if(middle + 1 == 0 && (upper & 0x1FF) == 0x1FF &&
+                secondLow + w < secondLow) {
+            return false;
         }
+        lower = middle;
     }
-    else {
-        tok.assign(iter, str.begin() + pos);
-        iter = str.begin() + pos;
+
+    uint64_t upperBit = upper >> 63;
+    uint64_t mantissa = upper >> (upperBit + 9);
+    lz += static_cast<int>(1 ^ upperBit);
+
+    // Exactly halfway between two doubles: let the caller decide
+    if(lower == 0 && (upper & 0x1FF) == 0 && (mantissa & 3) == 1) {
+        return false;
     }
-    char* stopstring;
-    double dbl = strtod_with_vc_fix(tok.c_str(), &stopstring);
-    if(*stopstring == '\0') {
-        ntok = dbl;
-        stok = "";
-        return StringTokenizer::TT_NUMBER;
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if(mantissa >= (uint64_t(1) << 53)) {
+        mantissa = uint64_t(1) << 52;
+        --lz;
     }
-    else {
-        ntok = 0.0;
-        stok = tok;
-        return StringTokenizer::TT_WORD;
+    mantissa &= ~(uint64_t(1) << 52);
+
+    // floor(log2(10^q)) + 1 + 1023 + 63
+    int64_t exponent = ((217706 * static_cast<int64_t>(q)) >> 16) + 1024 + 63 - lz;
+    if(exponent < 1 || exponent > 2046) {
+        return false;    // subnormal or overflow
     }
+
+    uint64_t bits = mantissa | (static_cast<uint64_t>(exponent) << 52);
+    if(negative) {
+        bits |= uint64_t(1) << 63;
+    }
+    memcpy(&result, &bits, sizeof(result));
+    return true;
 }
 
-/*public*/
-int
-StringTokenizer::peekNextToken()
+/*
+ * Parses a plain decimal number (optional sign, digits, optional
+ * fraction and exponent) filling the whole [p, end) range.
+ *
+ * Numbers whose significand and power of ten are both exactly
+ * representable are converted with a single multiplication or
+ * division (Clinger's fast path), the others with the Eisel-Lemire
+ * algorithm. Returns false when neither applies (more than 19
+ * significant digits, subnormals, unusual syntax) and the slow path
+ * has to be used.
+ */
+bool
+parseDecimalFast(const char* p, const char* end, double& result)
 {
+    bool negative = false;
+    if(p != end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
 
-    string::size_type pos;
-    string tok = "";
-    if(iter == str.end()) {
-        return StringTokenizer::TT_EOF;
+    uint64_t significand = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+
+    for(; p != end && *p >= '0' && *p <= '9'; ++p) {
+        anyDigit = true;
+        if(significand == 0 && *p == '0') {
+            continue;    // leading zero
+        }
+        if(++significantDigits > 19) {
+            return false;
+        }
+        significand = significand * 10 + static_cast<uint64_t>(*p - '0');
+    }
+    if(p != end && *p == '.') {
+        for(++p; p != end && *p >= '0' && *p <= '9'; ++p) {
+            anyDigit = true;
+            --exponent;
+            if(significand == 0 && *p == '0') {
+                continue;
+            }
+            if(++significantDigits > 19) {
+                return false;
+            }
+            significand = significand * 10 + static_cast<uint64_t>(*p - '0');
+        }
+    }
+    if(!anyDigit) {
+        return false;
+    }
+    if(p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExp = false;
+        if(p != end && (*p == '-' || *p == '+')) {
+            negativeExp = (*p == '-');
+            ++p;
+        }
+        if(p == end || *p < '0' || *p > '9') {
+            return false;
+        }
+        int e = 0;
+        for(; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if(e < 10000) {
+                e = e * 10 + (*p - '0');
+            }
+        }
+        exponent += negativeExp ? -e : e;
+    }
+    if(p != end) {
+        return false;
     }
 
-    pos = str.find_first_not_of(" \r\n\t", iter - str.begin());
+    if(significand == 0) {
+        result = negative ? -0.0 : 0.0;
+        return true;
+    }
 
-    if(pos == string::npos) {
-        return StringTokenizer::TT_EOF;
+    const uint64_t maxExactInt = uint64_t(1) << 53;
+    uint64_t clingerSignificand = significand;
+    int clingerExponent = exponent;
+    // Move excess exponent into the significand while it stays exact,
+    // e.g. 12e25 = 12000e22
+    while(clingerExponent > 22 && clingerSignificand <= maxExactInt / 10) {
+        clingerSignificand *= 10;
+        --clingerExponent;
     }
-    switch(str[pos]) {
-    case '(':
-    case ')':
-    case ',':
-        return str[pos];
+    if(clingerSignificand > maxExactInt ||
+            clingerExponent < -22 || clingerExponent > 22) {
+        return eiselLemire(significand, exponent, negative, result);
     }
 
-    // It's either a Number or a Word, let's
-    // see when it ends
+    double value = static_cast<double>(clingerSignificand);
+    exponent = clingerExponent;
+    if(exponent < 0) {
+        value /= exactPowersOfTen[-exponent];
+    }
+    else {
+        value *= exactPowersOfTen[exponent];
+    }
+    result = negative ? -value : value;
+    return true;
+}
 
-    pos = str.find_first_of("\n\r\t() ,", iter - str.begin());
+/*
+ * Converts [p, end) with strtod, which handles every form the fast path
+ * gives up on (long significands, extreme exponents, inf, nan...).
+ * The '.' decimal separator is swapped for the one of the current
+ * C locale so that the result does not depend on it.
+ */
+bool
+parseNumberSlow(const char* p, const char* end, double& result)
+{
+    // strtod needs a terminated string: use the stack unless the
+    // token is unusually long
+    char buf[64];
+    string longTok;
+    size_t len = static_cast<size_t>(end - p);
+    char* tok;
+    if(len < sizeof(buf)) {
+        memcpy(buf, p, len);
+        buf[len] = '\0';
+        tok = buf;
+    }
+    else {
+        longTok.assign(p, end);
+        tok = &longTok[0];
+    }
 
-    if(pos == string::npos) {
-        if(iter != str.end()) {
-            tok.assign(iter, str.end());
+    const char* point = localeconv()->decimal_point;
+    if(point && point[0] != '.' && point[0] != '\0' && point[1] == '\0') {
+        for(char* c = tok; *c; ++c) {
+            if(*c == '.') {
+                *c = point[0];
+            }
         }
-        else {
-            return StringTokenizer::TT_EOF;
+    }
+
+    char* stopstring;
+    result = strtod_with_vc_fix(tok, &stopstring);
+    return *stopstring == '\0';
+}
+
+/*
+ * Tells whether [p, end) is a number, storing its value in result.
+ * Words (any token strtod would not fully consume) return false.
+ */
+bool
+parseNumber(const char* p, const char* end, double& result)
+{
+    if(parseDecimalFast(p, end, result)) {
+        return true;
+    }
+    // Cheap rejection of keywords before calling strtod; those starting
+    // with i or n may still be inf or nan
+    char c = *p;
+    if((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+        if(c != 'i' && c != 'I' && c != 'n' && c != 'N') {
+            return false;
         }
     }
-    else {
-        tok.assign(iter, str.begin() + pos); //str.end());
+    return parseNumberSlow(p, end, result);
+}
+
+} // anonymous namespace
+
+/*public*/
+StringTokenizer::StringTokenizer(const string& txt)
+    :
+    iter(txt.data()),
+    end(txt.data() + txt.size()),
+    tokType(TT_EOF),
+    ntok(0.0),
+    wordStart(nullptr),
+    wordEnd(nullptr),
+    peeked(false)
+{
+}
+
+/*public*/
+StringTokenizer::StringTokenizer(const char* txt, size_t len)
+    :
+    iter(txt),
+    end(txt + len),
+    tokType(TT_EOF),
+    ntok(0.0),
+    wordStart(nullptr),
+    wordEnd(nullptr),
+    peeked(false)
+{
+}
+
+/*private*/
+int
+StringTokenizer::scanToken()
+{
+    while(iter != end && isSpace(*iter)) {
+        ++iter;
+    }
+    if(iter == end) {
+        return tokType = TT_EOF;
     }
 
-    char* stopstring;
-    double dbl = strtod_with_vc_fix(tok.c_str(), &stopstring);
-    if(*stopstring == '\0') {
+    switch(*iter) {
+    case '(':
+    case ')':
+    case ',':
+        return tokType = *iter++;
+    }
+
+    const char* start = iter;
+    while(iter != end && !isDelimiter(*iter)) {
+        ++iter;
+    }
+
+    double dbl;
+    if(parseNumber(start, iter, dbl)) {
         ntok = dbl;
-        stok = "";
-        return StringTokenizer::TT_NUMBER;
+        wordStart = wordEnd = nullptr;
+        return tokType = TT_NUMBER;
     }
-    else {
-        ntok = 0.0;
-        stok = tok;
-        return StringTokenizer::TT_WORD;
+
+    ntok = 0.0;
+    wordStart = start;
+    wordEnd = iter;
+    return tokType = TT_WORD;
+}
+
+/*public*/
+int
+StringTokenizer::nextToken()
+{
+    if(peeked) {
+        peeked = false;
+        return tokType;
     }
+    return scanToken();
+}
+
+/*public*/
+int
+StringTokenizer::peekNextToken()
+{
+    if(!peeked) {
+        scanToken();
+        peeked = true;
+    }
+    return tokType;
 }
 
 /*public*/
 double
-StringTokenizer::getNVal()
+StringTokenizer::getNVal() const
 {
     return ntok;
 }
 
 /*public*/
 string
-StringTokenizer::getSVal()
+StringTokenizer::getSVal() const
 {
-    return stok;
+    if(wordStart == nullptr) {
+        return string();
+    }
+    return string(wordStart, wordEnd);
 }
 
 } // namespace geos.io
@@ -21,6 +21,7 @@
 #include <geos/io/ByteOrderValues.h>
 #include <geos/io/ParseException.h>
 #include <geos/geom/GeometryFactory.h>
+#include <geos/geom/GeometryPool.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Point.h>
 #include <geos/geom/LinearRing.h>
@@ -32,8 +33,12 @@
 #include <geos/geom/CoordinateSequenceFactory.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/PrecisionModel.h>
+#include <geos/util/Machine.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <limits>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -48,7 +53,14 @@ namespace io { // geos.io
 
 WKBReader::WKBReader()
     :
-    factory(*(GeometryFactory::getDefaultInstance()))
+    factory(*(GeometryFactory::getDefaultInstance())),
+    pool(nullptr)
+{}
+
+WKBReader::WKBReader(GeometryPool& p_pool)
+    :
+    factory(p_pool.getFactory()),
+    pool(&p_pool)
 {}
 
 ostream&
@@ -130,8 +142,7 @@ ASCIIHexToUChar(char val)
 Geometry*
 WKBReader::readHEX(istream& is)
 {
-    // setup input/output stream
-    stringstream os(ios_base::binary | ios_base::in | ios_base::out);
+    std::vector<unsigned char> wkb;
 
     while(true) {
         const int input_high = is.get();
@@ -151,28 +162,171 @@ WKBReader::readHEX(istream& is)
         const unsigned char result_low = ASCIIHexToUChar(low);
 
         const unsigned char value =
-            static_cast<char>((result_high << 4) + result_low);
+            static_cast<unsigned char>((result_high << 4) + result_low);
 
 #if DEBUG_HEX_READER
         cout << "HEX " << high << low << " -> DEC " << (int)value << endl;
 #endif
-        // write the value to the output stream
-        os << value;
+        wkb.push_back(value);
     }
 
     // now call read to convert the geometry
-    return this->read(os);
+    return this->read(wkb.data(), wkb.size());
+}
+
+Geometry*
+WKBReader::readHEX(const char* hex, std::size_t size)
+{
+    if(size % 2) {
+        throw ParseException("Premature end of HEX string");
+    }
+
+    std::vector<unsigned char> wkb(size / 2);
+    for(std::size_t i = 0; i < wkb.size(); ++i) {
+        const unsigned char result_high = ASCIIHexToUChar(hex[2 * i]);
+        const unsigned char result_low = ASCIIHexToUChar(hex[2 * i + 1]);
+        wkb[i] = static_cast<unsigned char>((result_high << 4) + result_low);
+    }
+
+    return this->read(wkb.data(), wkb.size());
 }
 
 Geometry*
 WKBReader::read(istream& is)
 {
-    dis.setInStream(&is); // will default to machine endian
-    return readGeometry();
+    // only consume the bytes of one geometry, more may follow
+    dis.setInStream(&is);
+    dis.setOrder(getMachineByteOrder()); // default to machine endian
+
+    std::unique_ptr<Geometry> g(readGeometry());
+    if(!filterEnvelope.isNull() &&
+            !filterEnvelope.intersects(g->getEnvelopeInternal())) {
+        // a stream cannot be scanned then read again, so the
+        // geometries missing the filter are built and dropped
+        if(pool) {
+            pool->recycle(std::move(g));
+        }
+        return nullptr;
+    }
+    return g.release();
 }
 
 Geometry*
-WKBReader::readGeometry()
+WKBReader::read(const unsigned char* buf, size_t size)
+{
+    dis.setInStream(buf, size);
+    dis.setOrder(getMachineByteOrder()); // default to machine endian
+
+    if(!filterEnvelope.isNull()) {
+        // only scan the coordinates, and build nothing, for geometries
+        // missing the filter
+        Envelope env;
+        if(!scanGeometry(env) && !filterEnvelope.intersects(env)) {
+            return nullptr;
+        }
+        dis.setInStream(buf, size);
+        dis.setOrder(getMachineByteOrder());
+    }
+
+    return readGeometry();
+}
+
+void
+WKBReader::setFilterEnvelope(const Envelope* env)
+{
+    if(env) {
+        filterEnvelope = *env;
+    }
+    else {
+        filterEnvelope.setToNull();
+    }
+}
+
+void
+WKBReader::setTargetPrecisionModel(const PrecisionModel* pm)
+{
+    targetPrecisionModel.reset(pm ? new PrecisionModel(*pm) : nullptr);
+}
+
+bool
+WKBReader::scanGeometry(Envelope& env)
+{
+    int SRID;
+    int geometryType = readGeometryHeader(SRID);
+
+    switch(geometryType) {
+    case WKBConstants::wkbPoint :
+        return scanCoordinates(1, env);
+    case WKBConstants::wkbLineString :
+        return scanCoordinates(readCount(inputDimension * 8), env);
+    case WKBConstants::wkbPolygon : {
+        size_t numRings = readCount(4);
+        for(size_t i = 0; i < numRings; i++) {
+            if(scanCoordinates(readCount(inputDimension * 8), env)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    case WKBConstants::wkbMultiPoint :
+    case WKBConstants::wkbMultiLineString :
+    case WKBConstants::wkbMultiPolygon :
+    case WKBConstants::wkbGeometryCollection : {
+        size_t numGeoms = readCount(5);
+        for(size_t i = 0; i < numGeoms; i++) {
+            if(scanGeometry(env)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    default:
+        stringstream err;
+        err << "Unknown WKB type " << geometryType;
+        throw  ParseException(err.str());
+    }
+}
+
+bool
+WKBReader::scanCoordinates(size_t size, Envelope& env)
+{
+    double ords[3];
+    for(size_t i = 0; i < size; i++) {
+        dis.readDoubles(ords, inputDimension);
+        // empty points are written with NaN coordinates
+        if(std::isnan(ords[0]) || std::isnan(ords[1])) {
+            continue;
+        }
+        // no need to look further once a point is known to be inside
+        if(filterEnvelope.intersects(ords[0], ords[1])) {
+            return true;
+        }
+        env.expandToInclude(ords[0], ords[1]);
+    }
+    return false;
+}
+
+size_t
+WKBReader::readCount(size_t minItemBytes)
+{
+    int count = dis.readInt();
+    if(count < 0) {
+        stringstream err;
+        err << "Invalid WKB element count " << count;
+        throw ParseException(err.str());
+    }
+    size_t n = static_cast<size_t>(count);
+    if(minItemBytes > 0 && n > dis.size() / minItemBytes) {
+        stringstream err;
+        err << "WKB element count " << count
+            << " exceeds the remaining " << dis.size() << " bytes";
+        throw ParseException(err.str());
+    }
+    return n;
+}
+
+int
+WKBReader::readGeometryHeader(int& SRID)
 {
     // determine byte order
     unsigned char byteOrder = dis.readByte();
@@ -226,11 +380,19 @@ WKBReader::readGeometry()
     cout << "WKB hasSRID: " << hasSRID << endl;
 #endif
 
-    int SRID = 0;
+    SRID = 0;
     if(hasSRID) {
         SRID = dis.readInt();    // read SRID
     }
 
+    return geometryType;
+}
+
+Geometry*
+WKBReader::readGeometry()
+{
+    int SRID;
+    int geometryType = readGeometryHeader(SRID);
 
     // allocate space for ordValues
     if(ordValues.size() < inputDimension) {
@@ -286,29 +448,29 @@ WKBReader::readPoint()
 LineString*
 WKBReader::readLineString()
 {
-    int size = dis.readInt();
+    size_t size = readCount(inputDimension * 8);
 #if DEBUG_WKB_READER
     cout << "WKB npoints: " << size << endl;
 #endif
-    auto pts = readCoordinateSequence(size);
+    auto pts = readCoordinateSequence(size, 2);
     return factory.createLineString(pts.release());
 }
 
 LinearRing*
 WKBReader::readLinearRing()
 {
-    int size = dis.readInt();
+    size_t size = readCount(inputDimension * 8);
 #if DEBUG_WKB_READER
     cout << "WKB npoints: " << size << endl;
 #endif
-    auto pts = readCoordinateSequence(size);
+    auto pts = readCoordinateSequence(size, 4);
     return factory.createLinearRing(pts.release());
 }
 
 Polygon*
 WKBReader::readPolygon()
 {
-    int numRings = dis.readInt();
+    size_t numRings = readCount(4);
 
 #if DEBUG_WKB_READER
     cout << "WKB numRings: " << numRings << endl;
@@ -323,12 +485,12 @@ WKBReader::readPolygon()
     if(numRings > 1) {
         try {
             holes = new vector<Geometry*>(numRings - 1);
-            for(int i = 0; i < numRings - 1; i++) {
+            for(size_t i = 0; i < numRings - 1; i++) {
                 (*holes)[i] = (Geometry*)readLinearRing();
             }
         }
         catch(...) {
-            for(unsigned int i = 0; i < holes->size(); i++) {
+            for(size_t i = 0; i < holes->size(); i++) {
                 delete(*holes)[i];
             }
             delete holes;
@@ -342,11 +504,11 @@ WKBReader::readPolygon()
 MultiPoint*
 WKBReader::readMultiPoint()
 {
-    int numGeoms = dis.readInt();
+    size_t numGeoms = readCount(5);
     vector<Geometry*>* geoms = new vector<Geometry*>(numGeoms);
 
     try {
-        for(int i = 0; i < numGeoms; i++) {
+        for(size_t i = 0; i < numGeoms; i++) {
             Geometry* g = readGeometry();
             if(!dynamic_cast<Point*>(g)) {
                 stringstream err;
@@ -357,7 +519,7 @@ WKBReader::readMultiPoint()
         }
     }
     catch(...) {
-        for(unsigned int i = 0; i < geoms->size(); i++) {
+        for(size_t i = 0; i < geoms->size(); i++) {
             delete(*geoms)[i];
         }
         delete geoms;
@@ -369,11 +531,11 @@ WKBReader::readMultiPoint()
 MultiLineString*
 WKBReader::readMultiLineString()
 {
-    int numGeoms = dis.readInt();
+    size_t numGeoms = readCount(5);
     vector<Geometry*>* geoms = new vector<Geometry*>(numGeoms);
 
     try {
-        for(int i = 0; i < numGeoms; i++) {
+        for(size_t i = 0; i < numGeoms; i++) {
             Geometry* g = readGeometry();
             if(!dynamic_cast<LineString*>(g)) {
                 stringstream err;
@@ -384,7 +546,7 @@ WKBReader::readMultiLineString()
         }
     }
     catch(...) {
-        for(unsigned int i = 0; i < geoms->size(); i++) {
+        for(size_t i = 0; i < geoms->size(); i++) {
             delete(*geoms)[i];
         }
         delete geoms;
@@ -396,11 +558,11 @@ WKBReader::readMultiLineString()
 MultiPolygon*
 WKBReader::readMultiPolygon()
 {
-    int numGeoms = dis.readInt();
+    size_t numGeoms = readCount(5);
     vector<Geometry*>* geoms = new vector<Geometry*>(numGeoms);
 
     try {
-        for(int i = 0; i < numGeoms; i++) {
+        for(size_t i = 0; i < numGeoms; i++) {
             Geometry* g = readGeometry();
             if(!dynamic_cast<Polygon*>(g)) {
                 stringstream err;
@@ -411,7 +573,7 @@ WKBReader::readMultiPolygon()
         }
     }
     catch(...) {
-        for(unsigned int i = 0; i < geoms->size(); i++) {
+        for(size_t i = 0; i < geoms->size(); i++) {
             delete(*geoms)[i];
         }
         delete geoms;
@@ -423,16 +585,16 @@ WKBReader::readMultiPolygon()
 GeometryCollection*
 WKBReader::readGeometryCollection()
 {
-    int numGeoms = dis.readInt();
+    size_t numGeoms = readCount(5);
     vector<Geometry*>* geoms = new vector<Geometry*>(numGeoms);
 
     try {
-        for(int i = 0; i < numGeoms; i++) {
+        for(size_t i = 0; i < numGeoms; i++) {
             (*geoms)[i] = (readGeometry());
         }
     }
     catch(...) {
-        for(unsigned int i = 0; i < geoms->size(); i++) {
+        for(size_t i = 0; i < geoms->size(); i++) {
             delete(*geoms)[i];
         }
         delete geoms;
@@ -442,26 +604,79 @@ WKBReader::readGeometryCollection()
 }
 
 std::unique_ptr<CoordinateSequence>
-WKBReader::readCoordinateSequence(int size)
+WKBReader::readCoordinateSequence(size_t size, size_t minSize)
 {
-    auto seq = factory.getCoordinateSequenceFactory()->create(size, inputDimension);
-    auto targetDim = seq->getDimension();
-    if(targetDim > inputDimension) {
-        targetDim = inputDimension;
-    }
-    for(int i = 0; i < size; i++) {
-        readCoordinate();
-        for(unsigned int j = 0; j < targetDim; j++) {
-            seq->setOrdinate(i, j, ordValues[j]);
+    // Decode straight into the Coordinate array; readDoubles turns into
+    // a memcpy when the WKB byte order matches the machine one.
+    // An arena factory copies the coordinates to its arena: decode
+    // them into a buffer kept from one sequence to the next
+    std::unique_ptr<std::vector<Coordinate>> owned;
+    std::vector<Coordinate>* coords = &coordBuffer;
+    if(factory.getArena()) {
+        coordBuffer.resize(size);
+    }
+    else {
+        owned.reset(new std::vector<Coordinate>(size));
+        coords = owned.get();
+    }
+    static_assert(sizeof(Coordinate) == 3 * sizeof(double),
+                  "Coordinate is expected to be three packed doubles");
+    if(inputDimension == 3 && size > 0) {
+        dis.readDoubles(&(*coords)[0].x, size * 3);
+    }
+    else {
+        for(Coordinate& c : *coords) {
+            dis.readDoubles(&c.x, 2);
+            // recycled coordinates may hold the Z of a 3D geometry
+            c.z = DoubleNotANumber;
+        }
+    }
+
+    const PrecisionModel& pm = targetPrecisionModel ? *targetPrecisionModel : *factory.getPrecisionModel();
+    if(!pm.isFloating()) {
+        for(Coordinate& c : *coords) {
+            c.x = pm.makePrecise(c.x);
+            c.y = pm.makePrecise(c.y);
         }
     }
+
+    if(targetPrecisionModel && size > 1) {
+        removeRepeatedPoints(*coords, minSize);
+    }
+
+    if(owned) {
+        return factory.getCoordinateSequenceFactory()->create(owned.release(), inputDimension);
+    }
+    auto seq = factory.getCoordinateSequenceFactory()->create(std::size_t(0), inputDimension);
+    seq->setPoints(*coords);
     return seq;
 }
 
+/*private static*/
+void
+WKBReader::removeRepeatedPoints(std::vector<Coordinate>& coords, size_t minSize)
+{
+    size_t distinct = 1;
+    for(size_t i = 1; i < coords.size(); i++) {
+        if(!coords[i].equals2D(coords[i - 1])) {
+            distinct++;
+        }
+    }
+    // as GeometryPrecisionReducer::reducePointwise, keep the full
+    // sequence rather than collapse it to an invalid length
+    if(distinct == coords.size() || distinct < minSize) {
+        return;
+    }
+    coords.erase(std::unique(coords.begin(), coords.end(),
+    [](const Coordinate & a, const Coordinate & b) {
+        return a.equals2D(b);
+    }), coords.end());
+}
+
 void
 WKBReader::readCoordinate()
 {
-    const PrecisionModel& pm = *factory.getPrecisionModel();
+    const PrecisionModel& pm = targetPrecisionModel ? *targetPrecisionModel : *factory.getPrecisionModel();
     for(unsigned int i = 0; i < inputDimension; ++i) {
         if(i <= 1) {
             ordValues[i] = pm.makePrecise(dis.readDouble());
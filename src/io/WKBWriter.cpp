@@ -17,7 +17,6 @@
  **********************************************************************/
 
 #include <geos/io/WKBWriter.h>
-#include <geos/io/WKBReader.h>
 #include <geos/io/WKBConstants.h>
 #include <geos/io/ByteOrderValues.h>
 #include <geos/util/IllegalArgumentException.h>
@@ -32,9 +31,11 @@
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/PrecisionModel.h>
 
+#include <algorithm>
 #include <ostream>
 #include <sstream>
 #include <cassert>
+#include <vector>
 
 #undef DEBUG_WKB_WRITER
 
@@ -45,7 +46,7 @@ namespace geos {
 namespace io { // geos.io
 
 WKBWriter::WKBWriter(int dims, int bo, bool srid):
-    defaultOutputDimension(dims), byteOrder(bo), includeSRID(srid), outStream(nullptr)
+    defaultOutputDimension(dims), byteOrder(bo), includeSRID(srid), out(nullptr)
 {
     if(dims < 2 || dims > 3) {
         throw util::IllegalArgumentException("WKB output dimension must be 2 or 3");
@@ -72,26 +73,107 @@ WKBWriter::~WKBWriter()
 void
 WKBWriter::writeHEX(const Geometry& g, ostream& os)
 {
-    // setup input/output stream
-    stringstream stream;
+    static const char hex[] = "0123456789ABCDEF";
 
-    // write the geometry in wkb format
-    this->write(g, stream);
+    std::vector<unsigned char> wkb(getWKBSize(g));
+    write(g, wkb.data(), wkb.size());
 
-    // convert to HEX
-    WKBReader::printHEX(stream, os);
+    std::string text(wkb.size() * 2, '0');
+    for(std::size_t i = 0; i < wkb.size(); i++) {
+        text[2 * i] = hex[wkb[i] >> 4];
+        text[2 * i + 1] = hex[wkb[i] & 0x0F];
+    }
+    os.write(text.data(), static_cast<std::streamsize>(text.size()));
 }
 
 void
 WKBWriter::write(const Geometry& g, ostream& os)
+{
+    std::vector<unsigned char> wkb(getWKBSize(g));
+    write(g, wkb.data(), wkb.size());
+    os.write(reinterpret_cast<const char*>(wkb.data()),
+             static_cast<std::streamsize>(wkb.size()));
+}
+
+size_t
+WKBWriter::getWKBSize(const Geometry& g) const
+{
+    return computeSize(g, includeSRID);
+}
+
+size_t
+WKBWriter::write(const Geometry& g, unsigned char* buf, size_t bufSize)
+{
+    size_t size = getWKBSize(g);
+    if(bufSize < size) {
+        std::ostringstream os;
+        os << "WKB output needs " << size << " bytes, buffer has " << bufSize;
+        throw util::IllegalArgumentException(os.str());
+    }
+
+    out = buf;
+    writeGeometry(g);
+    assert(out == buf + size);
+    out = nullptr;
+    return size;
+}
+
+/* private */
+size_t
+WKBWriter::computeSize(const Geometry& g, bool withSRID) const
+{
+    // Mirrors the write* methods below
+    size_t dims = static_cast<size_t>(std::min(defaultOutputDimension,
+                                      g.getCoordinateDimension()));
+    size_t size = 1 + 4; // byte order, type
+    if(withSRID && g.getSRID() != 0) {
+        size += 4;
+    }
+
+    if(const Point* x = dynamic_cast<const Point*>(&g)) {
+        if(x->isEmpty()) throw
+            util::IllegalArgumentException("Empty Points cannot be represented in WKB");
+        return size + dims * 8;
+    }
+
+    if(const LineString* x = dynamic_cast<const LineString*>(&g)) {
+        return size + 4 + x->getNumPoints() * dims * 8;
+    }
+
+    if(const Polygon* x = dynamic_cast<const Polygon*>(&g)) {
+        size += 4;
+        if(x->isEmpty()) {
+            return size;
+        }
+        size += 4 + x->getExteriorRing()->getNumPoints() * dims * 8;
+        for(size_t i = 0, n = x->getNumInteriorRing(); i < n; i++) {
+            size += 4 + x->getInteriorRingN(i)->getNumPoints() * dims * 8;
+        }
+        return size;
+    }
+
+    if(const GeometryCollection* x =
+                dynamic_cast<const GeometryCollection*>(&g)) {
+        size += 4;
+        for(size_t i = 0, n = x->getNumGeometries(); i < n; i++) {
+            size += computeSize(*x->getGeometryN(i), false);
+        }
+        return size;
+    }
+
+    assert(0); // Unknown Geometry type
+    return size;
+}
+
+/* private */
+void
+WKBWriter::writeGeometry(const Geometry& g)
 {
     outputDimension = defaultOutputDimension;
     if(outputDimension > g.getCoordinateDimension()) {
         outputDimension = g.getCoordinateDimension();
     }
 
-    outStream = &os;
-
     if(const Point* x = dynamic_cast<const Point*>(&g)) {
         return writePoint(*x);
     }
@@ -201,12 +283,11 @@ WKBWriter::writeGeometryCollection(const GeometryCollection& g,
     auto orig_includeSRID = includeSRID;
     includeSRID = false;
 
-    assert(outStream);
     for(std::size_t i = 0; i < ngeoms; i++) {
         const Geometry* elem = g.getGeometryN(i);
         assert(elem);
 
-        write(*elem, *outStream);
+        writeGeometry(*elem);
     }
     includeSRID = orig_includeSRID;
 }
@@ -214,15 +295,13 @@ WKBWriter::writeGeometryCollection(const GeometryCollection& g,
 void
 WKBWriter::writeByteOrder()
 {
+    assert(out);
     if(byteOrder == ByteOrderValues::ENDIAN_LITTLE) {
-        buf[0] = WKBConstants::wkbNDR;
+        *out++ = WKBConstants::wkbNDR;
     }
     else {
-        buf[0] = WKBConstants::wkbXDR;
+        *out++ = WKBConstants::wkbXDR;
     }
-
-    assert(outStream);
-    outStream->write(reinterpret_cast<char*>(buf), 1);
 }
 
 /* public */
@@ -265,9 +344,8 @@ WKBWriter::writeSRID(int SRID)
 void
 WKBWriter::writeInt(int val)
 {
-    ByteOrderValues::putInt(val, buf, byteOrder);
-    outStream->write(reinterpret_cast<char*>(buf), 4);
-    //outStream->write(reinterpret_cast<char *>(&val), 4);
+    ByteOrderValues::putInt(val, out, byteOrder);
+    out += 4;
 }
 
 void
@@ -292,20 +370,20 @@ void
 WKBWriter::writeCoordinate(const CoordinateSequence& cs, size_t idx,
                            bool is3d)
 {
+    // Fetch the whole coordinate with a single virtual call
+    Coordinate c;
+    cs.getAt(idx, c);
 #if DEBUG_WKB_WRITER
-    cout << "writeCoordinate: X:" << cs.getX(idx) << " Y:" << cs.getY(idx) << endl;
+    cout << "writeCoordinate: X:" << c.x << " Y:" << c.y << endl;
 #endif
-    assert(outStream);
+    assert(out);
 
-    ByteOrderValues::putDouble(cs.getX(idx), buf, byteOrder);
-    outStream->write(reinterpret_cast<char*>(buf), 8);
-    ByteOrderValues::putDouble(cs.getY(idx), buf, byteOrder);
-    outStream->write(reinterpret_cast<char*>(buf), 8);
+    ByteOrderValues::putDouble(c.x, out, byteOrder);
+    ByteOrderValues::putDouble(c.y, out + 8, byteOrder);
+    out += 16;
     if(is3d) {
-        ByteOrderValues::putDouble(
-            cs.getOrdinate(idx, CoordinateSequence::Z),
-            buf, byteOrder);
-        outStream->write(reinterpret_cast<char*>(buf), 8);
+        ByteOrderValues::putDouble(c.z, out, byteOrder);
+        out += 8;
     }
 }
 
@@ -20,7 +20,6 @@
 #include <geos/io/WKTReader.h>
 #include <geos/io/StringTokenizer.h>
 #include <geos/io/ParseException.h>
-#include <geos/io/CLocalizer.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Point.h>
@@ -60,14 +59,20 @@ namespace io { // geos.io
 Geometry*
 WKTReader::read(const string& wellKnownText)
 {
-    //unique_ptr<StringTokenizer> tokenizer(new StringTokenizer(wellKnownText));
-    CLocalizer clocale;
+    // StringTokenizer parses numbers independently of the C locale
     StringTokenizer tokenizer(wellKnownText);
     Geometry* g = nullptr;
     g = readGeometryTaggedText(&tokenizer);
     return g;
 }
 
+Geometry*
+WKTReader::read(const char* wellKnownText, std::size_t size)
+{
+    StringTokenizer tokenizer(wellKnownText, size);
+    return readGeometryTaggedText(&tokenizer);
+}
+
 std::unique_ptr<CoordinateSequence>
 WKTReader::getCoordinates(StringTokenizer* tokenizer)
 {
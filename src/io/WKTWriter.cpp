@@ -20,7 +20,6 @@
 
 #include <geos/io/WKTWriter.h>
 #include <geos/io/Writer.h>
-#include <geos/io/CLocalizer.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Point.h>
 #include <geos/geom/LinearRing.h>
@@ -35,12 +34,17 @@
 
 #include <algorithm> // for min
 #include <typeinfo>
+#include <clocale>
+#include <cstdint>
 #include <cstdio> // should avoid this
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <cassert>
 #include <cmath>
 #include <iomanip>
+#include <vector>
 
 using namespace std;
 using namespace geos::geom;
@@ -48,6 +52,302 @@ using namespace geos::geom;
 namespace geos {
 namespace io { // geos.io
 
+namespace {
+
+#ifdef __SIZEOF_INT128__
+
+__extension__ typedef unsigned __int128 uint128;
+
+// Largest power of five used as an exact 64-bit factor
+const int maxPowerOfFive = 27;
+
+// Values are kept below 2^126 so that doubling a remainder cannot overflow
+const int maxBits = 126;
+
+int
+bitLength(uint128 v)
+{
+    uint64_t hi = static_cast<uint64_t>(v >> 64);
+    uint64_t lo = static_cast<uint64_t>(v);
+    if(hi) {
+        return 128 - __builtin_clzll(hi);
+    }
+    return lo ? 64 - __builtin_clzll(lo) : 0;
+}
+
+/*
+ * Computes round(|d| * 10^k), ties to even, exactly.
+ * Returns false when the intermediate values do not fit in 128 bits.
+ */
+bool
+scaleRounded(double d, int k, uint128& result)
+{
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    int biased = static_cast<int>((bits >> 52) & 0x7FF);
+    uint64_t m = bits & ((uint64_t(1) << 52) - 1);
+    int e;
+    if(biased == 0) {
+        e = -1074;
+    }
+    else {
+        m |= uint64_t(1) << 52;
+        e = biased - 1075;
+    }
+    if(m == 0) {
+        result = 0;
+        return true;
+    }
+    if(k > maxPowerOfFive || k < -maxPowerOfFive) {
+        return false;
+    }
+
+    uint64_t p5 = 1;
+    for(int i = 0; i < std::abs(k); ++i) {
+        p5 *= 5;
+    }
+    // |d| * 10^k = m * 5^k * 2^(e+k)
+    uint128 num = m;
+    uint128 den = 1;
+    if(k >= 0) {
+        num *= p5;
+    }
+    else {
+        den = p5;
+    }
+    int twoExp = e + k;
+    if(twoExp >= 0) {
+        if(bitLength(num) + twoExp > maxBits) {
+            return false;
+        }
+        num <<= twoExp;
+    }
+    else {
+        int shift = -twoExp;
+        if(bitLength(num) < shift) {
+            // num < 2^(shift-1) <= den * 2^shift / 2
+            result = 0;
+            return true;
+        }
+        if(bitLength(den) + shift > maxBits) {
+            return false;
+        }
+        den <<= shift;
+    }
+
+    uint128 q = num / den;
+    uint128 twiceRem = (num % den) << 1;
+    if(twiceRem > den || (twiceRem == den && (q & 1))) {
+        ++q;
+    }
+    result = q;
+    return true;
+}
+
+// Writes the decimal digits of v to out, returns their number
+std::size_t
+writeDigits(uint128 v, char* out)
+{
+    char tmp[40];
+    std::size_t n = 0;
+    while(v > UINT64_MAX) {
+        tmp[n++] = static_cast<char>('0' + static_cast<int>(v % 10));
+        v /= 10;
+    }
+    uint64_t small = static_cast<uint64_t>(v);
+    do {
+        tmp[n++] = static_cast<char>('0' + static_cast<int>(small % 10));
+        small /= 10;
+    }
+    while(small);
+    for(std::size_t i = 0; i < n; ++i) {
+        out[i] = tmp[n - 1 - i];
+    }
+    return n;
+}
+
+/*
+ * Formats d like printf("%.*f", decimals, d) in the C locale.
+ * Returns the length written to out, or 0 if d is out of range
+ * (out must hold at least 80 characters).
+ */
+std::size_t
+formatFixed(double d, int decimals, char* out)
+{
+    uint128 n;
+    if(!std::isfinite(d) || !scaleRounded(d, decimals, n)) {
+        return 0;
+    }
+
+    char digits[40];
+    std::size_t nd = writeDigits(n, digits);
+    std::size_t frac = static_cast<std::size_t>(decimals);
+
+    char* p = out;
+    if(std::signbit(d)) {
+        *p++ = '-';
+    }
+    if(nd <= frac) {
+        *p++ = '0';
+    }
+    else {
+        memcpy(p, digits, nd - frac);
+        p += nd - frac;
+    }
+    if(frac > 0) {
+        *p++ = '.';
+        for(std::size_t i = nd; i < frac; ++i) {
+            *p++ = '0';
+        }
+        std::size_t take = std::min(nd, frac);
+        memcpy(p, digits + nd - take, take);
+        p += take;
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+/*
+ * Formats d like printf("%.*g", precision, d) in the C locale.
+ * Returns the length written to out, or 0 if d is out of range
+ * (out must hold at least 80 characters).
+ */
+std::size_t
+formatGeneral(double d, int precision, char* out)
+{
+    if(!std::isfinite(d) || precision > maxPowerOfFive) {
+        return 0;
+    }
+    if(precision == 0) {
+        precision = 1;
+    }
+
+    char* p = out;
+    if(std::signbit(d)) {
+        *p++ = '-';
+    }
+    if(d == 0) {
+        *p++ = '0';
+        return static_cast<std::size_t>(p - out);
+    }
+
+    uint128 lowest = 1;
+    for(int i = 1; i < precision; ++i) {
+        lowest *= 10;
+    }
+    uint128 highest = lowest * 10;
+
+    // Find the decimal exponent x so that the rounded significand has
+    // exactly precision digits; log10 may be off by one
+    int x = static_cast<int>(std::floor(std::log10(std::fabs(d))));
+    uint128 n = 0;
+    bool found = false;
+    for(int attempt = 0; attempt < 3 && !found; ++attempt) {
+        if(!scaleRounded(d, precision - 1 - x, n)) {
+            return 0;
+        }
+        if(n >= highest) {
+            ++x;
+        }
+        else if(n < lowest) {
+            --x;
+        }
+        else {
+            found = true;
+        }
+    }
+    if(!found) {
+        return 0;
+    }
+
+    char digits[40];
+    std::size_t nd = writeDigits(n, digits);
+    while(nd > 1 && digits[nd - 1] == '0') {
+        --nd;    // %g drops trailing zeros
+    }
+
+    if(x < -4 || x >= precision) {
+        *p++ = digits[0];
+        if(nd > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, nd - 1);
+            p += nd - 1;
+        }
+        *p++ = 'e';
+        *p++ = x < 0 ? '-' : '+';
+        int ax = std::abs(x);
+        if(ax < 10) {
+            *p++ = '0';
+        }
+        char expDigits[8];
+        std::size_t ne = writeDigits(static_cast<uint128>(ax), expDigits);
+        memcpy(p, expDigits, ne);
+        p += ne;
+    }
+    else if(x >= 0) {
+        std::size_t intDigits = static_cast<std::size_t>(x) + 1;
+        for(std::size_t i = 0; i < intDigits; ++i) {
+            *p++ = i < nd ? digits[i] : '0';
+        }
+        if(nd > intDigits) {
+            *p++ = '.';
+            memcpy(p, digits + intDigits, nd - intDigits);
+            p += nd - intDigits;
+        }
+    }
+    else {
+        *p++ = '0';
+        *p++ = '.';
+        for(int i = -1; i > x; --i) {
+            *p++ = '0';
+        }
+        memcpy(p, digits, nd);
+        p += nd;
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+#else // no 128-bit integers: always use the printf based path
+
+std::size_t
+formatFixed(double, int, char*)
+{
+    return 0;
+}
+
+std::size_t
+formatGeneral(double, int, char*)
+{
+    return 0;
+}
+
+#endif
+
+// printf based formatting for what formatFixed and formatGeneral
+// do not handle, with the C locale decimal point
+std::string
+formatWithPrintf(double d, int precision, bool general)
+{
+    const char* fmt = general ? "%.*g" : "%.*f";
+    std::vector<char> buf(64);
+    int len = std::snprintf(buf.data(), buf.size(), fmt, precision, d);
+    if(len < 0) {
+        return std::string();
+    }
+    if(static_cast<std::size_t>(len) >= buf.size()) {
+        buf.resize(static_cast<std::size_t>(len) + 1);
+        std::snprintf(buf.data(), buf.size(), fmt, precision, d);
+    }
+    std::string ret(buf.data(), static_cast<std::size_t>(len));
+
+    const char* point = localeconv()->decimal_point;
+    if(point && point[0] != '.' && point[0] != '\0' && point[1] == '\0') {
+        std::replace(ret.begin(), ret.end(), point[0], '.');
+    }
+    return ret;
+}
+
+} // anonymous namespace
+
 WKTWriter::WKTWriter():
     decimalPlaces(6),
     isFormatted(false),
@@ -178,7 +478,6 @@ void
 WKTWriter::writeFormatted(const Geometry* geometry, bool p_isFormatted,
                           Writer* writer)
 {
-    CLocalizer clocale;
     this->isFormatted = p_isFormatted;
     decimalPlaces = roundingPrecision == -1 ? geometry->getPrecisionModel()->getMaximumSignificantDigits() :
                     roundingPrecision;
@@ -341,16 +640,16 @@ void
 WKTWriter::appendCoordinate(const Coordinate* coordinate,
                             Writer* writer)
 {
-    writer->write(writeNumber(coordinate->x));
-    writer->write(" ");
-    writer->write(writeNumber(coordinate->y));
+    appendNumber(coordinate->x, writer);
+    writer->write(" ", 1);
+    appendNumber(coordinate->y, writer);
     if(outputDimension == 3) {
-        writer->write(" ");
+        writer->write(" ", 1);
         if(std::isnan(coordinate->z)) {
-            writer->write(writeNumber(0.0));
+            appendNumber(0.0, writer);
         }
         else {
-            writer->write(writeNumber(coordinate->z));
+            appendNumber(coordinate->z, writer);
         }
     }
 }
@@ -359,15 +658,27 @@ WKTWriter::appendCoordinate(const Coordinate* coordinate,
 string
 WKTWriter::writeNumber(double d)
 {
+    Writer w;
+    appendNumber(d, &w);
+    return w.toString();
+}
 
-    std::stringstream ss;
-
-    if(! trim) {
-        ss << std::fixed;
+/* protected */
+void
+WKTWriter::appendNumber(double d, Writer* writer)
+{
+    // Same output as streaming d with std::setprecision(precision),
+    // and std::fixed unless trimming, in the C locale
+    int precision = decimalPlaces >= 0 ? decimalPlaces : 0;
+    char buf[128];
+    std::size_t len = trim ? formatGeneral(d, precision, buf)
+                      : formatFixed(d, precision, buf);
+    if(len > 0) {
+        writer->write(buf, len);
+    }
+    else {
+        writer->write(formatWithPrintf(d, precision, trim));
     }
-    ss << std::setprecision(decimalPlaces >= 0 ? decimalPlaces : 0) << d;
-
-    return ss.str();
 }
 
 void
@@ -0,0 +1,333 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * Copyright (C) 2016 Vivid Solutions Inc.
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Last port: math/DD.java (JTS-1.16)
+ *
+ **********************************************************************/
+
+#include <geos/math/DD.h>
+
+#include <cmath>
+
+namespace geos {
+namespace math { // geos::math
+
+/* public */
+bool
+DD::isNaN() const
+{
+    return std::isnan(hi);
+}
+
+/* public */
+void
+DD::selfAdd(double y)
+{
+    double H, h, S, s, e, f;
+    S = hi + y;
+    e = S - hi;
+    s = S - e;
+    s = (y - e) + (hi - s);
+    f = s + lo;
+    H = S + f;
+    h = f + (S - H);
+    hi = H + h;
+    lo = h + (H - hi);
+}
+
+/* public */
+void
+DD::selfAdd(double yhi, double ylo)
+{
+    double H, h, T, t, S, s, e, f;
+    S = hi + yhi;
+    T = lo + ylo;
+    e = S - hi;
+    f = T - lo;
+    s = S - e;
+    t = T - f;
+    s = (yhi - e) + (hi - s);
+    t = (ylo - f) + (lo - t);
+    e = s + T;
+    H = S + e;
+    h = e + (S - H);
+    e = t + h;
+
+    double zhi = H + e;
+    double zlo = e + (H - zhi);
+    hi = zhi;
+    lo = zlo;
+}
+
+/* public */
+void
+DD::selfAdd(const DD& y)
+{
+    selfAdd(y.hi, y.lo);
+}
+
+/* public */
+void
+DD::selfSubtract(double y)
+{
+    selfAdd(-y);
+}
+
+/* public */
+void
+DD::selfSubtract(double yhi, double ylo)
+{
+    selfAdd(-yhi, -ylo);
+}
+
+/* public */
+void
+DD::selfSubtract(const DD& y)
+{
+    selfAdd(-y.hi, -y.lo);
+}
+
+/* public */
+void
+DD::selfMultiply(double yhi, double ylo)
+{
+    double hx, tx, hy, ty, C, c;
+    C = SPLIT * hi;
+    hx = C - hi;
+    c = SPLIT * yhi;
+    hx = C - hx;
+    tx = hi - hx;
+    hy = c - yhi;
+    C = hi * yhi;
+    hy = c - hy;
+    ty = yhi - hy;
+    c = ((((hx * hy - C) + hx * ty) + tx * hy) + tx * ty) + (hi * ylo + lo * yhi);
+
+    double zhi = C + c;
+    hx = C - zhi;
+    double zlo = c + hx;
+    hi = zhi;
+    lo = zlo;
+}
+
+/* public */
+void
+DD::selfMultiply(double y)
+{
+    selfMultiply(y, 0.0);
+}
+
+/* public */
+void
+DD::selfMultiply(const DD& y)
+{
+    selfMultiply(y.hi, y.lo);
+}
+
+/* public */
+void
+DD::selfDivide(double yhi, double ylo)
+{
+    double hc, tc, hy, ty, C, c, U, u;
+    C = hi / yhi;
+    c = SPLIT * C;
+    hc = c - C;
+    u = SPLIT * yhi;
+    hc = c - hc;
+    tc = C - hc;
+    hy = u - yhi;
+    U = C * yhi;
+    hy = u - hy;
+    ty = yhi - hy;
+    u = (((hc * hy - U) + hc * ty) + tc * hy) + tc * ty;
+    c = ((((hi - U) - u) + lo) - C * ylo) / yhi;
+    u = C + c;
+
+    hi = u;
+    lo = (C - u) + c;
+}
+
+/* public */
+void
+DD::selfDivide(double y)
+{
+    selfDivide(y, 0.0);
+}
+
+/* public */
+void
+DD::selfDivide(const DD& y)
+{
+    selfDivide(y.hi, y.lo);
+}
+
+/* public */
+DD
+DD::reciprocal() const
+{
+    double hc, tc, hy, ty, C, c, U, u;
+    C = 1.0 / hi;
+    c = SPLIT * C;
+    hc = c - C;
+    u = SPLIT * hi;
+    hc = c - hc;
+    tc = C - hc;
+    hy = u - hi;
+    U = C * hi;
+    hy = u - hy;
+    ty = hi - hy;
+    u = (((hc * hy - U) + hc * ty) + tc * hy) + tc * ty;
+    c = ((((1.0 - U) - u)) - C * lo) / hi;
+
+    double zhi = C + c;
+    double zlo = (C - zhi) + c;
+    return DD(zhi, zlo);
+}
+
+/* public static */
+DD
+DD::determinant(const DD& x1, const DD& y1, const DD& x2, const DD& y2)
+{
+    return (x1 * y2) - (y1 * x2);
+}
+
+/* public static */
+DD
+DD::determinant(double x1, double y1, double x2, double y2)
+{
+    return determinant(DD(x1), DD(y1), DD(x2), DD(y2));
+}
+
+DD&
+DD::operator+=(const DD& d)
+{
+    selfAdd(d);
+    return *this;
+}
+
+DD&
+DD::operator+=(double d)
+{
+    selfAdd(d);
+    return *this;
+}
+
+DD&
+DD::operator-=(const DD& d)
+{
+    selfSubtract(d);
+    return *this;
+}
+
+DD&
+DD::operator-=(double d)
+{
+    selfSubtract(d);
+    return *this;
+}
+
+DD&
+DD::operator*=(const DD& d)
+{
+    selfMultiply(d);
+    return *this;
+}
+
+DD&
+DD::operator*=(double d)
+{
+    selfMultiply(d);
+    return *this;
+}
+
+DD&
+DD::operator/=(const DD& d)
+{
+    selfDivide(d);
+    return *this;
+}
+
+DD&
+DD::operator/=(double d)
+{
+    selfDivide(d);
+    return *this;
+}
+
+DD
+operator+(const DD& lhs, const DD& rhs)
+{
+    DD rv(lhs);
+    rv.selfAdd(rhs);
+    return rv;
+}
+
+DD
+operator+(const DD& lhs, double rhs)
+{
+    DD rv(lhs);
+    rv.selfAdd(rhs);
+    return rv;
+}
+
+DD
+operator-(const DD& lhs, const DD& rhs)
+{
+    DD rv(lhs);
+    rv.selfSubtract(rhs);
+    return rv;
+}
+
+DD
+operator-(const DD& lhs, double rhs)
+{
+    DD rv(lhs);
+    rv.selfSubtract(rhs);
+    return rv;
+}
+
+DD
+operator*(const DD& lhs, const DD& rhs)
+{
+    DD rv(lhs);
+    rv.selfMultiply(rhs);
+    return rv;
+}
+
+DD
+operator*(const DD& lhs, double rhs)
+{
+    DD rv(lhs);
+    rv.selfMultiply(rhs);
+    return rv;
+}
+
+DD
+operator/(const DD& lhs, const DD& rhs)
+{
+    DD rv(lhs);
+    rv.selfDivide(rhs);
+    return rv;
+}
+
+DD
+operator/(const DD& lhs, double rhs)
+{
+    DD rv(lhs);
+    rv.selfDivide(rhs);
+    return rv;
+}
+
+} // namespace geos::math
+} // namespace geos
@@ -82,10 +82,20 @@ GeometryNoder::node(const geom::Geometry& geom)
     return noder.getNoded();
 }
 
+/* public static */
+std::unique_ptr<geom::Geometry>
+GeometryNoder::node(const geom::Geometry& geom, unsigned int numThreads)
+{
+    GeometryNoder noder(geom);
+    noder.setNumThreads(numThreads);
+    return noder.getNoded();
+}
+
 /* public */
 GeometryNoder::GeometryNoder(const geom::Geometry& g)
     :
-    argGeom(g)
+    argGeom(g),
+    numThreads(1)
 {
 }
 
@@ -174,6 +184,7 @@ GeometryNoder::getNoder()
 #else
 
         IteratedNoder* in = new IteratedNoder(pm);
+        in->setNumThreads(numThreads);
         //in->setMaximumIterations(0);
         noder.reset(in);
 
@@ -17,6 +17,7 @@
  *
  **********************************************************************/
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -42,6 +43,11 @@ void
 IteratedNoder::node(vector<SegmentString*>* segStrings,
                     int* numInteriorIntersections)
 {
+    if(numThreads > 1) {
+        nodeParallel(segStrings, numInteriorIntersections);
+        return;
+    }
+
     IntersectionAdder si(li);
     MCIndexNoder noder;
     noder.setSegmentIntersector(&si);
@@ -51,6 +57,31 @@ IteratedNoder::node(vector<SegmentString*>* segStrings,
 //System.out.println("# intersection tests: " + si.numTests);
 }
 
+/* private */
+void
+IteratedNoder::nodeParallel(vector<SegmentString*>* segStrings,
+                            int* numInteriorIntersections)
+{
+    // IntersectionAdder keeps state in its LineIntersector
+    vector<unique_ptr<algorithm::LineIntersector>> lis;
+    vector<unique_ptr<IntersectionAdder>> adders;
+    vector<SegmentIntersector*> intersectors;
+    for(unsigned int i = 0; i < numThreads; ++i) {
+        lis.emplace_back(new algorithm::LineIntersector(pm));
+        adders.emplace_back(new IntersectionAdder(*lis.back()));
+        intersectors.push_back(adders.back().get());
+    }
+
+    MCIndexNoder noder;
+    noder.setSegmentIntersectors(intersectors);
+    noder.computeNodes(segStrings);
+    nodedSegStrings = noder.getNodedSubstrings();
+    *numInteriorIntersections = 0;
+    for(auto& si : adders) {
+        *numInteriorIntersections += si->numInteriorIntersections;
+    }
+}
+
 /* public */
 void
 IteratedNoder::computeNodes(SegmentString::NonConstVect* segStrings)
@@ -21,11 +21,16 @@
 #include <geos/noding/NodedSegmentString.h>
 #include <geos/index/chain/MonotoneChain.h>
 #include <geos/index/chain/MonotoneChainBuilder.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
 #include <geos/util/Interrupt.h>
 
 #include <cassert>
+#include <exception>
 #include <functional>
 #include <algorithm>
+#include <system_error>
+#include <thread>
 
 #ifndef GEOS_DEBUG
 #define GEOS_DEBUG 0
@@ -51,7 +56,12 @@ MCIndexNoder::computeNodes(SegmentString::NonConstVect* inputSegStrings)
     for_each(nodedSegStrings->begin(), nodedSegStrings->end(),
              bind1st(mem_fun(&MCIndexNoder::add), this));
 
-    intersectChains();
+    if(threadSegInts.empty()) {
+        intersectChains();
+    }
+    else {
+        intersectChainsParallel();
+    }
 //cerr<<"MCIndexNoder: # chain overlaps = "<<nOverlaps<<endl;
 }
 
@@ -101,6 +111,129 @@ MCIndexNoder::intersectChains()
     }
 }
 
+/*private*/
+void
+MCIndexNoder::intersectChainsParallel()
+{
+    // Number of query chains a thread takes at once, and
+    // whose nodes are buffered together
+    static const size_t batchSize = 256;
+
+    // The tree is built, and its node bounds computed, lazily by the
+    // queries: visit it all before it is shared
+    geom::Envelope extent;
+    for(MonotoneChain* mc : monoChains) {
+        extent.expandToInclude(&(mc->getEnvelope()));
+    }
+    vector<void*> allChains;
+    index.query(&extent, allChains);
+
+    // The threads read the coordinates of the segment strings, whose
+    // sequences may build caches on first access (the dimension, the
+    // Coordinate mirror of a PackedCoordinateSequence): build them now
+    for(SegmentString* ss : *nodedSegStrings) {
+        const geom::CoordinateSequence* pts = ss->getCoordinates();
+        pts->getDimension();
+        if(!pts->isEmpty()) {
+            pts->getAt(0);
+        }
+    }
+
+    const size_t nChains = monoChains.size();
+    const size_t nBatches = (nChains + batchSize - 1) / batchSize;
+    vector<NodedSegmentString::NodeBuffer> buffers(nBatches);
+    vector<int> overlapCounts(threadSegInts.size(), 0);
+    vector<exception_ptr> errors(threadSegInts.size());
+    atomic<size_t> nextBatch(0);
+    atomic<bool> done(false);
+
+    auto run = [&](size_t t) {
+        try {
+            SegmentIntersector& si = *threadSegInts[t];
+            for(size_t b = nextBatch++; b < nBatches && !done; b = nextBatch++) {
+                NodedSegmentString::NodeBuffer::Scope bufferScope(buffers[b]);
+                size_t begin = b * batchSize;
+                overlapCounts[t] += intersectChains(begin,
+                                                    std::min(begin + batchSize, nChains), si, done);
+            }
+        }
+        catch(...) {
+            errors[t] = current_exception();
+            done = true;
+        }
+    };
+
+    vector<thread> workers;
+    // workers honour the interruption state of the calling thread
+    util::InterruptState* interruptState = util::Interrupt::currentState();
+    // the last intersector is used by the calling thread
+    for(size_t t = 0; t + 1 < threadSegInts.size(); ++t) {
+        try {
+            workers.emplace_back([run, t, interruptState]() {
+                util::Interrupt::Scope interruptScope(interruptState, false);
+                run(t);
+            });
+        }
+        catch(const system_error&) {
+            // run with fewer threads
+            break;
+        }
+    }
+    run(threadSegInts.size() - 1);
+
+    for(thread& w : workers) {
+        w.join();
+    }
+
+    for(exception_ptr& e : errors) {
+        if(e) {
+            rethrow_exception(e);
+        }
+    }
+
+    for(int n : overlapCounts) {
+        nOverlaps += n;
+    }
+    for(NodedSegmentString::NodeBuffer& buffer : buffers) {
+        buffer.flush();
+    }
+}
+
+/*private*/
+int
+MCIndexNoder::intersectChains(size_t begin, size_t end,
+                              SegmentIntersector& si, atomic<bool>& done)
+{
+    SegmentOverlapAction overlapAction(si);
+    vector<void*> overlapChains;
+    int count = 0;
+
+    for(size_t i = begin; i < end; ++i) {
+
+        GEOS_CHECK_FOR_INTERRUPTS();
+
+        MonotoneChain* queryChain = monoChains[i];
+        overlapChains.clear();
+        index.query(&(queryChain->getEnvelope()), overlapChains);
+        for(void* item : overlapChains) {
+            MonotoneChain* testChain = static_cast<MonotoneChain*>(item);
+            if(testChain->getId() > queryChain->getId()) {
+                queryChain->computeOverlaps(testChain, &overlapAction);
+                count++;
+            }
+
+            // short-circuit if possible
+            if(si.isDone()) {
+                done = true;
+            }
+            if(done) {
+                return count;
+            }
+        }
+    }
+    return count;
+}
+
 /*private*/
 void
 MCIndexNoder::add(SegmentString* segStr)
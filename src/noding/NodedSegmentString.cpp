@@ -29,6 +29,13 @@ using namespace geos::geom;
 namespace geos {
 namespace noding { // geos::noding
 
+namespace {
+
+// Buffer receiving the nodes added on the current thread, if any
+thread_local NodedSegmentString::NodeBuffer* threadNodeBuffer = nullptr;
+
+}
+
 const SegmentNodeList&
 NodedSegmentString::getNodeList() const
 {
@@ -109,6 +116,12 @@ NodedSegmentString::addIntersection(const Coordinate& intPt,
         }
     }
 
+    if(threadNodeBuffer) {
+        NodeBuffer::Node node = { this, intPt, normalizedSegmentIndex };
+        threadNodeBuffer->nodes.push_back(node);
+        return;
+    }
+
     /*
      * Add the intersection point to edge intersection list
      * (unless the node is already known)
@@ -179,5 +192,28 @@ NodedSegmentString::print(std::ostream& os) const
 }
 
 
+NodedSegmentString::NodeBuffer::Scope::Scope(NodeBuffer& buffer)
+    :
+    previous(threadNodeBuffer)
+{
+    threadNodeBuffer = &buffer;
+}
+
+NodedSegmentString::NodeBuffer::Scope::~Scope()
+{
+    threadNodeBuffer = previous;
+}
+
+/*public*/
+void
+NodedSegmentString::NodeBuffer::flush()
+{
+    for(const Node& node : nodes) {
+        node.segStr->nodeList.add(node.pt, node.segmentIndex);
+    }
+    nodes.clear();
+}
+
+
 } // geos::noding
 } // geos
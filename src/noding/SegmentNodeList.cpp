@@ -17,8 +17,8 @@
  *
  **********************************************************************/
 
+#include <algorithm>
 #include <cassert>
-#include <set>
 
 #include <geos/profiler.h>
 #include <geos/util/GEOSException.h>
@@ -50,30 +50,42 @@ static Profiler* profiler = Profiler::instance();
 
 SegmentNodeList::~SegmentNodeList()
 {
-    std::set<SegmentNode*, SegmentNodeLT>::iterator it = nodeMap.begin();
-    for(; it != nodeMap.end(); it++) {
-        delete *it;
-    }
 }
 
-SegmentNode*
+void
 SegmentNodeList::add(const Coordinate& intPt, size_t segmentIndex)
 {
-    SegmentNode* eiNew = new SegmentNode(edge, intPt, segmentIndex,
-                                         edge.getSegmentOctant(segmentIndex));
-
-    std::pair<SegmentNodeList::iterator, bool> p = nodeMap.insert(eiNew);
-    if(p.second) {    // new SegmentNode inserted
-        return eiNew;
+    // the same node is often reported several times in a row
+    if(!nodeMap.empty() && nodeMap.back().segmentIndex == segmentIndex
+            && nodeMap.back().coord.equals2D(intPt)) {
+        return;
     }
-    else {
+    nodeMap.emplace_back(edge, intPt, segmentIndex,
+                         edge.getSegmentOctant(segmentIndex));
+    ready = false;
 
-        // sanity check
-        assert(eiNew->coord.equals2D(intPt));
+    // bound the duplicates kept between two ordered accesses
+    if(nodeMap.size() >= 2 * std::max<size_t>(preparedSize, 16)) {
+        prepare();
+    }
+}
 
-        delete eiNew;
-        return *(p.first);
+/* private */
+void
+SegmentNodeList::prepare() const
+{
+    if(ready) {
+        return;
     }
+
+    // stable, so that the first node added survives deduplication
+    std::stable_sort(nodeMap.begin(), nodeMap.end());
+    nodeMap.erase(std::unique(nodeMap.begin(), nodeMap.end(),
+    [](const SegmentNode & a, const SegmentNode & b) {
+        return a.compareTo(b) == 0;
+    }), nodeMap.end());
+    ready = true;
+    preparedSize = nodeMap.size();
 }
 
 void
@@ -132,11 +144,11 @@ SegmentNodeList::findCollapsesFromInsertedNodes(
 
     // there should always be at least two entries in the list,
     // since the endpoints are nodes
-    iterator it = begin();
-    SegmentNode* eiPrev = *it;
+    const_iterator it = begin();
+    const SegmentNode* eiPrev = &*it;
     ++it;
-    for(iterator itEnd = end(); it != itEnd; ++it) {
-        SegmentNode* ei = *it;
+    for(const_iterator itEnd = end(); it != itEnd; ++it) {
+        const SegmentNode* ei = &*it;
         bool isCollapsed = findCollapseIndex(*eiPrev, *ei,
                                              collapsedVertexIndex);
         if(isCollapsed) {
@@ -149,7 +161,7 @@ SegmentNodeList::findCollapsesFromInsertedNodes(
 
 /* private */
 bool
-SegmentNodeList::findCollapseIndex(SegmentNode& ei0, SegmentNode& ei1,
+SegmentNodeList::findCollapseIndex(const SegmentNode& ei0, const SegmentNode& ei1,
                                    size_t& collapsedVertexIndex)
 {
     assert(ei1.segmentIndex >= ei0.segmentIndex);
@@ -191,13 +203,11 @@ SegmentNodeList::addSplitEdges(std::vector<SegmentString*>& edgeList)
 
     // there should always be at least two entries in the list
     // since the endpoints are nodes
-    iterator it = begin();
-    SegmentNode* eiPrev = *it;
-    assert(eiPrev);
+    const_iterator it = begin();
+    const SegmentNode* eiPrev = &*it;
     it++;
-    for(iterator itEnd = end(); it != itEnd; ++it) {
-        SegmentNode* ei = *it;
-        assert(ei);
+    for(const_iterator itEnd = end(); it != itEnd; ++it) {
+        const SegmentNode* ei = &*it;
 
         if(! ei->compareTo(*eiPrev)) {
             continue;
@@ -247,7 +257,7 @@ SegmentNodeList::checkSplitEdgesCorrectness(std::vector<SegmentString*>& splitEd
 
 /*private*/
 SegmentString*
-SegmentNodeList::createSplitEdge(SegmentNode* ei0, SegmentNode* ei1)
+SegmentNodeList::createSplitEdge(const SegmentNode* ei0, const SegmentNode* ei1)
 {
     assert(ei0);
     assert(ei1);
@@ -296,15 +306,10 @@ SegmentNodeList::createSplitEdge(SegmentNode* ei0, SegmentNode* ei1)
 std::ostream&
 operator<< (std::ostream& os, const SegmentNodeList& nlist)
 {
-    os << "Intersections: (" << nlist.nodeMap.size() << "):" << std::endl;
-
-    std::set<SegmentNode*, SegmentNodeLT>::const_iterator
-    it = nlist.nodeMap.begin(),
-    itEnd = nlist.nodeMap.end();
+    os << "Intersections: (" << nlist.size() << "):" << std::endl;
 
-    for(; it != itEnd; it++) {
-        SegmentNode* ei = *it;
-        os << " " << *ei;
+    for(const SegmentNode& ei : nlist) {
+        os << " " << ei;
     }
     return os;
 }
@@ -38,7 +38,8 @@ namespace operation { // geos.operation
 GeometryGraphOperation::GeometryGraphOperation(const Geometry* g0,
         const Geometry* g1)
     :
-    arg(2)
+    arg(2),
+    ownArg0(true)
 {
     const PrecisionModel* pm0 = g0->getPrecisionModel();
     assert(pm0);
@@ -64,7 +65,8 @@ GeometryGraphOperation::GeometryGraphOperation(const Geometry* g0,
         const Geometry* g1,
         const algorithm::BoundaryNodeRule& boundaryNodeRule)
     :
-    arg(2)
+    arg(2),
+    ownArg0(true)
 {
     const PrecisionModel* pm0 = g0->getPrecisionModel();
     assert(pm0);
@@ -85,8 +87,34 @@ GeometryGraphOperation::GeometryGraphOperation(const Geometry* g0,
 }
 
 
+GeometryGraphOperation::GeometryGraphOperation(GeometryGraph* g0,
+        const Geometry* g1)
+    :
+    arg(2),
+    ownArg0(false)
+{
+    const PrecisionModel* pm0 = g0->getGeometry()->getPrecisionModel();
+    assert(pm0);
+
+    const PrecisionModel* pm1 = g1->getPrecisionModel();
+    assert(pm1);
+
+    // use the most precise model for the result
+    if(pm0->compareTo(pm1) >= 0) {
+        setComputationPrecision(pm0);
+    }
+    else {
+        setComputationPrecision(pm1);
+    }
+
+    arg[0] = g0;
+    arg[1] = new GeometryGraph(1, g1,
+                               algorithm::BoundaryNodeRule::getBoundaryOGCSFS());
+}
+
 GeometryGraphOperation::GeometryGraphOperation(const Geometry* g0):
-    arg(1)
+    arg(1),
+    ownArg0(true)
 {
     const PrecisionModel* pm0 = g0->getPrecisionModel();
     assert(pm0);
@@ -114,7 +142,7 @@ GeometryGraphOperation::setComputationPrecision(const PrecisionModel* pm)
 
 GeometryGraphOperation::~GeometryGraphOperation()
 {
-    for(unsigned int i = 0; i < arg.size(); ++i) {
+    for(unsigned int i = ownArg0 ? 0 : 1; i < arg.size(); ++i) {
         delete arg[i];
     }
 }
@@ -194,7 +194,9 @@ LineBuilder::buildLines(OverlayOp::OpCode /* opCode */)
         Edge* e = lineEdgesList[i];
         auto cs = e->getCoordinates()->clone();
 #if COMPUTE_Z
-        propagateZ(cs.get());
+        if(op->isComputingZ()) {
+            propagateZ(cs.get());
+        }
 #endif
         LineString* line = geometryFactory->createLineString(cs.release());
         resultLineList->push_back(line);
@@ -25,6 +25,7 @@
 #include <geos/operation/overlay/PolygonBuilder.h>
 #include <geos/operation/overlay/LineBuilder.h>
 #include <geos/operation/overlay/PointBuilder.h>
+#include <geos/operation/overlay/PreparedOverlay.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/GeometryFactory.h>
@@ -134,6 +135,8 @@ OverlayOp::OverlayOp(const Geometry* g0, const Geometry* g1)
     // this builds graphs in arg[0] and arg[1]
     GeometryGraphOperation(g0, g1),
 
+    prepared(nullptr),
+
     /*
      * Use factory of primary geometry.
      * Note that this does NOT handle mixed-precision arguments
@@ -148,8 +151,44 @@ OverlayOp::OverlayOp(const Geometry* g0, const Geometry* g1)
     resultPointList(nullptr)
 
 {
+    initElevation(g0, g1);
+}
+
+/*private*/
+OverlayOp::OverlayOp(PreparedOverlay& prep, const Geometry* g1)
+
+    :
+
+    // this only builds the graph in arg[1]
+    GeometryGraphOperation(prep.graph.get(), g1),
+
+    prepared(&prep),
+    geomFact(prep.geom.getFactory()),
+    resultGeom(nullptr),
+    graph(OverlayNodeFactory::instance()),
+    resultPolyList(nullptr),
+    resultLineList(nullptr),
+    resultPointList(nullptr)
+
+{
+    initElevation(&prep.geom, g1);
+}
+
+/*private*/
+void
+OverlayOp::initElevation(const Geometry* g0, const Geometry* g1)
+{
+    computeZ = false;
+    elevationMatrix = nullptr;
 
 #if COMPUTE_Z
+    // The Z of 2D inputs is NaN everywhere, so would be the
+    // one interpolated for the result
+    if(g0->getCoordinateDimension() < 3 && g1->getCoordinateDimension() < 3) {
+        return;
+    }
+    computeZ = true;
+
 #if USE_INPUT_AVGZ
     avgz[0] = DoubleNotANumber;
     avgz[1] = DoubleNotANumber;
@@ -424,7 +463,7 @@ OverlayOp::labelIncompleteNode(Node* n, int targetIndex)
 
     // Only do this if input does have Z
     // See https://trac.osgeo.org/geos/ticket/811
-    if(targetGeom->getCoordinateDimension() < 3) {
+    if(! computeZ || targetGeom->getCoordinateDimension() < 3) {
         return;
     }
 
@@ -764,7 +803,10 @@ OverlayOp::computeOverlay(OverlayOp::OpCode opCode)
     GEOS_CHECK_FOR_INTERRUPTS();
 
     // node the input Geometries
-    delete arg[0]->computeSelfNodes(li, false, env);
+    // (a prepared arg[0] is self-noded already)
+    if(! prepared) {
+        delete arg[0]->computeSelfNodes(li, false, env);
+    }
     GEOS_CHECK_FOR_INTERRUPTS();
     delete arg[1]->computeSelfNodes(li, false, env);
 
@@ -775,7 +817,12 @@ OverlayOp::computeOverlay(OverlayOp::OpCode opCode)
     GEOS_CHECK_FOR_INTERRUPTS();
 
     // compute intersections between edges of the two input geometries
-    delete arg[0]->computeEdgeIntersections(arg[1], &li, true, env);
+    if(prepared) {
+        prepared->computeEdgeIntersections(*arg[1], li, env);
+    }
+    else {
+        delete arg[0]->computeEdgeIntersections(arg[1], &li, true, env);
+    }
 
 #if GEOS_DEBUG
     cerr << "OverlayOp::computeOverlay: computed EdgeIntersections" << endl;
@@ -896,7 +943,9 @@ OverlayOp::computeOverlay(OverlayOp::OpCode opCode)
 
 
 #if USE_ELEVATION_MATRIX
-    elevationMatrix->elevate(resultGeom);
+    if(elevationMatrix) {
+        elevationMatrix->elevate(resultGeom);
+    }
 #endif // USE_ELEVATION_MATRIX
 
 }
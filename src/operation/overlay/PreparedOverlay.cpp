@@ -0,0 +1,193 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/overlay/PreparedOverlay.h>
+#include <geos/algorithm/BoundaryNodeRule.h>
+#include <geos/geom/BinaryOp.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/GeometryGraph.h>
+#include <geos/geomgraph/index/MonotoneChainEdge.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/util/Interrupt.h>
+
+#include <vector>
+
+using namespace geos::geom;
+using namespace geos::geomgraph;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace overlay { // geos.operation.overlay
+
+/*public*/
+PreparedOverlay::PreparedOverlay(const Geometry& g)
+    :
+    geom(g),
+    li(g.getPrecisionModel()),
+    graph(new GeometryGraph(0, &g,
+                            algorithm::BoundaryNodeRule::getBoundaryOGCSFS()))
+{
+    // the whole geometry is self-noded, so the nodes hold
+    // for any overlay envelope
+    delete graph->computeSelfNodes(li, false);
+
+    std::vector<Edge*>* edges = graph->getEdges();
+    selfNodes.reserve(edges->size());
+    isolated.reserve(edges->size());
+    for(Edge* e : *edges) {
+        const EdgeIntersectionList& eiList = e->getEdgeIntersectionList();
+        selfNodes.emplace_back(eiList.begin(), eiList.end());
+        isolated.push_back(e->isIsolated());
+
+        geomgraph::index::MonotoneChainEdge* mce = e->getMonotoneChainEdge();
+        const std::vector<size_t>& startIndex = mce->getStartIndexes();
+        for(size_t i = 0; i + 1 < startIndex.size(); ++i) {
+            Chain chain = { e, mce, i };
+            chains.push_back(chain);
+        }
+    }
+
+    // the envelopes must not move once inserted
+    chainEnvs.reserve(chains.size());
+    for(Chain& chain : chains) {
+        const CoordinateSequence* pts = chain.mce->getCoordinates();
+        const std::vector<size_t>& startIndex = chain.mce->getStartIndexes();
+        chainEnvs.emplace_back(pts->getAt(startIndex[chain.chainIndex]),
+                               pts->getAt(startIndex[chain.chainIndex + 1]));
+        chainIndex.insert(&chainEnvs.back(), &chain);
+    }
+    if(! chains.empty()) {
+        chainIndex.build();
+    }
+
+    // cache them before they are shared by the overlays
+    graph->getBoundaryNodes();
+}
+
+PreparedOverlay::~PreparedOverlay()
+{
+}
+
+/*public*/
+std::unique_ptr<Geometry>
+PreparedOverlay::overlay(const Geometry& other, OverlayOp::OpCode opCode)
+{
+    return BinaryOp(&geom, &other,
+    [this, opCode](const Geometry * g0, const Geometry * g1) {
+        return computeOverlay(g0, g1, opCode);
+    });
+}
+
+/*public*/
+std::unique_ptr<Geometry>
+PreparedOverlay::intersection(const Geometry& other)
+{
+    // special case: if one input is empty ==> empty
+    if(geom.isEmpty() || other.isEmpty()) {
+        return std::unique_ptr<Geometry>(geom.getFactory()->createGeometryCollection());
+    }
+
+    return overlay(other, OverlayOp::opINTERSECTION);
+}
+
+/*public*/
+std::unique_ptr<Geometry>
+PreparedOverlay::difference(const Geometry& other)
+{
+    // special case: if A.isEmpty ==> empty; if B.isEmpty ==> A
+    if(geom.isEmpty()) {
+        return std::unique_ptr<Geometry>(geom.getFactory()->createGeometryCollection());
+    }
+    if(other.isEmpty()) {
+        return geom.clone();
+    }
+
+    return overlay(other, OverlayOp::opDIFFERENCE);
+}
+
+/*private*/
+Geometry*
+PreparedOverlay::computeOverlay(const Geometry* g0, const Geometry* g1,
+                                OverlayOp::OpCode opCode)
+{
+    // The graph is only usable for the prepared geometry itself, not
+    // the snapped copies BinaryOp retries with, and when it was noded
+    // with the precision of the result
+    if(g0 != &geom ||
+            geom.getPrecisionModel()->compareTo(g1->getPrecisionModel()) < 0) {
+        return OverlayOp::overlayOp(g0, g1, opCode);
+    }
+
+    resetGraph();
+    OverlayOp op(*this, g1);
+    return op.getResultGeometry(opCode);
+}
+
+/*private*/
+void
+PreparedOverlay::resetGraph()
+{
+    std::vector<Edge*>* edges = graph->getEdges();
+    for(size_t i = 0, n = edges->size(); i < n; ++i) {
+        Edge* e = (*edges)[i];
+        EdgeIntersectionList& eiList = e->getEdgeIntersectionList();
+        eiList.clear();
+        for(const EdgeIntersection& ei : selfNodes[i]) {
+            eiList.add(ei.coord, ei.segmentIndex, ei.dist);
+        }
+        e->setIsolated(isolated[i]);
+    }
+}
+
+/*private*/
+void
+PreparedOverlay::computeEdgeIntersections(GeometryGraph& other,
+        algorithm::LineIntersector& p_li, const Envelope* env)
+{
+    geomgraph::index::SegmentIntersector si(&p_li, true, true);
+    si.setBoundaryNodes(graph->getBoundaryNodes(), other.getBoundaryNodes());
+
+    std::vector<void*> hits;
+    for(Edge* e : *other.getEdges()) {
+        if(env && ! env->intersects(e->getEnvelope())) {
+            continue;
+        }
+
+        GEOS_CHECK_FOR_INTERRUPTS();
+
+        geomgraph::index::MonotoneChainEdge* mce = e->getMonotoneChainEdge();
+        const CoordinateSequence* pts = mce->getCoordinates();
+        const std::vector<size_t>& startIndex = mce->getStartIndexes();
+        for(size_t i = 0; i + 1 < startIndex.size(); ++i) {
+            Envelope chainEnv(pts->getAt(startIndex[i]),
+                              pts->getAt(startIndex[i + 1]));
+            hits.clear();
+            chainIndex.query(&chainEnv, hits);
+            for(void* hit : hits) {
+                Chain* chain = static_cast<Chain*>(hit);
+                if(env && ! env->intersects(chain->edge->getEnvelope())) {
+                    continue;
+                }
+                chain->mce->computeIntersectsForChain(chain->chainIndex,
+                                                      *mce, i, si);
+            }
+        }
+    }
+}
+
+} // namespace geos.operation.overlay
+} // namespace geos.operation
+} // namespace geos
@@ -0,0 +1,391 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/overlay/snap/SnapRoundingOverlayOp.h>
+#include <geos/operation/valid/RepeatedPointRemover.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/snapround/MCIndexSnapRounder.h>
+#include <geos/precision/GeometryPrecisionReducer.h>
+#include <geos/geom/BinaryOp.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryComponentFilter.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/Polygonal.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/util/IllegalArgumentException.h>
+#include <geos/util/TopologyException.h>
+
+#include <cassert>
+#include <iterator> // for make_move_iterator
+#include <memory> // for unique_ptr
+#include <vector>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace overlay { // geos.operation.overlay
+namespace snap { // geos.operation.overlay.snap
+
+namespace {
+
+/// Collects the non-empty rings and lines of a geometry, in the
+/// order NodedGeometryBuilder takes them back
+class LinearComponentFilter: public GeometryComponentFilter {
+public:
+    vector<const LineString*> lines;
+
+    void
+    filter_ro(const Geometry* g) override
+    {
+        const LineString* line = dynamic_cast<const LineString*>(g);
+        if(line && ! line->isEmpty()) {
+            lines.push_back(line);
+        }
+    }
+};
+
+/// Rebuilds a geometry with the noded coordinates of its rings and
+/// lines, taken in the order of LinearComponentFilter. Collapsed ones
+/// are dropped, along with the holes of a collapsed shell.
+class NodedGeometryBuilder {
+public:
+    NodedGeometryBuilder(const GeometryFactory& p_factory,
+                         vector<unique_ptr<CoordinateSequence>>& p_coords)
+        : factory(p_factory), coords(p_coords), next(0)
+    {}
+
+    Geometry*
+    build(const Geometry* geom)
+    {
+        if(const LinearRing* ring = dynamic_cast<const LinearRing*>(geom)) {
+            CoordinateSequence* cs = takeNoded(ring);
+            return cs ? factory.createLinearRing(cs) : factory.createLinearRing();
+        }
+        if(const LineString* line = dynamic_cast<const LineString*>(geom)) {
+            CoordinateSequence* cs = takeNoded(line);
+            return cs ? factory.createLineString(cs) : factory.createLineString();
+        }
+        if(const Polygon* poly = dynamic_cast<const Polygon*>(geom)) {
+            return buildPolygon(poly);
+        }
+        if(const GeometryCollection* coll = dynamic_cast<const GeometryCollection*>(geom)) {
+            return buildCollection(coll);
+        }
+        return geom->clone().release();
+    }
+
+    /// Removes the parts of a ring folding back on themselves,
+    /// which have no area
+    static unique_ptr<CoordinateSequence>
+    removeSpikes(const CoordinateSequence& ring,
+                 const CoordinateSequenceFactory& csf)
+    {
+        vector<Coordinate> pts;
+        pts.reserve(ring.size());
+        for(size_t i = 0, n = ring.size() - 1; i < n; ++i) {
+            pushVertex(pts, ring.getAt(i));
+        }
+
+        // the ring may also fold back around its start point
+        size_t start = 0;
+        for(;;) {
+            size_t n = pts.size() - start;
+            if(n < 3) {
+                break;
+            }
+            if(pts[pts.size() - 2] == pts[start]) {
+                pts.pop_back();
+                pts.pop_back();
+            }
+            else if(pts.back() == pts[start + 1]) {
+                pts.pop_back();
+                ++start;
+            }
+            else {
+                break;
+            }
+        }
+
+        vector<Coordinate>* closed = new vector<Coordinate>(pts.begin() + start, pts.end());
+        if(! closed->empty()) {
+            closed->push_back(closed->front());
+        }
+        return csf.create(closed);
+    }
+
+    static void
+    pushVertex(vector<Coordinate>& pts, const Coordinate& c)
+    {
+        if(! pts.empty() && pts.back() == c) {
+            return;
+        }
+        pts.push_back(c);
+        // A B A folds back at B
+        while(pts.size() >= 3 && pts[pts.size() - 3] == pts.back()) {
+            pts.pop_back();
+            pts.pop_back();
+        }
+    }
+
+private:
+    /// The noded coordinates of the next ring or line, or null if
+    /// it collapsed
+    CoordinateSequence*
+    takeNoded(const LineString* line)
+    {
+        if(line->isEmpty()) {
+            return nullptr;
+        }
+
+        assert(next < coords.size());
+        unique_ptr<CoordinateSequence> noded(std::move(coords[next++]));
+
+        size_t minLength = 2;
+        if(dynamic_cast<const LinearRing*>(line)) {
+            noded = removeSpikes(*noded, *factory.getCoordinateSequenceFactory());
+            minLength = 4;
+        }
+        if(noded->size() < minLength) {
+            return nullptr;
+        }
+        return noded.release();
+    }
+
+    Geometry*
+    buildPolygon(const Polygon* poly)
+    {
+        // take the coordinates of every ring, even when the shell
+        // collapsed, to stay in step with LinearComponentFilter
+        CoordinateSequence* shellCoords = takeNoded(poly->getExteriorRing());
+        unique_ptr<LinearRing> shell(
+            shellCoords ? factory.createLinearRing(shellCoords) : nullptr);
+        vector<Geometry*>* holes = new vector<Geometry*>;
+        for(size_t i = 0, n = poly->getNumInteriorRing(); i < n; ++i) {
+            CoordinateSequence* holeCoords = takeNoded(poly->getInteriorRingN(i));
+            if(holeCoords) {
+                holes->push_back(factory.createLinearRing(holeCoords));
+            }
+        }
+
+        if(! shell) {
+            for(Geometry* hole : *holes) {
+                delete hole;
+            }
+            delete holes;
+            return factory.createPolygon();
+        }
+        return factory.createPolygon(shell.release(), holes);
+    }
+
+    Geometry*
+    buildCollection(const GeometryCollection* coll)
+    {
+        vector<Geometry*>* geoms = new vector<Geometry*>;
+        for(size_t i = 0, n = coll->getNumGeometries(); i < n; ++i) {
+            Geometry* g = build(coll->getGeometryN(i));
+            if(g->isEmpty()) {
+                delete g;
+                continue;
+            }
+            geoms->push_back(g);
+        }
+
+        switch(coll->getGeometryTypeId()) {
+        case GEOS_MULTIPOINT:
+            return factory.createMultiPoint(geoms);
+        case GEOS_MULTILINESTRING:
+            return factory.createMultiLineString(geoms);
+        case GEOS_MULTIPOLYGON:
+            return factory.createMultiPolygon(geoms);
+        default:
+            return factory.createGeometryCollection(geoms);
+        }
+    }
+
+    const GeometryFactory& factory;
+    vector<unique_ptr<CoordinateSequence>>& coords;
+    size_t next;
+};
+
+} // anonymous namespace
+
+/* public */
+SnapRoundingOverlayOp::SnapRoundingOverlayOp(const Geometry& g0,
+        const Geometry& g1, const PrecisionModel& p_pm)
+    :
+    geom0(g0),
+    geom1(g1),
+    pm(p_pm)
+{
+    if(pm.isFloating()) {
+        throw util::IllegalArgumentException(
+            "SnapRoundingOverlayOp needs a fixed precision model");
+    }
+}
+
+/* public */
+unique_ptr<Geometry>
+SnapRoundingOverlayOp::getResultGeometry(OverlayOp::OpCode opCode)
+{
+    geom::GeomPtrPair prepGeom;
+    bool stable = ! snapRound(geom0, geom1, prepGeom);
+    // fixing a polygon can drop vertices the other input
+    // was noded at, node the fixed ones again until none
+    // needs fixing
+    for(int pass = 1; ! stable && pass < MAX_SNAP_ROUND_PASSES; ++pass) {
+        geom::GeomPtrPair fixedGeom;
+        fixedGeom.first = std::move(prepGeom.first);
+        fixedGeom.second = std::move(prepGeom.second);
+        stable = ! snapRound(*fixedGeom.first, *fixedGeom.second, prepGeom);
+    }
+
+    if(stable) {
+        // the inputs only meet at their vertices now, so there
+        // is nothing the snapping heuristics could improve
+        try {
+            return GeomPtr(OverlayOp::overlayOp(prepGeom.first.get(),
+                                                prepGeom.second.get(), opCode));
+        }
+        catch(const util::TopologyException&) {
+            // rounding collapsed some edges in a way the
+            // fixes did not catch, fall back
+        }
+    }
+
+    return getFallbackResult(opCode);
+}
+
+/* private */
+unique_ptr<Geometry>
+SnapRoundingOverlayOp::getFallbackResult(OverlayOp::OpCode opCode)
+{
+    // Compute the overlay in floating precision, with the
+    // snapping heuristics, and reduce the result to the grid
+    GeomPtr result = geom::BinaryOp(&geom0, &geom1, overlay::overlayOp(opCode));
+    precision::GeometryPrecisionReducer reducer(pm);
+    return reducer.reduce(*result);
+}
+
+/* private */
+bool
+SnapRoundingOverlayOp::snapRound(const Geometry& g0, const Geometry& g1,
+                                 geom::GeomPtrPair& ret)
+{
+    // Snap rounding needs all the input vertices on the grid.
+    // Rounding them can make polygons invalid, this is fixed
+    // once they are noded.
+    precision::GeometryPrecisionReducer reducer(pm);
+    reducer.setPointwise(true);
+    GeomPtr rg0 = reducer.reduce(g0);
+    GeomPtr rg1 = reducer.reduce(g1);
+
+    LinearComponentFilter lines0;
+    rg0->apply_ro(&lines0);
+    LinearComponentFilter lines1;
+    rg1->apply_ro(&lines1);
+
+    // the data of each segment string is its index in segStrings
+    noding::SegmentString::NonConstVect segStrings;
+    for(const LinearComponentFilter* lines : { &lines0, &lines1 }) {
+        for(const LineString* line : lines->lines) {
+            size_t i = segStrings.size();
+            segStrings.push_back(new noding::NodedSegmentString(
+                                     line->getCoordinatesRO()->clone().release(),
+                                     reinterpret_cast<void*>(i)));
+        }
+    }
+
+    vector<unique_ptr<CoordinateSequence>> nodedCoords(segStrings.size());
+    try {
+        noding::snapround::MCIndexSnapRounder noder(pm);
+        noder.computeNodes(&segStrings);
+
+        // the substrings of each segment string come in order,
+        // join them back
+        unique_ptr<noding::SegmentString::NonConstVect> substrings(
+            noder.getNodedSubstrings());
+        vector<vector<Coordinate>> joined(segStrings.size());
+        for(noding::SegmentString* ss : *substrings) {
+            size_t i = reinterpret_cast<size_t>(ss->getData());
+            const CoordinateSequence* pts = ss->getCoordinates();
+            vector<Coordinate>& line = joined[i];
+            for(size_t j = line.empty() ? 0 : 1, n = pts->size(); j < n; ++j) {
+                line.push_back(pts->getAt(j));
+            }
+            delete ss;
+        }
+
+        const CoordinateSequenceFactory* csf =
+            rg0->getFactory()->getCoordinateSequenceFactory();
+        for(size_t i = 0; i < joined.size(); ++i) {
+            unique_ptr<CoordinateSequence> cs(
+                csf->create(new vector<Coordinate>(std::move(joined[i]))));
+            nodedCoords[i] = valid::RepeatedPointRemover::removeRepeatedPoints(cs.get());
+        }
+    }
+    catch(...) {
+        for(noding::SegmentString* ss : segStrings) {
+            delete ss;
+        }
+        throw;
+    }
+    for(noding::SegmentString* ss : segStrings) {
+        delete ss;
+    }
+
+    // the noded coordinates of the second input follow those of the first
+    vector<unique_ptr<CoordinateSequence>> nodedCoords1(
+        std::make_move_iterator(nodedCoords.begin() + lines0.lines.size()),
+        std::make_move_iterator(nodedCoords.end()));
+    nodedCoords.resize(lines0.lines.size());
+    NodedGeometryBuilder builder0(*rg0->getFactory(), nodedCoords);
+    GeomPtr sg0(builder0.build(rg0.get()));
+    NodedGeometryBuilder builder1(*rg1->getFactory(), nodedCoords1);
+    GeomPtr sg1(builder1.build(rg1.get()));
+
+    bool fixed = false;
+    ret.first = fixTopology(std::move(sg0), fixed);
+    ret.second = fixTopology(std::move(sg1), fixed);
+    return fixed;
+}
+
+/* private static */
+unique_ptr<Geometry>
+SnapRoundingOverlayOp::fixTopology(GeomPtr geom, bool& fixed)
+{
+    if(! dynamic_cast<const Polygonal*>(geom.get()) || geom->isValid()) {
+        return geom;
+    }
+
+    // The rings are noded and folds are removed, so they can only
+    // touch, overlap each other or be inverted. Buffering by zero
+    // keeps the area they wind around positively and, with no
+    // intersection to compute, does it robustly.
+    fixed = true;
+    return geom->buffer(0);
+}
+
+} // namespace geos.operation.overlay.snap
+} // namespace geos.operation.overlay
+} // namespace geos.operation
+} // namespace geos
@@ -63,17 +63,17 @@ EdgeEndBuilder::computeEdgeEnds(Edge* edge, vector<EdgeEnd*>* l)
         return;
     }
 
-    EdgeIntersection* eiPrev = nullptr;
-    EdgeIntersection* eiCurr = nullptr;
+    const EdgeIntersection* eiPrev = nullptr;
+    const EdgeIntersection* eiCurr = nullptr;
 
-    EdgeIntersection* eiNext = *it;
+    const EdgeIntersection* eiNext = &*it;
     it++;
     do {
         eiPrev = eiCurr;
         eiCurr = eiNext;
         eiNext = nullptr;
         if(it != eiList.end()) {
-            eiNext = *it;
+            eiNext = &*it;
             it++;
         }
         if(eiCurr != nullptr) {
@@ -94,7 +94,7 @@ EdgeEndBuilder::computeEdgeEnds(Edge* edge, vector<EdgeEnd*>* l)
  */
 void
 EdgeEndBuilder::createEdgeEndForPrev(Edge* edge, vector<EdgeEnd*>* l,
-                                     EdgeIntersection* eiCurr, EdgeIntersection* eiPrev)
+                                     const EdgeIntersection* eiCurr, const EdgeIntersection* eiPrev)
 {
     auto iPrev = eiCurr->segmentIndex;
     if(eiCurr->dist == 0.0) {
@@ -127,7 +127,7 @@ EdgeEndBuilder::createEdgeEndForPrev(Edge* edge, vector<EdgeEnd*>* l,
  */
 void
 EdgeEndBuilder::createEdgeEndForNext(Edge* edge, vector<EdgeEnd*>* l,
-                                     EdgeIntersection* eiCurr, EdgeIntersection* eiNext)
+                                     const EdgeIntersection* eiCurr, const EdgeIntersection* eiNext)
 {
     size_t iNext = eiCurr->segmentIndex + 1;
     // if there is no next edge there is nothing to do
@@ -351,7 +351,7 @@ RelateComputer::computeIntersectionNodes(int argIndex)
         EdgeIntersectionList::iterator it = eiL.begin();
         EdgeIntersectionList::iterator end = eiL.end();
         for(; it != end; ++it) {
-            EdgeIntersection* ei = *it;
+            const EdgeIntersection* ei = &*it;
             assert(dynamic_cast<RelateNode*>(nodes.addNode(ei->coord)));
             RelateNode* n = static_cast<RelateNode*>(nodes.addNode(ei->coord));
             if(eLoc == Location::BOUNDARY) {
@@ -385,7 +385,7 @@ RelateComputer::labelIntersectionNodes(int argIndex)
         EdgeIntersectionList::iterator eiEnd = eiL.end();
 
         for(; eiIt != eiEnd; ++eiIt) {
-            EdgeIntersection* ei = *eiIt;
+            const EdgeIntersection* ei = &*eiIt;
             RelateNode* n = (RelateNode*) nodes.find(ei->coord);
             if(n->getLabel().isNull(argIndex)) {
                 if(eLoc == Location::BOUNDARY) {
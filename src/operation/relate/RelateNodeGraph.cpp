@@ -102,7 +102,7 @@ RelateNodeGraph::computeIntersectionNodes(GeometryGraph* geomGraph,
         EdgeIntersectionList::iterator eiIt = eiL.begin();
         EdgeIntersectionList::iterator eiEnd = eiL.end();
         for(; eiIt != eiEnd; ++eiIt) {
-            EdgeIntersection* ei = *eiIt;
+            const EdgeIntersection* ei = &*eiIt;
             RelateNode* n = (RelateNode*) nodes->addNode(ei->coord);
             if(eLoc == Location::BOUNDARY) {
                 n->setLabelBoundary(argIndex);
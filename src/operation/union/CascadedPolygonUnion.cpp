@@ -27,15 +27,24 @@
 #include <geos/geom/util/PolygonExtracter.h>
 #include <geos/index/strtree/STRtree.h>
 // std
+#include <algorithm>
 #include <cassert>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <sstream>
+#include <system_error>
 
 #include <geos/operation/valid/IsValidOp.h>
 #include <geos/operation/IsSimpleOp.h>
 #include <geos/algorithm/BoundaryNodeRule.h>
+#include <geos/util/Interrupt.h>
 #include <geos/util/TopologyException.h>
 #include <string>
 #include <iomanip>
@@ -104,6 +113,131 @@ GeometryListHolder::deleteItem(geom::Geometry* item)
     delete item;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/**
+ * A fixed set of worker threads running the tasks queued by
+ * CascadedPolygonUnion::runTasks.
+ *
+ * A thread waiting for a task no worker has started runs it itself,
+ * so a task forking more tasks never waits for a free worker.
+ */
+class UnionTaskQueue {
+public:
+
+    struct Task {
+        std::function<void()>* fn;
+        std::exception_ptr error;
+        enum { QUEUED, RUNNING, DONE } state;
+    };
+
+    /// Starts up to numWorkers threads, in the interruption state
+    /// of the calling thread
+    explicit UnionTaskQueue(std::size_t numWorkers)
+        : stopping(false)
+    {
+        util::InterruptState* interruptState = util::Interrupt::currentState();
+        try {
+            for(std::size_t i = 0; i < numWorkers; ++i) {
+                workers.emplace_back([this, interruptState]() {
+                    util::Interrupt::Scope interruptScope(interruptState, false);
+                    work();
+                });
+            }
+        }
+        catch(const std::system_error&) {
+            // make do with the workers started
+        }
+    }
+
+    ~UnionTaskQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for(std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    bool
+    hasWorkers() const
+    {
+        return !workers.empty();
+    }
+
+    void
+    push(Task& task)
+    {
+        task.state = Task::QUEUED;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(&task);
+        }
+        workAvailable.notify_one();
+    }
+
+    /// Returns once task is done, running it if no worker started it
+    void
+    wait(Task& task)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if(task.state == Task::QUEUED) {
+            queue.erase(std::find(queue.begin(), queue.end(), &task));
+            lock.unlock();
+            run(task);
+            return;
+        }
+        taskDone.wait(lock, [&task]() {
+            return task.state == Task::DONE;
+        });
+    }
+
+    static void
+    run(Task& task)
+    {
+        try {
+            (*task.fn)();
+        }
+        catch(...) {
+            task.error = std::current_exception();
+        }
+    }
+
+private:
+
+    void
+    work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for(;;) {
+            workAvailable.wait(lock, [this]() {
+                return stopping || !queue.empty();
+            });
+            if(queue.empty()) {
+                return;
+            }
+            // the oldest tasks are the largest branches
+            Task* task = queue.front();
+            queue.pop_front();
+            task->state = Task::RUNNING;
+            lock.unlock();
+            run(*task);
+            lock.lock();
+            task->state = Task::DONE;
+            taskDone.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable taskDone;
+    std::deque<Task*> queue;
+    bool stopping;
+    std::vector<std::thread> workers;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 geom::Geometry*
 CascadedPolygonUnion::Union(std::vector<geom::Polygon*>* polys)
@@ -112,6 +246,14 @@ CascadedPolygonUnion::Union(std::vector<geom::Polygon*>* polys)
     return op.Union();
 }
 
+geom::Geometry*
+CascadedPolygonUnion::Union(std::vector<geom::Polygon*>* polys,
+                            std::size_t numThreads)
+{
+    CascadedPolygonUnion op(polys, numThreads);
+    return op.Union();
+}
+
 geom::Geometry*
 CascadedPolygonUnion::Union(const geom::MultiPolygon* multipoly)
 {
@@ -136,6 +278,15 @@ CascadedPolygonUnion::Union()
 
     geomFactory = inputPolys->front()->getFactory();
 
+    // Arena allocation is not thread-safe
+    std::unique_ptr<UnionTaskQueue> queue;
+    if(numThreads > 1 && geomFactory->getArena() == nullptr) {
+        queue.reset(new UnionTaskQueue(numThreads - 1));
+        if(queue->hasWorkers()) {
+            taskQueue = queue.get();
+        }
+    }
+
     /**
      * A spatial index to organize the collection
      * into groups of close geometries.
@@ -153,7 +304,16 @@ CascadedPolygonUnion::Union()
 
     std::unique_ptr<index::strtree::ItemsList> itemTree(index.itemsTree());
 
-    return unionTree(itemTree.get());
+    geom::Geometry* result;
+    try {
+        result = unionTree(itemTree.get());
+    }
+    catch(...) {
+        taskQueue = nullptr;
+        throw;
+    }
+    taskQueue = nullptr;
+    return result;
 }
 
 geom::Geometry*
@@ -187,8 +347,13 @@ CascadedPolygonUnion::binaryUnion(GeometryListHolder* geoms,
     else {
         // recurse on both halves of the list
         std::size_t mid = (end + start) / 2;
-        std::unique_ptr<geom::Geometry> g0(binaryUnion(geoms, start, mid));
-        std::unique_ptr<geom::Geometry> g1(binaryUnion(geoms, mid, end));
+        std::unique_ptr<geom::Geometry> g0;
+        std::unique_ptr<geom::Geometry> g1;
+        std::vector<std::function<void()>> tasks {
+            [&]() { g0.reset(binaryUnion(geoms, start, mid)); },
+            [&]() { g1.reset(binaryUnion(geoms, mid, end)); }
+        };
+        runTasks(tasks);
         return unionSafe(g0.get(), g1.get());
     }
 }
@@ -198,16 +363,30 @@ CascadedPolygonUnion::reduceToGeometries(index::strtree::ItemsList* geomTree)
 {
     std::unique_ptr<GeometryListHolder> geoms(new GeometryListHolder());
 
-    typedef index::strtree::ItemsList::iterator iterator_type;
-    iterator_type end = geomTree->end();
-    for(iterator_type i = geomTree->begin(); i != end; ++i) {
-        if((*i).get_type() == index::strtree::ItemsListItem::item_is_list) {
-            std::unique_ptr<geom::Geometry> geom(unionTree((*i).get_itemslist()));
-            geoms->push_back_owned(geom.get());
-            geom.release();
+    // Subtrees are unioned first, possibly concurrently, and their
+    // results are then added in the original order
+    std::size_t n = geomTree->size();
+    std::vector<std::unique_ptr<geom::Geometry>> unioned(n);
+    std::vector<std::function<void()>> tasks;
+    for(std::size_t i = 0; i < n; ++i) {
+        index::strtree::ItemsListItem& item = (*geomTree)[i];
+        if(item.get_type() == index::strtree::ItemsListItem::item_is_list) {
+            index::strtree::ItemsList* subtree = item.get_itemslist();
+            tasks.emplace_back([this, &unioned, i, subtree]() {
+                unioned[i].reset(unionTree(subtree));
+            });
         }
-        else if((*i).get_type() == index::strtree::ItemsListItem::item_is_geometry) {
-            geoms->push_back(reinterpret_cast<geom::Geometry*>((*i).get_geometry()));
+    }
+    runTasks(tasks);
+
+    for(std::size_t i = 0; i < n; ++i) {
+        index::strtree::ItemsListItem& item = (*geomTree)[i];
+        if(item.get_type() == index::strtree::ItemsListItem::item_is_list) {
+            geoms->push_back_owned(unioned[i].get());
+            unioned[i].release();
+        }
+        else if(item.get_type() == index::strtree::ItemsListItem::item_is_geometry) {
+            geoms->push_back(reinterpret_cast<geom::Geometry*>(item.get_geometry()));
         }
         else {
             assert(!static_cast<bool>("should never be reached"));
@@ -217,6 +396,39 @@ CascadedPolygonUnion::reduceToGeometries(index::strtree::ItemsList* geomTree)
     return geoms.release();
 }
 
+/* private */
+void
+CascadedPolygonUnion::runTasks(std::vector<std::function<void()>>& tasks)
+{
+    std::vector<UnionTaskQueue::Task> queued(tasks.size());
+    for(std::size_t i = 0; i < tasks.size(); ++i) {
+        queued[i].fn = &tasks[i];
+    }
+
+    if(!taskQueue || queued.size() < 2) {
+        for(UnionTaskQueue::Task& t : queued) {
+            UnionTaskQueue::run(t);
+        }
+    }
+    else {
+        // the last task always runs on the calling thread, then the
+        // last queued ones are the likeliest not to be started yet
+        for(std::size_t i = 0; i + 1 < queued.size(); ++i) {
+            taskQueue->push(queued[i]);
+        }
+        UnionTaskQueue::run(queued.back());
+        for(std::size_t i = queued.size() - 1; i-- > 0;) {
+            taskQueue->wait(queued[i]);
+        }
+    }
+
+    for(UnionTaskQueue::Task& t : queued) {
+        if(t.error) {
+            std::rethrow_exception(t.error);
+        }
+    }
+}
+
 geom::Geometry*
 CascadedPolygonUnion::unionSafe(geom::Geometry* g0, geom::Geometry* g1)
 {
@@ -109,7 +109,7 @@ UnaryUnionOp::Union()
     GeomPtr unionPolygons;
     if(!polygons.empty()) {
         unionPolygons.reset(CascadedPolygonUnion::Union(polygons.begin(),
-                            polygons.end()));
+                            polygons.end(), numThreads));
     }
 
     /**
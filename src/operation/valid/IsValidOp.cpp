@@ -408,7 +408,7 @@ IsValidOp::checkNoSelfIntersectingRing(EdgeIntersectionList& eiList)
     EdgeIntersectionList::iterator it = eiList.begin();
     EdgeIntersectionList::iterator end = eiList.end();
     for(; it != end; ++it) {
-        EdgeIntersection* ei = *it;
+        const EdgeIntersection* ei = &*it;
         if(isFirst) {
             isFirst = false;
             continue;
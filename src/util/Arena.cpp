@@ -0,0 +1,260 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/util/Arena.h>
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace geos {
+namespace util { // geos::util
+
+namespace {
+
+/*
+ * Arena objects start OBJECT_ALIGNMENT bytes past a multiple of
+ * ALIGNMENT, right after the pointer to their arena, while heap objects
+ * start at a multiple of ALIGNMENT. Deleting an object thus finds out
+ * where it came from without a header on heap objects.
+ */
+constexpr std::size_t TAG = Arena::OBJECT_ALIGNMENT;
+
+/// Alignment of every allocation, enough for any fundamental type
+constexpr std::size_t ALIGNMENT =
+    alignof(std::max_align_t) > 2 * TAG ? alignof(std::max_align_t) : 2 * TAG;
+
+static_assert(sizeof(Arena*) <= TAG, "arena pointer does not fit in front of objects");
+
+/// Room for the header of owned objects, keeping them aligned
+constexpr std::size_t OWNED_HEADER_SIZE =
+    (3 * sizeof(void*) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+/// Whether the system allocator returns addresses aligned as heap objects must be
+constexpr bool HEAP_ALIGNED = alignof(std::max_align_t) >= ALIGNMENT;
+
+std::size_t
+alignUp(std::size_t n)
+{
+    return (n + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+char*
+alignUp(char* p)
+{
+    return reinterpret_cast<char*>(alignUp(reinterpret_cast<std::uintptr_t>(p)));
+}
+
+bool
+isArenaObject(const void* p)
+{
+    return (reinterpret_cast<std::uintptr_t>(p) & TAG) != 0;
+}
+
+}
+
+constexpr std::size_t Arena::OBJECT_ALIGNMENT;
+
+Arena::Arena(std::size_t p_blockSize)
+    :
+    current(0),
+    offset(0),
+    blockSize(alignUp(p_blockSize ? p_blockSize : 1)),
+    bytesUsed(0),
+    liveObjects(0),
+    owned(nullptr)
+{
+}
+
+Arena::~Arena()
+{
+    destroyAllOwned();
+    for(Block& b : blocks) {
+        ::operator delete(b.raw);
+    }
+}
+
+void*
+Arena::allocate(std::size_t bytes)
+{
+    bytes = alignUp(bytes ? bytes : 1);
+
+    if(!freeLists.empty()) {
+        auto it = freeLists.find(bytes);
+        if(it != freeLists.end() && it->second) {
+            void* p = it->second;
+            it->second = *static_cast<void**>(p);
+            return p;
+        }
+    }
+
+    while(current < blocks.size()) {
+        Block& b = blocks[current];
+        if(offset + bytes <= b.size) {
+            void* p = b.data + offset;
+            offset += bytes;
+            bytesUsed += bytes;
+            return p;
+        }
+        // move on to the next block kept from before a release()
+        ++current;
+        offset = 0;
+    }
+
+    Block b;
+    b.size = bytes > blockSize ? bytes : blockSize;
+    b.raw = static_cast<char*>(::operator new(HEAP_ALIGNED ? b.size : b.size + ALIGNMENT));
+    b.data = HEAP_ALIGNED ? b.raw : alignUp(b.raw);
+    blocks.push_back(b);
+    current = blocks.size() - 1;
+    offset = bytes;
+    bytesUsed += bytes;
+    return b.data;
+}
+
+void
+Arena::deallocate(void* p, std::size_t bytes)
+{
+    if(!p) {
+        return;
+    }
+    // every allocation is at least ALIGNMENT bytes, room for the link
+    void*& head = freeLists[alignUp(bytes ? bytes : 1)];
+    *static_cast<void**>(p) = head;
+    head = p;
+}
+
+void
+Arena::release()
+{
+    // objects still alive are abandoned along with their memory,
+    // but what owned ones hold elsewhere is freed
+    destroyAllOwned();
+    current = 0;
+    offset = 0;
+    bytesUsed = 0;
+    liveObjects = 0;
+    freeLists.clear();
+}
+
+/*private*/
+void*
+Arena::allocateOwned(std::size_t size, void (*destroy)(void*))
+{
+    static_assert(sizeof(OwnedHeader) <= OWNED_HEADER_SIZE, "owned header too large");
+    OwnedHeader* h = static_cast<OwnedHeader*>(allocate(OWNED_HEADER_SIZE + size));
+    h->prev = nullptr;
+    h->next = owned;
+    h->destroy = destroy;
+    if(owned) {
+        owned->prev = h;
+    }
+    owned = h;
+    return reinterpret_cast<char*>(h) + OWNED_HEADER_SIZE;
+}
+
+/*private*/
+void
+Arena::deallocateOwned(void* p, std::size_t size)
+{
+    OwnedHeader* h = reinterpret_cast<OwnedHeader*>(static_cast<char*>(p) - OWNED_HEADER_SIZE);
+    if(h->prev) {
+        h->prev->next = h->next;
+    }
+    else {
+        owned = h->next;
+    }
+    if(h->next) {
+        h->next->prev = h->prev;
+    }
+    deallocate(h, OWNED_HEADER_SIZE + size);
+}
+
+/*private*/
+void
+Arena::destroyAllOwned()
+{
+    for(OwnedHeader* h = owned; h; h = h->next) {
+        h->destroy(reinterpret_cast<char*>(h) + OWNED_HEADER_SIZE);
+    }
+    owned = nullptr;
+}
+
+std::size_t
+Arena::getBytesReserved() const
+{
+    std::size_t total = 0;
+    for(const Block& b : blocks) {
+        total += b.size;
+    }
+    return total;
+}
+
+/*public static*/
+void*
+Arena::allocateObject(std::size_t size, Arena* arena)
+{
+    if(arena) {
+        char* base = static_cast<char*>(arena->allocate(size + TAG));
+        *reinterpret_cast<Arena**>(base) = arena;
+        ++arena->liveObjects;
+        return base + TAG;
+    }
+    if(HEAP_ALIGNED) {
+        void* p = ::operator new(size);
+        assert(!isArenaObject(p));
+        return p;
+    }
+    // the system allocator may return tagged addresses: align by hand,
+    // keeping the address to free in front of the object
+    char* raw = static_cast<char*>(::operator new(size + ALIGNMENT));
+    char* p = alignUp(raw + sizeof(char*));
+    reinterpret_cast<char**>(p)[-1] = raw;
+    return p;
+}
+
+/*public static*/
+void
+Arena::deallocateObject(void* p, std::size_t size)
+{
+    if(!p) {
+        return;
+    }
+    if(isArenaObject(p)) {
+        char* base = static_cast<char*>(p) - TAG;
+        Arena* arena = *reinterpret_cast<Arena**>(base);
+        assert(arena->liveObjects > 0);
+        --arena->liveObjects;
+        arena->deallocate(base, size + TAG);
+    }
+    else if(HEAP_ALIGNED) {
+        ::operator delete(p);
+    }
+    else {
+        ::operator delete(reinterpret_cast<char**>(p)[-1]);
+    }
+}
+
+/*public static*/
+void
+Arena::deallocateObject(void* p)
+{
+    if(p && isArenaObject(p)) {
+        Arena* arena = *reinterpret_cast<Arena**>(static_cast<char*>(p) - TAG);
+        --arena->liveObjects;
+        return;
+    }
+    deallocateObject(p, 0);
+}
+
+} // namespace geos::util
+} // namespace geos
@@ -15,11 +15,30 @@
 #include <geos/util/Interrupt.h>
 #include <geos/util/GEOSException.h> // for inheritance
 
+#include <chrono>
+#include <limits>
+
 namespace {
 /* Could these be portably stored in thread-specific space ? */
 bool requested = false;
 
 geos::util::Interrupt::Callback* callback = nullptr;
+
+// Per-thread state, see Interrupt::Scope
+thread_local geos::util::InterruptState* threadState = nullptr;
+
+// Whether the calling thread helps with a call started on another
+// thread, see Interrupt::Scope
+thread_local bool helperThread = false;
+
+const std::int64_t noDeadline = std::numeric_limits<std::int64_t>::max();
+
+std::int64_t
+steadyNow()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
 }
 
 namespace geos {
@@ -31,6 +50,56 @@ public:
         GEOSException("InterruptedException", "Interrupted!") {}
 };
 
+InterruptState::InterruptState()
+    :
+    requested(false),
+    delivered(false),
+    deadline(noDeadline)
+{}
+
+void
+InterruptState::request()
+{
+    requested = true;
+}
+
+void
+InterruptState::cancel()
+{
+    requested = false;
+    delivered = false;
+}
+
+bool
+InterruptState::check() const
+{
+    return requested;
+}
+
+void
+InterruptState::setTimeout(double seconds)
+{
+    if(!(seconds > 0)) {
+        deadline = noDeadline;
+        return;
+    }
+    double ns = seconds * 1e9;
+    std::int64_t now = steadyNow();
+    if(ns >= static_cast<double>(noDeadline - now)) {
+        deadline = noDeadline;
+    }
+    else {
+        deadline = now + static_cast<std::int64_t>(ns);
+    }
+}
+
+bool
+InterruptState::isExpired() const
+{
+    std::int64_t d = deadline;
+    return d != noDeadline && steadyNow() >= d;
+}
+
 void
 Interrupt::request()
 {
@@ -60,13 +129,26 @@ Interrupt::registerCallback(Interrupt::Callback* cb)
 void
 Interrupt::process()
 {
-    if(callback) {
+    // the callback is not expected to be thread-safe
+    if(callback && !helperThread) {
         (*callback)();
     }
     if(requested) {
         requested = false;
         interrupt();
     }
+    InterruptState* state = threadState;
+    if(state) {
+        // not interrupt(), which would cancel the process-wide request;
+        // the request stays pending for the other threads of the call
+        if(state->requested) {
+            state->delivered = true;
+            throw InterruptedException();
+        }
+        if(state->isExpired()) {
+            throw InterruptedException();
+        }
+    }
 }
 
 
@@ -77,6 +159,30 @@ Interrupt::interrupt()
     throw InterruptedException();
 }
 
+Interrupt::Scope::Scope(InterruptState* state, bool newCall)
+    :
+    previous(threadState),
+    previousHelper(helperThread)
+{
+    if(newCall && state && state != previous && state->delivered.exchange(false)) {
+        state->requested = false;
+    }
+    threadState = state;
+    helperThread = previousHelper || !newCall;
+}
+
+Interrupt::Scope::~Scope()
+{
+    threadState = previous;
+    helperThread = previousHelper;
+}
+
+InterruptState*
+Interrupt::currentState()
+{
+    return threadState;
+}
+
 
 } // namespace geos::util
 } // namespace geos
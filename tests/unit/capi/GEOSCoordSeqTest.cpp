@@ -5,6 +5,7 @@
 // geos
 #include <geos_c.h>
 // std
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
@@ -344,5 +345,86 @@ void object::test<10>
     ensure_equals(GEOSCoordSeq_isCCW(cs_, &ccw), 0);
 }
 
-} // namespace tut
+// Bulk copy from and to interleaved buffers
+template<>
+template<>
+void object::test<11>
+()
+{
+    const double xy[] = { 1, 2, 3, 4, 5, 6 };
+    cs_ = GEOSCoordSeq_copyFromBuffer(xy, 3, 0);
+    ensure(nullptr != cs_);
+
+    unsigned int size, dims;
+    ensure(0 != GEOSCoordSeq_getSize(cs_, &size));
+    ensure(0 != GEOSCoordSeq_getDimensions(cs_, &dims));
+    ensure_equals(size, 3u);
+    ensure_equals(dims, 2u);
+
+    double v;
+    GEOSCoordSeq_getY(cs_, 1, &v);
+    ensure_equals(v, 4.0);
+
+    double out[9];
+    ensure(0 != GEOSCoordSeq_copyToBuffer(cs_, out, 0));
+    for(std::size_t i = 0; i < 6; i++) {
+        ensure_equals(out[i], xy[i]);
+    }
+
+    ensure(0 != GEOSCoordSeq_copyToBuffer(cs_, out, 1));
+    ensure_equals(out[3], 3.0);
+    ensure_equals(out[4], 4.0);
+    ensure(std::isnan(out[5]));
+
+    GEOSCoordSeq_destroy(cs_);
+
+    const double xyz[] = { 1, 2, 3, 4, 5, 6 };
+    cs_ = GEOSCoordSeq_copyFromBuffer(xyz, 2, 1);
+    ensure(0 != GEOSCoordSeq_getDimensions(cs_, &dims));
+    ensure_equals(dims, 3u);
+    GEOSCoordSeq_getZ(cs_, 1, &v);
+    ensure_equals(v, 6.0);
+
+    ensure(0 != GEOSCoordSeq_copyToBuffer(cs_, out, 1));
+    for(std::size_t i = 0; i < 6; i++) {
+        ensure_equals(out[i], xyz[i]);
+    }
+}
 
+// Bulk copy from and to separate ordinate arrays
+template<>
+template<>
+void object::test<12>
+()
+{
+    const double x[] = { 1, 2, 3 };
+    const double y[] = { 4, 5, 6 };
+    const double z[] = { 7, 8, 9 };
+
+    cs_ = GEOSCoordSeq_copyFromArrays(x, y, z, 3);
+    ensure(nullptr != cs_);
+
+    double v;
+    GEOSCoordSeq_getX(cs_, 2, &v);
+    ensure_equals(v, 3.0);
+    GEOSCoordSeq_getZ(cs_, 0, &v);
+    ensure_equals(v, 7.0);
+
+    double ox[3], oy[3], oz[3];
+    ensure(0 != GEOSCoordSeq_copyToArrays(cs_, ox, oy, oz));
+    for(std::size_t i = 0; i < 3; i++) {
+        ensure_equals(ox[i], x[i]);
+        ensure_equals(oy[i], y[i]);
+        ensure_equals(oz[i], z[i]);
+    }
+
+    GEOSCoordSeq_destroy(cs_);
+    cs_ = GEOSCoordSeq_copyFromArrays(x, y, nullptr, 3);
+    unsigned int dims;
+    ensure(0 != GEOSCoordSeq_getDimensions(cs_, &dims));
+    ensure_equals(dims, 2u);
+    ensure(0 != GEOSCoordSeq_copyToArrays(cs_, ox, oy, nullptr));
+    ensure_equals(oy[1], 5.0);
+}
+
+} // namespace tut
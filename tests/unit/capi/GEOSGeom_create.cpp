@@ -149,6 +149,41 @@ void object::test<7>
     geom1_ = nullptr;
 }
 
+// Geometries from coordinate buffers
+template<>
+template<>
+void object::test<8>
+()
+{
+    const double line[] = { 0, 0, 1, 1, 2, 0 };
+    geom1_ = GEOSGeom_createLineStringFromBuffer_r(handle_, line, 3, 0);
+    ensure(nullptr != geom1_);
+    ensure_equals(GEOSGeomTypeId_r(handle_, geom1_), GEOS_LINESTRING);
+    ensure_equals(GEOSGeomGetNumPoints_r(handle_, geom1_), 3);
+    GEOSGeom_destroy(geom1_);
 
-} // namespace tut
+    // shell and one hole, stored one after the other
+    const double rings[] = {
+        0, 0, 10, 0, 10, 10, 0, 10, 0, 0,
+        2, 2, 4, 2, 4, 4, 2, 2
+    };
+    const unsigned int sizes[] = { 5, 4 };
+    geom1_ = GEOSGeom_createPolygonFromBuffer_r(handle_, rings, sizes, 2, 0);
+    ensure(nullptr != geom1_);
+    ensure_equals(GEOSGetNumInteriorRings_r(handle_, geom1_), 1);
+    double area;
+    ensure(0 != GEOSArea_r(handle_, geom1_, &area));
+    ensure_equals(area, 98.0);
+    GEOSGeom_destroy(geom1_);
+
+    geom1_ = GEOSGeom_createPolygonFromBuffer_r(handle_, nullptr, nullptr, 0, 0);
+    ensure(0 != GEOSisEmpty_r(handle_, geom1_));
+    GEOSGeom_destroy(geom1_);
 
+    // rings must be closed
+    const double open[] = { 0, 0, 1, 0, 1, 1, 0, 1 };
+    geom1_ = GEOSGeom_createLinearRingFromBuffer_r(handle_, open, 4, 0);
+    ensure(nullptr == geom1_);
+}
+
+} // namespace tut
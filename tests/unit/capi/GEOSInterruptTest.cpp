@@ -5,10 +5,15 @@
 // geos
 #include <geos_c.h>
 // std
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 
 namespace tut {
 //
@@ -47,6 +52,28 @@ struct test_capiinterrupt_data {
         GEOS_interruptRequest();
     }
 
+    static GEOSContextHandle_t interruptedContext;
+    static std::atomic<int> numRequests;
+
+    // Interrupts interruptedContext once, from within the first check
+    static void
+    interruptContextOnce()
+    {
+        if(numRequests++ == 0) {
+            GEOSContext_interrupt_r(interruptedContext);
+        }
+    }
+
+    static std::mutex callerMutex;
+    static std::set<std::thread::id> callers;
+
+    static void
+    recordCaller()
+    {
+        std::lock_guard<std::mutex> lock(callerMutex);
+        callers.insert(std::this_thread::get_id());
+    }
+
     static void
     countCalls()
     {
@@ -60,6 +87,10 @@ struct test_capiinterrupt_data {
 
 int test_capiinterrupt_data::numcalls = 0;
 GEOSInterruptCallback* test_capiinterrupt_data::nextcb = nullptr;
+GEOSContextHandle_t test_capiinterrupt_data::interruptedContext = nullptr;
+std::atomic<int> test_capiinterrupt_data::numRequests(0);
+std::mutex test_capiinterrupt_data::callerMutex;
+std::set<std::thread::id> test_capiinterrupt_data::callers;
 
 typedef test_group<test_capiinterrupt_data> group;
 typedef group::object object;
@@ -221,5 +252,155 @@ void object::test<5>
 }
 
 
-} // namespace tut
+/// Test interrupting one context leaves the others running
+template<>
+template<>
+void object::test<6>
+()
+{
+    GEOSContextHandle_t ctx1 = initGEOS_r(notice, notice);
+    GEOSContextHandle_t ctx2 = initGEOS_r(notice, notice);
+
+    GEOSGeometry* geom1 = GEOSGeomFromWKT_r(ctx1, "LINESTRING(0 0, 1 0)");
+    ensure("GEOSGeomFromWKT failed", nullptr != geom1);
+
+    GEOSContext_interrupt_r(ctx1);
+
+    GEOSGeometry* geom2 = GEOSBuffer_r(ctx2, geom1, 1, 8);
+    ensure("GEOSBuffer on other context was interrupted", nullptr != geom2);
+    GEOSGeom_destroy_r(ctx2, geom2);
+
+    geom2 = GEOSBuffer_r(ctx1, geom1, 1, 8);
+    ensure("GEOSBuffer wasn't interrupted", nullptr == geom2);
 
+    // the request is consumed by the interruption
+    geom2 = GEOSBuffer_r(ctx1, geom1, 1, 8);
+    ensure("GEOSBuffer interrupted twice", nullptr != geom2);
+    GEOSGeom_destroy_r(ctx1, geom2);
+
+    GEOSContext_interrupt_r(ctx1);
+    GEOSContext_cancelInterrupt_r(ctx1);
+    ensure_equals(GEOSIntersects_r(ctx1, geom1, geom1), 1);
+
+    GEOSGeom_destroy_r(ctx1, geom1);
+    finishGEOS_r(ctx1);
+    finishGEOS_r(ctx2);
+}
+
+/// Test context timeout
+template<>
+template<>
+void object::test<7>
+()
+{
+    GEOSContextHandle_t ctx = initGEOS_r(notice, notice);
+
+    GEOSGeometry* geom1 = GEOSGeomFromWKT_r(ctx, "POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+    GEOSGeometry* geom2 = GEOSGeomFromWKT_r(ctx, "POLYGON((5 5, 15 5, 15 15, 5 15, 5 5))");
+
+    GEOSContext_setTimeout_r(ctx, 3600);
+    GEOSGeometry* result = GEOSIntersection_r(ctx, geom1, geom2);
+    ensure("GEOSIntersection interrupted before timeout", nullptr != result);
+    GEOSGeom_destroy_r(ctx, result);
+
+    // a budget of 1ns is exhausted by the time the overlay checks it
+    GEOSContext_setTimeout_r(ctx, 1e-9);
+    result = GEOSIntersection_r(ctx, geom1, geom2);
+    ensure("GEOSIntersection wasn't interrupted", nullptr == result);
+    ensure_equals(GEOSRelatePattern_r(ctx, geom1, geom2, "T********"), 2);
+
+    GEOSContext_setTimeout_r(ctx, 0);
+    result = GEOSIntersection_r(ctx, geom1, geom2);
+    ensure("GEOSIntersection interrupted without timeout", nullptr != result);
+    GEOSGeom_destroy_r(ctx, result);
+
+    GEOSGeom_destroy_r(ctx, geom1);
+    GEOSGeom_destroy_r(ctx, geom2);
+    finishGEOS_r(ctx);
+}
+
+/// Test a context interrupt stops every thread of a batched predicate
+template<>
+template<>
+void object::test<8>
+()
+{
+    GEOSContextHandle_t ctx = initGEOS_r(notice, notice);
+
+    const std::size_t n = 64;
+    std::vector<GEOSGeometry*> geoms;
+    for(std::size_t i = 0; i < n; ++i) {
+        geoms.push_back(GEOSGeomFromWKT_r(ctx, "POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"));
+    }
+    GEOSGeometry* other = GEOSGeomFromWKT_r(ctx, "POLYGON((5 5, 15 5, 15 15, 5 15, 5 5))");
+    std::vector<const GEOSGeometry*> g1(geoms.begin(), geoms.end());
+    std::vector<const GEOSGeometry*> g2(n, other);
+    std::vector<char> out(n, 0);
+
+    interruptedContext = ctx;
+    numRequests = 0;
+    GEOS_interruptRegisterCallback(interruptContextOnce);
+    int ret = GEOSRelatePatternMany_r(ctx, g1.data(), g2.data(), n, "T********",
+                                      out.data(), 4);
+    GEOS_interruptRegisterCallback(nullptr);
+    ensure_equals(ret, 0);
+
+    // the callback only runs on the calling thread, which checks the
+    // first quarter of the pairs; the request is not consumed by the
+    // first pair it stops, so every pair of that quarter is interrupted
+    for(std::size_t i = 0; i < n / 4; ++i) {
+        ensure_equals(out[i], 2);
+    }
+
+    // the next call clears the request which interrupted the batch
+    ensure_equals(GEOSRelatePattern_r(ctx, g1[0], other, "T********"), 1);
+
+    // until cancelled, a request stays pending for the whole call
+    GEOSContext_interrupt_r(ctx);
+    ensure_equals(GEOSRelatePatternMany_r(ctx, g1.data(), g2.data(), n, "T********",
+                                          out.data(), 4), 0);
+    for(char c : out) {
+        ensure_equals(c, 2);
+    }
+    GEOSContext_interrupt_r(ctx);
+    GEOSContext_cancelInterrupt_r(ctx);
+    ensure_equals(GEOSRelatePatternMany_r(ctx, g1.data(), g2.data(), n, "T********",
+                                          out.data(), 4), 1);
+
+    for(GEOSGeometry* g : geoms) {
+        GEOSGeom_destroy_r(ctx, g);
+    }
+    GEOSGeom_destroy_r(ctx, other);
+    finishGEOS_r(ctx);
+}
+
+/// Test the callback only runs on the thread calling a batched predicate
+template<>
+template<>
+void object::test<9>
+()
+{
+    GEOSContextHandle_t ctx = initGEOS_r(notice, notice);
+
+    const std::size_t n = 64;
+    GEOSGeometry* geom = GEOSGeomFromWKT_r(ctx, "POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+    GEOSGeometry* other = GEOSGeomFromWKT_r(ctx, "POLYGON((5 5, 15 5, 15 15, 5 15, 5 5))");
+    std::vector<const GEOSGeometry*> g1(n, geom);
+    std::vector<const GEOSGeometry*> g2(n, other);
+    std::vector<char> out(n, 0);
+
+    callers.clear();
+    GEOS_interruptRegisterCallback(recordCaller);
+    int ret = GEOSRelatePatternMany_r(ctx, g1.data(), g2.data(), n, "T********",
+                                      out.data(), 4);
+    GEOS_interruptRegisterCallback(nullptr);
+    ensure_equals(ret, 1);
+    ensure_equals(callers.size(), 1u);
+    ensure(callers.count(std::this_thread::get_id()) == 1);
+
+    GEOSGeom_destroy_r(ctx, geom);
+    GEOSGeom_destroy_r(ctx, other);
+    finishGEOS_r(ctx);
+}
+
+} // namespace tut
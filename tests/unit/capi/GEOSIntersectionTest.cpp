@@ -5,6 +5,7 @@
 // geos
 #include <geos_c.h>
 // std
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
@@ -143,5 +144,42 @@ void object::test<4>
                   std::string("GEOMETRYCOLLECTION (LINESTRING (1 2, 2 2), LINESTRING (2 1, 1 1), POLYGON ((0.5 1, 1 2, 1 1, 0.5 1)), POLYGON ((9 2, 9.5 1, 2 1, 2 2, 9 2)))"));
 }
 
+// Snap rounded intersection
+template<>
+template<>
+void object::test<5>
+()
+{
+    geom1_ = GEOSGeomFromWKT("POLYGON((0.2 0.1,10.1 -0.2,9.8 10.3,-0.1 9.9,0.2 0.1))");
+    geom2_ = GEOSGeomFromWKT("POLYGON((5.1 4.8,15.3 5.2,14.9 15.1,4.9 14.7,5.1 4.8))");
+
+    ensure(nullptr != geom1_);
+    ensure(nullptr != geom2_);
+
+    geom3_ = GEOSIntersectionPrec(geom1_, geom2_, 1.0);
+
+    ensure(nullptr != geom3_);
+    GEOSNormalize(geom3_);
+    ensure_equals(toWKT(geom3_), std::string("POLYGON ((5 5, 5 10, 10 10, 10 5, 5 5))"));
+}
+
+// Negative grid sizes are rejected
+template<>
+template<>
+void object::test<6>
+()
+{
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0,10 0,10 10,0 10,0 0))");
+    geom2_ = GEOSGeomFromWKT("POLYGON((5 5,15 5,15 15,5 15,5 5))");
+
+    ensure(nullptr != geom1_);
+    ensure(nullptr != geom2_);
+
+    ensure(nullptr == GEOSIntersectionPrec(geom1_, geom2_, -1.0));
+    ensure(nullptr == GEOSDifferencePrec(geom1_, geom2_, -1.0));
+    ensure(nullptr == GEOSSymDifferencePrec(geom1_, geom2_, -1.0));
+    ensure(nullptr == GEOSUnionPrec(geom1_, geom2_, std::nan("")));
+}
+
 } // namespace tut
 
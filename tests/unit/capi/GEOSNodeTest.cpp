@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <sstream>
 
 namespace tut {
 //
@@ -123,6 +124,32 @@ void object::test<3>
                  );
 }
 
+/// Parallel noding gives the same result as the sequential one
+template<>
+template<>
+void object::test<4>
+()
+{
+    // a grid of crossing lines, enough for several batches of chains
+    std::ostringstream wkt;
+    wkt << "MULTILINESTRING (";
+    for(int i = 0; i < 200; ++i) {
+        wkt << (i ? ", " : "") << "(0 " << i << ", 100 " << i + 0.5 << ")";
+        wkt << ", (" << i * 0.5 << " -1, " << i * 0.5 << " 201)";
+    }
+    wkt << ")";
+    geom1_ = GEOSGeomFromWKT(wkt.str().c_str());
+    ensure(nullptr != geom1_);
+
+    geom2_ = GEOSNodeParallel(geom1_, 4);
+    ensure(nullptr != geom2_);
+
+    GEOSGeometry* expected = GEOSNode(geom1_);
+    ensure(nullptr != expected);
+    ensure_equals(GEOSGetNumGeometries(geom2_), GEOSGetNumGeometries(expected));
+    ensure_equals(GEOSEqualsExact(geom2_, expected, 0), 1);
+    GEOSGeom_destroy(expected);
+}
 
 } // namespace tut
 
@@ -11,6 +11,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace tut {
 //
@@ -392,5 +394,106 @@ void object::test<11>
         ensure_equals(ret, 0);
     }
 }
-} // namespace tut
 
+// Test batched predicates give the same results as one call per geometry
+template<>
+template<>
+void object::test<12>
+()
+{
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0), (4 4, 6 4, 6 6, 4 6, 4 4))");
+    prepGeom1_ = GEOSPrepare(geom1_);
+    ensure(nullptr != prepGeom1_);
+
+    std::vector<GEOSGeometry*> owned;
+    for(int x = -2; x <= 12; ++x) {
+        for(int y = -2; y <= 12; ++y) {
+            std::string wkt = "POINT(" + std::to_string(x) + " " + std::to_string(y) + ")";
+            owned.push_back(GEOSGeomFromWKT(wkt.c_str()));
+        }
+    }
+    owned.push_back(GEOSGeomFromWKT("LINESTRING(-1 5, 11 5)"));
+    owned.push_back(GEOSGeomFromWKT("POLYGON((1 1, 3 1, 3 3, 1 3, 1 1))"));
+
+    std::vector<const GEOSGeometry*> geoms(owned.begin(), owned.end());
+    // the same geometry may appear several times
+    geoms.push_back(owned[0]);
+    geoms.push_back(owned.back());
+
+    std::size_t n = geoms.size();
+    for(unsigned int numThreads : {1u, 4u}) {
+        std::vector<char> contains(n, 3), intersects(n, 3), touches(n, 3);
+        ensure_equals(GEOSPreparedContainsMany(prepGeom1_, geoms.data(), n, contains.data(), numThreads), 1);
+        ensure_equals(GEOSPreparedIntersectsMany(prepGeom1_, geoms.data(), n, intersects.data(), numThreads), 1);
+        ensure_equals(GEOSPreparedTouchesMany(prepGeom1_, geoms.data(), n, touches.data(), numThreads), 1);
+
+        for(std::size_t i = 0; i < n; ++i) {
+            ensure_equals(contains[i], GEOSPreparedContains(prepGeom1_, geoms[i]));
+            ensure_equals(intersects[i], GEOSPreparedIntersects(prepGeom1_, geoms[i]));
+            ensure_equals(touches[i], GEOSPreparedTouches(prepGeom1_, geoms[i]));
+        }
+    }
+
+    for(GEOSGeometry* g : owned) {
+        GEOSGeom_destroy(g);
+    }
+}
+
+// Test batched predicates flag NULL geometries and carry on
+template<>
+template<>
+void object::test<13>
+()
+{
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+    geom2_ = GEOSGeomFromWKT("POINT(5 5)");
+    prepGeom1_ = GEOSPrepare(geom1_);
+
+    const GEOSGeometry* geoms[] = { geom2_, nullptr, geom2_ };
+    char out[3] = { 3, 3, 3 };
+
+    ensure_equals(GEOSPreparedWithinMany(prepGeom1_, geoms, 3, out, 2), 0);
+    ensure_equals(out[0], 0);
+    ensure_equals(out[1], 2);
+    ensure_equals(out[2], 0);
+
+    ensure_equals(GEOSPreparedCoversMany(prepGeom1_, geoms, 0, out, 2), 1);
+}
+
+// Test batched predicates on shared polygons with holes from many threads
+template<>
+template<>
+void object::test<14>
+()
+{
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 20 0, 20 20, 0 20, 0 0), "
+                             "(2 2, 4 2, 4 4, 2 4, 2 2), (12 12, 16 12, 16 16, 12 16, 12 12))");
+    prepGeom1_ = GEOSPrepare(geom1_);
+    ensure(nullptr != prepGeom1_);
+
+    GEOSGeometry* holed = GEOSGeomFromWKT("POLYGON((10 0, 30 0, 30 10, 10 10, 10 0), "
+                                          "(13 3, 17 3, 17 7, 13 7, 13 3))");
+    GEOSGeometry* inHole = GEOSGeomFromWKT("POINT(3 3)");
+    GEOSGeometry* inside = GEOSGeomFromWKT("POINT(8 8)");
+
+    // the same geometries, with holes, are read by every thread
+    std::vector<const GEOSGeometry*> geoms;
+    for(int i = 0; i < 300; ++i) {
+        geoms.push_back(i % 3 == 0 ? holed : (i % 3 == 1 ? inHole : inside));
+    }
+
+    std::size_t n = geoms.size();
+    std::vector<char> contains(n, 3), intersects(n, 3);
+    ensure_equals(GEOSPreparedContainsMany(prepGeom1_, geoms.data(), n, contains.data(), 8), 1);
+    ensure_equals(GEOSPreparedIntersectsMany(prepGeom1_, geoms.data(), n, intersects.data(), 8), 1);
+    for(std::size_t i = 0; i < n; ++i) {
+        ensure_equals(contains[i], char(geoms[i] == inside ? 1 : 0));
+        ensure_equals(intersects[i], char(geoms[i] == inHole ? 0 : 1));
+    }
+
+    GEOSGeom_destroy(holed);
+    GEOSGeom_destroy(inHole);
+    GEOSGeom_destroy(inside);
+}
+
+} // namespace tut
@@ -8,6 +8,7 @@
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
 
 namespace tut {
 //
@@ -101,5 +102,64 @@ void object::test<5>
     ensure_equals(ret, char(0));
 }
 
-} // namespace tut
+// Pairwise GEOSRelatePatternMany
+template<>
+template<>
+void object::test<6>
+()
+{
+    GEOSGeometry* a = GEOSGeomFromWKT("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+    GEOSGeometry* b = GEOSGeomFromWKT("POINT(5 5)");
+    GEOSGeometry* c = GEOSGeomFromWKT("LINESTRING(20 20, 30 30)");
+
+    const GEOSGeometry* g1[] = { a, a, b, a };
+    const GEOSGeometry* g2[] = { b, c, a, nullptr };
+    char out[4] = { 3, 3, 3, 3 };
+
+    for(unsigned int numThreads : {1u, 3u}) {
+        ensure_equals(GEOSRelatePatternMany(g1, g2, 3, "T*****FF*", out, numThreads), 1);
+        for(std::size_t i = 0; i < 3; ++i) {
+            ensure_equals(out[i], GEOSRelatePattern(g1[i], g2[i], "T*****FF*"));
+        }
+    }
+    ensure_equals(out[0], char(1));
+    ensure_equals(out[1], char(0));
+
+    ensure_equals(GEOSRelatePatternMany(g1, g2, 4, "T*****FF*", out, 2), 0);
+    ensure_equals(out[3], char(2));
+
+    GEOSGeom_destroy(a);
+    GEOSGeom_destroy(b);
+    GEOSGeom_destroy(c);
+}
+
+// GEOSRelatePatternMany on shared polygons with holes from many threads
+template<>
+template<>
+void object::test<7>
+()
+{
+    GEOSGeometry* a = GEOSGeomFromWKT("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0), "
+                                      "(2 2, 4 2, 4 4, 2 4, 2 2), (6 6, 8 6, 8 8, 6 8, 6 6))");
+    GEOSGeometry* inHole = GEOSGeomFromWKT("POINT(3 3)");
+    GEOSGeometry* inside = GEOSGeomFromWKT("POINT(5 5)");
+
+    const std::size_t n = 200;
+    std::vector<const GEOSGeometry*> g1(n, a);
+    std::vector<const GEOSGeometry*> g2;
+    for(std::size_t i = 0; i < n; ++i) {
+        g2.push_back(i % 2 ? inHole : inside);
+    }
+    std::vector<char> out(n, 3);
 
+    ensure_equals(GEOSRelatePatternMany(g1.data(), g2.data(), n, "T*****FF*", out.data(), 8), 1);
+    for(std::size_t i = 0; i < n; ++i) {
+        ensure_equals(out[i], char(i % 2 ? 0 : 1));
+    }
+
+    GEOSGeom_destroy(a);
+    GEOSGeom_destroy(inHole);
+    GEOSGeom_destroy(inside);
+}
+
+} // namespace tut
@@ -6,9 +6,14 @@
 #include <geos_c.h>
 // std
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <string>
 #include <cmath>
+#include <algorithm>
+#include <set>
+#include <vector>
 
 struct INTPOINT {
     INTPOINT(int p_x, int p_y) : x(p_x), y(p_y) {}
@@ -259,7 +264,242 @@ void object::test<7>
     GEOSSTRtree_destroy(tree);
 }
 
-} // namespace tut
+// GEOSSTRtree_nearest_k_generic returns the k nearest items, nearest first
+template<>
+template<>
+void object::test<8>
+()
+{
+    std::vector<INTPOINT> points;
+    for(int i = 0; i < 10; i++) {
+        for(int j = 0; j < 10; j++) {
+            points.emplace_back(i * 10 + j % 3, j * 10);
+        }
+    }
+
+    GEOSSTRtree* tree = GEOSSTRtree_create(4);
+    std::vector<GEOSGeometry*> envs;
+    for(auto& p : points) {
+        envs.push_back(INTPOINT2GEOS(&p));
+        GEOSSTRtree_insert(tree, envs.back(), &p);
+    }
+
+    INTPOINT q(42, 57);
+    GEOSGeometry* qEnv = INTPOINT2GEOS(&q);
+
+    std::vector<double> bruteForce;
+    for(auto& p : points) {
+        double d;
+        INTPOINT_dist(&p, &q, &d, nullptr);
+        bruteForce.push_back(d);
+    }
+    std::sort(bruteForce.begin(), bruteForce.end());
+
+    const void* results[7];
+    int n = GEOSSTRtree_nearest_k_generic(tree, &q, qEnv, &INTPOINT_dist, nullptr, 7, results);
+    ensure_equals(n, 7);
+    for(int i = 0; i < n; i++) {
+        double d;
+        INTPOINT_dist(results[i], &q, &d, nullptr);
+        ensure_equals(d, bruteForce[static_cast<size_t>(i)]);
+    }
+
+    // asking for more items than the tree holds
+    std::vector<const void*> all(200);
+    n = GEOSSTRtree_nearest_k_generic(tree, &q, qEnv, &INTPOINT_dist, nullptr, 200, all.data());
+    ensure_equals(n, 100);
+
+    GEOSGeom_destroy(qEnv);
+    for(auto g : envs) {
+        GEOSGeom_destroy(g);
+    }
+    GEOSSTRtree_destroy(tree);
+}
+
+// GEOSSTRtree_withinDistance_generic returns the items within a distance
+template<>
+template<>
+void object::test<9>
+()
+{
+    GEOSGeometry* g1 = GEOSGeomFromWKT("POINT (0 0)");
+    GEOSGeometry* g2 = GEOSGeomFromWKT("LINESTRING (3 0, 3 10)");
+    GEOSGeometry* g3 = GEOSGeomFromWKT("POINT (5 0)");
+    GEOSGeometry* g4 = GEOSGeomFromWKT("POINT (1 4)");
+    GEOSGeometry* q = GEOSGeomFromWKT("POINT (1 0)");
+
+    GEOSSTRtree* tree = GEOSSTRtree_create(2);
+    GEOSSTRtree_insert(tree, g1, g1);
+    GEOSSTRtree_insert(tree, g2, g2);
+    GEOSSTRtree_insert(tree, g3, g3);
+    GEOSSTRtree_insert(tree, g4, g4);
+
+    std::vector<void*> found;
+    int n = GEOSSTRtree_withinDistance_generic(tree, q, q, 2.0, nullptr,
+    [](void* item, void* userdata) {
+        static_cast<std::vector<void*>*>(userdata)->push_back(item);
+    }, &found);
+
+    // maxDistance is inclusive
+    ensure_equals(n, 2);
+    ensure_equals(found.size(), 2u);
+    ensure(found[0] == g1);
+    ensure(found[1] == g2);
+
+    GEOSGeom_destroy(g1);
+    GEOSGeom_destroy(g2);
+    GEOSGeom_destroy(g3);
+    GEOSGeom_destroy(g4);
+    GEOSGeom_destroy(q);
+    GEOSSTRtree_destroy(tree);
+}
+
+// Bulk load from bounds and batch query in CSR form
+template<>
+template<>
+void object::test<10>
+()
+{
+    // unit squares with lower left corners at (i, j), i, j in [0, 10)
+    std::vector<double> xmin, ymin, xmax, ymax;
+    std::vector<size_t> ids;
+    for(size_t i = 0; i < 10; i++) {
+        for(size_t j = 0; j < 10; j++) {
+            xmin.push_back(static_cast<double>(i));
+            ymin.push_back(static_cast<double>(j));
+            xmax.push_back(static_cast<double>(i) + 1);
+            ymax.push_back(static_cast<double>(j) + 1);
+            ids.push_back(1000 + i * 10 + j);
+        }
+    }
+
+    GEOSSTRtree* tree = GEOSSTRtree_createFromBounds(4, xmin.data(), ymin.data(),
+                        xmax.data(), ymax.data(), ids.data(), ids.size());
+    ensure(tree != nullptr);
+
+    // a point inside one square, a corner shared by four, one outside all
+    double qxmin[] = { 2.5, 3, 20 };
+    double qymin[] = { 7.5, 3, 20 };
+    double qxmax[] = { 2.5, 3, 21 };
+    double qymax[] = { 7.5, 3, 21 };
+    size_t offsets[4];
+    size_t numHits = 0;
+
+    int ret = GEOSSTRtree_queryBounds(tree, qxmin, qymin, qxmax, qymax, 3,
+                                      offsets, nullptr, 0, &numHits);
+    ensure_equals(ret, 2);
+    ensure_equals(numHits, 5u);
+
+    std::vector<size_t> found(numHits);
+    ret = GEOSSTRtree_queryBounds(tree, qxmin, qymin, qxmax, qymax, 3,
+                                  offsets, found.data(), found.size(), &numHits);
+    ensure_equals(ret, 1);
+    ensure_equals(offsets[0], 0u);
+    ensure_equals(offsets[1], 1u);
+    ensure_equals(offsets[2], 5u);
+    ensure_equals(offsets[3], 5u);
+    ensure_equals(found[0], 1027u);
+
+    std::sort(found.begin() + 1, found.end());
+    ensure_equals(found[1], 1022u);
+    ensure_equals(found[2], 1023u);
+    ensure_equals(found[3], 1032u);
+    ensure_equals(found[4], 1033u);
+
+    // the items can also be reached through the callback API
+    GEOSGeometry* q = GEOSGeomFromWKT("POINT (2.5 7.5)");
+    size_t item = 0;
+    GEOSSTRtree_query(tree, q, [](void* p_item, void* userdata) {
+        *static_cast<size_t*>(userdata) = reinterpret_cast<uintptr_t>(p_item);
+    }, &item);
+    ensure_equals(item, 1027u);
+
+    GEOSGeom_destroy(q);
+    GEOSSTRtree_destroy(tree);
+}
+
+// Bulk load without ids uses the array indexes
+template<>
+template<>
+void object::test<11>
+()
+{
+    double xmin[] = { 0, 5 };
+    double ymin[] = { 0, 5 };
+    double xmax[] = { 1, 6 };
+    double ymax[] = { 1, 6 };
+
+    GEOSSTRtree* tree = GEOSSTRtree_createFromBounds(10, xmin, ymin, xmax, ymax, nullptr, 2);
 
+    double q[] = { 5.5 };
+    size_t offsets[2];
+    size_t found[2];
+    size_t numHits = 0;
+    ensure_equals(GEOSSTRtree_queryBounds(tree, q, q, q, q, 1, offsets, found, 2, &numHits), 1);
+    ensure_equals(numHits, 1u);
+    ensure_equals(found[0], 1u);
 
+    // numHits is optional, offsets[n] holds the same count
+    ensure_equals(GEOSSTRtree_queryBounds(tree, q, q, q, q, 1, offsets, found, 0, nullptr), 2);
+    ensure_equals(offsets[1], 1u);
 
+    GEOSSTRtree_destroy(tree);
+
+    // an empty tree finds nothing
+    tree = GEOSSTRtree_createFromBounds(10, nullptr, nullptr, nullptr, nullptr, nullptr, 0);
+    ensure_equals(GEOSSTRtree_queryBounds(tree, q, q, q, q, 1, offsets, found, 2, &numHits), 1);
+    ensure_equals(numHits, 0u);
+    ensure_equals(offsets[1], 0u);
+    GEOSSTRtree_destroy(tree);
+}
+
+// Batch query of a tree of geometries, before and after a removal
+template<>
+template<>
+void object::test<12>
+()
+{
+    GEOSSTRtree* tree = GEOSSTRtree_create(4);
+    std::vector<GEOSGeometry*> geoms;
+    for(int i = 0; i < 20; i++) {
+        std::string wkt = "POINT (" + std::to_string(i) + " " + std::to_string(i) + ")";
+        GEOSGeometry* g = GEOSGeomFromWKT(wkt.c_str());
+        geoms.push_back(g);
+        GEOSSTRtree_insert(tree, g, g);
+    }
+
+    double qxmin[] = { 2.5, 9 };
+    double qymin[] = { 2.5, 9 };
+    double qxmax[] = { 4.5, 9 };
+    double qymax[] = { 4.5, 9 };
+    size_t offsets[3];
+    size_t found[3];
+    size_t numHits = 0;
+
+    ensure_equals(GEOSSTRtree_queryBounds(tree, qxmin, qymin, qxmax, qymax, 2,
+                                          offsets, found, 3, &numHits), 1);
+    ensure_equals(numHits, 3u);
+    ensure_equals(offsets[1], 2u);
+    // the hits of a query come in no particular order
+    std::set<size_t> firstHits(found, found + 2);
+    std::set<size_t> expectedHits;
+    expectedHits.insert(reinterpret_cast<uintptr_t>(geoms[3]));
+    expectedHits.insert(reinterpret_cast<uintptr_t>(geoms[4]));
+    ensure(firstHits == expectedHits);
+    ensure(found[2] == reinterpret_cast<uintptr_t>(geoms[9]));
+
+    // the snapshot the batches run on follows removals
+    ensure_equals(GEOSSTRtree_remove(tree, geoms[3], geoms[3]), 1);
+    ensure_equals(GEOSSTRtree_queryBounds(tree, qxmin, qymin, qxmax, qymax, 2,
+                                          offsets, found, 3, &numHits), 1);
+    ensure_equals(numHits, 2u);
+    ensure_equals(offsets[1], 1u);
+    ensure(found[0] == reinterpret_cast<uintptr_t>(geoms[4]));
+
+    GEOSSTRtree_destroy(tree);
+    for(GEOSGeometry* g : geoms) {
+        GEOSGeom_destroy(g);
+    }
+}
+
+} // namespace tut
@@ -231,5 +231,22 @@ void object::test<10>
 
     ensure_equals(toWKT(geom2_), std::string("GEOMETRYCOLLECTION EMPTY"));
 }
+// Parallel union gives the same result as the sequential one
+template<>
+template<>
+void object::test<11>
+()
+{
+    geom1_ = GEOSGeomFromWKT("MULTIPOLYGON (((0 0, 2 0, 2 2, 0 2, 0 0)), ((1 1, 3 1, 3 3, 1 3, 1 1)), ((10 10, 12 10, 12 12, 10 12, 10 10)), ((11 11, 13 11, 13 13, 11 13, 11 11)), ((20 0, 21 0, 21 1, 20 1, 20 0)))");
+    ensure(nullptr != geom1_);
+
+    geom2_ = GEOSUnaryUnionParallel(geom1_, 4);
+    ensure(nullptr != geom2_);
+
+    GEOSGeometry* expected = GEOSUnaryUnion(geom1_);
+    ensure(nullptr != expected);
+    ensure_equals(toWKT(geom2_), toWKT(expected));
+    GEOSGeom_destroy(expected);
+}
 } // namespace tut
 
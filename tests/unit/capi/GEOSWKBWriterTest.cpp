@@ -0,0 +1,103 @@
+//
+// Test Suite for C-API GEOSWKBWriter
+
+#include <tut/tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used in test cases.
+struct test_capigeoswkbwriter_data {
+    GEOSGeometry* geom_;
+    GEOSWKBWriter* writer_;
+
+    static void
+    notice(const char* fmt, ...)
+    {
+        std::fprintf(stdout, "NOTICE: ");
+
+        va_list ap;
+        va_start(ap, fmt);
+        std::vfprintf(stdout, fmt, ap);
+        va_end(ap);
+
+        std::fprintf(stdout, "\n");
+    }
+
+    test_capigeoswkbwriter_data()
+        : geom_(nullptr), writer_(nullptr)
+    {
+        initGEOS(notice, notice);
+        writer_ = GEOSWKBWriter_create();
+    }
+
+    ~test_capigeoswkbwriter_data()
+    {
+        GEOSGeom_destroy(geom_);
+        geom_ = nullptr;
+        GEOSWKBWriter_destroy(writer_);
+        writer_ = nullptr;
+        finishGEOS();
+    }
+};
+
+typedef test_group<test_capigeoswkbwriter_data> group;
+typedef group::object object;
+
+group test_capigeoswkbwriter_group("capi::GEOSWKBWriter");
+
+//
+// Test Cases
+//
+
+// Writing to a user buffer gives the same bytes as GEOSWKBWriter_write
+template<>
+template<>
+void object::test<1>
+()
+{
+    geom_ = GEOSGeomFromWKT("MULTIPOLYGON(((0 0, 1 0, 1 1, 0 0)), ((5 5, 6 5, 6 6, 5 5)))");
+    ensure(nullptr != geom_);
+
+    size_t size = 0;
+    unsigned char* expected = GEOSWKBWriter_write(writer_, geom_, &size);
+    ensure(nullptr != expected);
+
+    // Query the size only
+    ensure_equals(GEOSWKBWriter_writeToBuffer(writer_, geom_, nullptr, 0), size);
+
+    // Too small: nothing is written
+    std::vector<unsigned char> buf(size, 0);
+    ensure_equals(GEOSWKBWriter_writeToBuffer(writer_, geom_, buf.data(), size - 1), size);
+    ensure_equals(buf[0], 0);
+
+    ensure_equals(GEOSWKBWriter_writeToBuffer(writer_, geom_, buf.data(), buf.size()), size);
+    ensure(std::memcmp(expected, buf.data(), size) == 0);
+
+    GEOSFree(expected);
+}
+
+// Geometries that cannot be written return 0
+template<>
+template<>
+void object::test<2>
+()
+{
+    geom_ = GEOSGeomFromWKT("POINT EMPTY");
+    ensure(nullptr != geom_);
+
+    unsigned char buf[64];
+    ensure_equals(GEOSWKBWriter_writeToBuffer(writer_, geom_, buf, sizeof(buf)), 0u);
+}
+
+} // namespace tut
@@ -0,0 +1,121 @@
+//
+// Test Suite for geos::geom::GeometryPool class.
+
+// tut
+#include <tut/tut.hpp>
+// geos
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/GeometryPool.h>
+#include <geos/geom/LineString.h>
+#include <geos/io/WKBReader.h>
+#include <geos/io/WKBWriter.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used in test cases.
+struct test_geometrypool_data {
+    typedef std::unique_ptr<geos::geom::Geometry> GeometryPtr;
+
+    geos::io::WKTReader wktreader_;
+
+    test_geometrypool_data() {}
+
+    std::string
+    toWKB(const std::string& wkt, int dimension = 2)
+    {
+        GeometryPtr g(wktreader_.read(wkt));
+        std::stringstream ss;
+        geos::io::WKBWriter(dimension).write(*g, ss);
+        return ss.str();
+    }
+
+    static const unsigned char*
+    bytes(const std::string& s)
+    {
+        return reinterpret_cast<const unsigned char*>(s.data());
+    }
+};
+
+typedef test_group<test_geometrypool_data> group;
+typedef group::object object;
+
+group test_geometrypool_group("geos::geom::GeometryPool");
+
+//
+// Test Cases
+//
+
+// A WKBReader using a pool reuses the same storage in steady state
+template<>
+template<>
+void object::test<1>
+()
+{
+    std::vector<std::string> wkts;
+    wkts.push_back("LINESTRING (0 0, 10 10, 20 0)");
+    wkts.push_back("LINESTRING (5 5, 15 15, 25 5)");
+    wkts.push_back("LINESTRING (1 2, 3 4, 5 6)");
+
+    geos::geom::GeometryPool pool;
+    geos::io::WKBReader reader(pool);
+
+    const geos::geom::Geometry* lastGeom = nullptr;
+    const geos::geom::Coordinate* lastCoords = nullptr;
+    for(std::size_t i = 0; i < wkts.size(); ++i) {
+        std::string wkb = toWKB(wkts[i]);
+        GeometryPtr g(reader.read(bytes(wkb), wkb.size()));
+        ensure(g->getFactory() == &pool.getFactory());
+
+        GeometryPtr expected(wktreader_.read(wkts[i]));
+        ensure(g->equalsExact(expected.get()));
+
+        const geos::geom::LineString* ls = dynamic_cast<const geos::geom::LineString*>(g.get());
+        const geos::geom::Coordinate* coords = &ls->getCoordinatesRO()->getAt(0);
+        if(i > 0) {
+            ensure(g.get() == lastGeom);
+            ensure(coords == lastCoords);
+        }
+        lastGeom = g.get();
+        lastCoords = coords;
+        pool.recycle(std::move(g));
+    }
+}
+
+// A 2D geometry read into recycled 3D storage has no Z
+template<>
+template<>
+void object::test<2>
+()
+{
+    geos::geom::GeometryPool pool;
+    geos::io::WKBReader reader(pool);
+
+    std::string wkb3d = toWKB("LINESTRING (0 0 7, 1 1 8, 2 2 9)", 3);
+    GeometryPtr g(reader.read(bytes(wkb3d), wkb3d.size()));
+    ensure_equals(g->getCoordinate()->z, 7.0);
+    pool.recycle(std::move(g));
+
+    std::string wkb2d = toWKB("LINESTRING (3 3, 4 4, 5 5)");
+    g.reset(reader.read(bytes(wkb2d), wkb2d.size()));
+    const geos::geom::CoordinateSequence* cs =
+        dynamic_cast<const geos::geom::LineString*>(g.get())->getCoordinatesRO();
+    ensure_equals(cs->size(), 3u);
+    for(std::size_t i = 0; i < cs->size(); ++i) {
+        ensure(std::isnan(cs->getAt(i).z));
+    }
+}
+
+} // namespace tut
@@ -7,8 +7,10 @@
 // geos
 #include <geos/geom/LineString.h>
 #include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
 #include <geos/geom/CoordinateArraySequence.h>
 #include <geos/geom/Dimension.h>
+#include <geos/geom/Envelope.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/PrecisionModel.h>
@@ -512,5 +514,41 @@ void object::test<25>
     factory_->destroyGeometry(geo);
 }
 
+// Test that the cached envelope is copied by clone() and
+// recomputed after geometryChanged()
+template<>
+template<>
+void object::test<26>
+()
+{
+    struct ShiftFilter : public geos::geom::CoordinateFilter {
+        void
+        filter_rw(geos::geom::Coordinate* c) const override
+        {
+            c->x += 100;
+        }
+    };
+
+    ensure(empty_line_->getEnvelopeInternal()->isNull());
+
+    GeometryPtr geo = reader_.read("LINESTRING (0 0, 10 10, 20 0)");
+    const geos::geom::Envelope* env = geo->getEnvelopeInternal();
+    geos::geom::Envelope original(0, 20, 0, 10);
+    ensure(env->equals(&original));
+
+    GeometryPtr copy = geo->clone().release();
+    ensure(copy->getEnvelopeInternal()->equals(env));
+
+    ShiftFilter shift;
+    geo->apply_rw(&shift);
+    geo->geometryChanged();
+    geos::geom::Envelope shifted(100, 120, 0, 10);
+    ensure(geo->getEnvelopeInternal()->equals(&shifted));
+    ensure(copy->getEnvelopeInternal()->equals(&original));
+
+    factory_->destroyGeometry(copy);
+    factory_->destroyGeometry(geo);
+}
+
 } // namespace tut
 
@@ -0,0 +1,234 @@
+//
+// Test Suite for geos::geom::PackedCoordinateSequence class.
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/algorithm/Area.h>
+#include <geos/algorithm/Length.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/PackedCoordinateSequenceFactory.h>
+#include <geos/geom/Polygon.h>
+#include <geos/index/chain/MonotoneChain.h>
+#include <geos/index/chain/MonotoneChainBuilder.h>
+// std
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using geos::geom::Coordinate;
+using geos::geom::CoordinateArraySequence;
+using geos::geom::PackedCoordinateSequence;
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used by tests
+struct test_packedcoordinatesequence_data {
+    std::vector<Coordinate> coords;
+
+    test_packedcoordinatesequence_data()
+    {
+        coords.emplace_back(0, 0);
+        coords.emplace_back(10, 0);
+        coords.emplace_back(10, 10);
+        coords.emplace_back(5, 15);
+        coords.emplace_back(5, 15);
+        coords.emplace_back(0, 10);
+        coords.emplace_back(0, 0);
+    }
+};
+
+typedef test_group<test_packedcoordinatesequence_data> group;
+typedef group::object object;
+
+group test_packedcoordinatesequence_group("geos::geom::PackedCoordinateSequence");
+
+//
+// Test Cases
+//
+
+// 2D coordinates are stored as packed XY pairs
+template<>
+template<>
+void object::test<1>
+()
+{
+    PackedCoordinateSequence seq(coords);
+
+    ensure_equals(seq.size(), coords.size());
+    ensure_equals(seq.getDimension(), 2u);
+    ensure_equals(seq.stride(), 2u);
+
+    const double* xy = seq.data();
+    ensure_equals(xy[2], 10.0);
+    ensure_equals(xy[7], 15.0);
+
+    ensure_equals(seq.getAt(3), Coordinate(5, 15));
+    ensure(std::isnan(seq.getAt(3).z));
+    ensure(std::isnan(seq.getOrdinate(3, PackedCoordinateSequence::Z)));
+}
+
+// Storing a Z value switches to XYZ storage
+template<>
+template<>
+void object::test<2>
+()
+{
+    PackedCoordinateSequence seq(coords);
+    const Coordinate& ref = seq.getAt(1);
+
+    seq.setAt(Coordinate(1, 2, 3), 2);
+
+    ensure_equals(seq.getDimension(), 3u);
+    ensure_equals(seq.getOrdinate(2, PackedCoordinateSequence::Z), 3.0);
+    ensure(std::isnan(seq.getOrdinate(1, PackedCoordinateSequence::Z)));
+    ensure_equals(seq.getAt(2).z, 3.0);
+    ensure_equals(ref, Coordinate(10, 0));
+
+    seq.setOrdinate(1, PackedCoordinateSequence::X, 7);
+    ensure_equals(ref.x, 7.0);
+    ensure_equals(seq.getX(1), 7.0);
+}
+
+// Insertion and repeated points
+template<>
+template<>
+void object::test<3>
+()
+{
+    PackedCoordinateSequence seq;
+
+    seq.add(Coordinate(1, 1));
+    seq.add(Coordinate(1, 1), false);
+    ensure_equals(seq.size(), 1u);
+
+    seq.add(Coordinate(3, 3));
+    seq.add(1, Coordinate(2, 2), false);
+    seq.add(1, Coordinate(1, 1), false);
+    ensure_equals(seq.size(), 3u);
+    ensure_equals(seq.getAt(1), Coordinate(2, 2));
+
+    std::vector<Coordinate> out;
+    seq.toVector(out);
+    ensure_equals(out.size(), 3u);
+    ensure_equals(out[2], Coordinate(3, 3));
+}
+
+// Packed fast paths give the same results as the generic ones
+template<>
+template<>
+void object::test<4>
+()
+{
+    using geos::algorithm::Area;
+    using geos::algorithm::Length;
+    using geos::index::chain::MonotoneChainBuilder;
+
+    PackedCoordinateSequence packed(coords);
+    CoordinateArraySequence array(new std::vector<Coordinate>(coords));
+
+    ensure_equals(Length::ofLine(&packed), Length::ofLine(&array));
+    ensure_equals(Area::ofRingSigned(&packed), Area::ofRingSigned(&array));
+
+    geos::geom::Envelope envPacked, envArray;
+    packed.expandEnvelope(envPacked);
+    array.expandEnvelope(envArray);
+    ensure(envPacked.equals(&envArray));
+
+    std::vector<std::size_t> startPacked, startArray;
+    MonotoneChainBuilder::getChainStartIndices(packed, startPacked);
+    MonotoneChainBuilder::getChainStartIndices(array, startArray);
+    ensure(startPacked == startArray);
+}
+
+// Factory can back a GeometryFactory
+template<>
+template<>
+void object::test<5>
+()
+{
+    using geos::geom::GeometryFactory;
+    using geos::geom::PackedCoordinateSequenceFactory;
+
+    auto gf = GeometryFactory::create(
+                  const_cast<geos::geom::CoordinateSequenceFactory*>(PackedCoordinateSequenceFactory::instance()));
+
+    auto seq = gf->getCoordinateSequenceFactory()->create(new std::vector<Coordinate>(coords));
+    ensure(dynamic_cast<PackedCoordinateSequence*>(seq.get()) != nullptr);
+
+    std::unique_ptr<geos::geom::LineString> line(gf->createLineString(seq.release()));
+    ensure_equals(line->getLength(), 10.0 + 10.0 + std::sqrt(50.0) + std::sqrt(50.0) + 10.0);
+    ensure_equals(line->getEnvelopeInternal()->getMaxY(), 15.0);
+    ensure(dynamic_cast<const PackedCoordinateSequence*>(line->getCoordinatesRO()) != nullptr);
+}
+
+// Rings and polygons are built and measured without a Coordinate mirror
+template<>
+template<>
+void object::test<6>
+()
+{
+    using geos::geom::GeometryFactory;
+    using geos::geom::PackedCoordinateSequenceFactory;
+
+    auto gf = GeometryFactory::create(
+                  const_cast<geos::geom::CoordinateSequenceFactory*>(PackedCoordinateSequenceFactory::instance()));
+
+    PackedCoordinateSequence* packed = new PackedCoordinateSequence(coords);
+    std::unique_ptr<geos::geom::LinearRing> ring(gf->createLinearRing(packed));
+    ensure(ring->isClosed());
+    std::unique_ptr<geos::geom::Polygon> poly(gf->createPolygon(ring.release(), nullptr));
+    ensure_equals(poly->getArea(), 125.0);
+    ensure_equals(poly->getEnvelopeInternal()->getMaxY(), 15.0);
+    ensure(!packed->hasCoordinateMirror());
+    ensure_equals(packed->front(), Coordinate(0, 0));
+    ensure_equals(packed->back(), Coordinate(0, 0));
+    ensure(!packed->hasCoordinateMirror());
+
+    // references into XY storage need the mirror
+    ensure_equals(packed->getAt(3), Coordinate(5, 15));
+    ensure(packed->hasCoordinateMirror());
+}
+
+// References into XYZ storage also go through the mirror, which
+// follows later changes, and concurrent readers share one mirror
+template<>
+template<>
+void object::test<7>
+()
+{
+    PackedCoordinateSequence xyz(4, 3);
+    xyz.setAt(Coordinate(1, 2, 3), 1);
+    const Coordinate& ref = xyz.getAt(1);
+    ensure(xyz.hasCoordinateMirror());
+    ensure_equals(ref.z, 3.0);
+    xyz.setOrdinate(1, geos::geom::CoordinateSequence::Z, 4.0);
+    ensure_equals(ref.z, 4.0);
+
+    PackedCoordinateSequence xy(coords);
+    std::vector<const Coordinate*> seen(8);
+    std::vector<std::thread> readers;
+    for(std::size_t t = 0; t < seen.size(); ++t) {
+        readers.emplace_back([&xy, &seen, t]() {
+            seen[t] = &xy.getAt(0);
+        });
+    }
+    for(std::thread& r : readers) {
+        r.join();
+    }
+    for(const Coordinate* c : seen) {
+        ensure(c == seen[0]);
+    }
+    ensure_equals(xy.getAt(2), Coordinate(10, 10));
+}
+
+} // namespace tut
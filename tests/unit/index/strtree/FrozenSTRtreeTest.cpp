@@ -0,0 +1,169 @@
+#include <tut/tut.hpp>
+// geos
+#include <geos/index/strtree/FrozenSTRtree.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/geom/Envelope.h>
+// std
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace geos::index::strtree;
+using geos::geom::Envelope;
+
+namespace tut {
+// Common data used by tests
+struct test_frozenstrtree_data {
+    std::vector<Envelope> envs;
+    std::vector<std::size_t> values;
+
+    test_frozenstrtree_data()
+    {
+        // 20 x 20 grid of unit squares
+        for(std::size_t i = 0; i < 20; ++i) {
+            for(std::size_t j = 0; j < 20; ++j) {
+                double x = static_cast<double>(i);
+                double y = static_cast<double>(j);
+                envs.emplace_back(x, x + 1, y, y + 1);
+                values.push_back(i * 20 + j);
+            }
+        }
+    }
+
+    void
+    fill(STRtree& tree)
+    {
+        for(std::size_t i = 0; i < envs.size(); ++i) {
+            tree.insert(&envs[i], &values[i]);
+        }
+    }
+
+    static std::vector<void*>
+    sorted(std::vector<void*> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+};
+
+using group = test_group<test_frozenstrtree_data>;
+using object = group::object;
+
+group test_frozenstrtree_group("geos::index::strtree::FrozenSTRtree");
+
+//
+// Test Cases
+//
+
+// Queries return the same items as the source tree
+template<>
+template<>
+void object::test<1>
+()
+{
+    STRtree tree(4);
+    fill(tree);
+    FrozenSTRtree frozen(tree);
+
+    ensure_equals(frozen.size(), envs.size());
+
+    Envelope searchEnvs[] = {
+        Envelope(2.5, 4.5, 7.5, 8.5),
+        Envelope(-5, -1, -5, -1),
+        Envelope(19.5, 30, 19.5, 30),
+        Envelope(0, 20, 0, 20)
+    };
+    for(const Envelope& e : searchEnvs) {
+        std::vector<void*> expected;
+        tree.query(&e, expected);
+        std::vector<void*> found;
+        frozen.query(e, found);
+        ensure(sorted(found) == sorted(expected));
+
+        std::vector<std::size_t> ids;
+        frozen.queryIds(e, ids);
+        ensure_equals(ids.size(), found.size());
+        for(std::size_t k = 0; k < ids.size(); ++k) {
+            ensure_equals(frozen.getItem(ids[k]), found[k]);
+            ensure(frozen.getItemEnvelope(ids[k]).intersects(e));
+        }
+    }
+}
+
+// Empty tree
+template<>
+template<>
+void object::test<2>
+()
+{
+    STRtree tree;
+    FrozenSTRtree frozen(tree);
+
+    ensure_equals(frozen.size(), 0u);
+
+    std::vector<void*> found;
+    Envelope e(0, 1, 0, 1);
+    frozen.query(e, found);
+    ensure(found.empty());
+
+    std::vector<Envelope> probes(3, e);
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> ids;
+    frozen.queryBatch(probes, offsets, ids, 2);
+    ensure(offsets == std::vector<std::size_t>(4, 0));
+    ensure(ids.empty());
+}
+
+// Batch query, sequential and threaded, matches single queries
+template<>
+template<>
+void object::test<3>
+()
+{
+    STRtree tree;
+    fill(tree);
+    FrozenSTRtree frozen(tree);
+
+    std::vector<Envelope> probes;
+    for(std::size_t i = 0; i < 37; ++i) {
+        double x = static_cast<double>(i % 23) - 1.5;
+        double y = static_cast<double>(i % 17) + 0.25;
+        probes.emplace_back(x, x + 2, y, y + 0.5);
+    }
+
+    std::vector<std::size_t> expectedOffsets(1, 0);
+    std::vector<std::size_t> expectedIds;
+    for(const Envelope& e : probes) {
+        frozen.queryIds(e, expectedIds);
+        expectedOffsets.push_back(expectedIds.size());
+    }
+
+    for(std::size_t numThreads = 1; numThreads <= 8; numThreads *= 2) {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> ids;
+        frozen.queryBatch(probes, offsets, ids, numThreads);
+        ensure(offsets == expectedOffsets);
+        ensure(ids == expectedIds);
+    }
+}
+
+// Removed items are not part of the snapshot
+template<>
+template<>
+void object::test<4>
+()
+{
+    STRtree tree;
+    fill(tree);
+    tree.build();
+    ensure(tree.remove(&envs[0], &values[0]));
+    FrozenSTRtree frozen(tree);
+
+    ensure_equals(frozen.size(), envs.size() - 1);
+
+    std::vector<void*> found;
+    frozen.query(envs[0], found);
+    ensure(std::find(found.begin(), found.end(), &values[0]) == found.end());
+}
+
+} // namespace tut
@@ -0,0 +1,158 @@
+#include <tut/tut.hpp>
+// geos
+#include <geos/index/strtree/PackedRtree.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalStateException.h>
+// std
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace geos::index::strtree;
+using geos::geom::Envelope;
+
+namespace tut {
+// Common data used by tests
+struct test_packedrtree_data {
+    std::vector<Envelope> envs;
+    std::vector<int> values;
+
+    test_packedrtree_data()
+        : values(1000)
+    {
+        // pseudo-random boxes, deterministic
+        unsigned int seed = 12345;
+        for(std::size_t i = 0; i < values.size(); ++i) {
+            seed = seed * 1103515245 + 12345;
+            double x = static_cast<double>(seed % 10000) / 100.0;
+            seed = seed * 1103515245 + 12345;
+            double y = static_cast<double>(seed % 10000) / 100.0;
+            envs.emplace_back(x, x + static_cast<double>(i % 3), y, y + 1);
+            values[i] = static_cast<int>(i);
+        }
+    }
+
+    void
+    fill(PackedRtree& tree)
+    {
+        for(std::size_t i = 0; i < envs.size(); ++i) {
+            tree.insert(&envs[i], &values[i]);
+        }
+        tree.build();
+    }
+
+    // The ids found by brute force
+    std::vector<std::size_t>
+    expectedIds(const Envelope& searchEnv)
+    {
+        std::vector<std::size_t> ids;
+        for(std::size_t i = 0; i < envs.size(); ++i) {
+            if(envs[i].intersects(searchEnv)) {
+                ids.push_back(i);
+            }
+        }
+        return ids;
+    }
+
+    void
+    checkQueries(PackedRtree& tree)
+    {
+        for(std::size_t k = 0; k < 50; ++k) {
+            double x = static_cast<double>(k * 7 % 100) - 5;
+            double y = static_cast<double>(k * 13 % 100) - 5;
+            Envelope searchEnv(x, x + static_cast<double>(k % 20), y, y + 10);
+
+            std::vector<std::size_t> ids;
+            tree.queryIds(searchEnv, ids);
+            std::sort(ids.begin(), ids.end());
+            ensure(ids == expectedIds(searchEnv));
+
+            std::vector<void*> found;
+            tree.query(searchEnv, found);
+            ensure_equals(found.size(), ids.size());
+        }
+    }
+};
+
+using group = test_group<test_packedrtree_data>;
+using object = group::object;
+
+group test_packedrtree_group("geos::index::strtree::PackedRtree");
+
+//
+// Test Cases
+//
+
+// Sort-Tile-Recursive packing finds the same items as brute force
+template<>
+template<>
+void object::test<1>
+()
+{
+    PackedRtree tree(10, PackedRtree::SORT_TILE_RECURSIVE);
+    fill(tree);
+    ensure_equals(tree.size(), envs.size());
+    // 100 leaves + 10 + 1 root
+    ensure_equals(tree.getNumNodes(), 111u);
+    checkQueries(tree);
+}
+
+// Hilbert packing finds the same items as brute force
+template<>
+template<>
+void object::test<2>
+()
+{
+    PackedRtree tree(4, PackedRtree::HILBERT);
+    fill(tree);
+    checkQueries(tree);
+}
+
+// Empty tree, single item, and null envelopes
+template<>
+template<>
+void object::test<3>
+()
+{
+    PackedRtree empty;
+    empty.build();
+    std::vector<void*> found;
+    empty.query(Envelope(0, 1, 0, 1), found);
+    ensure(found.empty());
+
+    PackedRtree single;
+    Envelope nullEnv;
+    single.insert(&nullEnv, &values[1]);
+    single.insert(&envs[0], &values[0]);
+    single.build();
+    ensure_equals(single.size(), 1u);
+    single.query(envs[0], found);
+    ensure_equals(found.size(), 1u);
+    ensure_equals(found[0], static_cast<void*>(&values[0]));
+}
+
+// Insert after build and query before build throw
+template<>
+template<>
+void object::test<4>
+()
+{
+    PackedRtree tree;
+    tree.insert(&envs[0], &values[0]);
+
+    std::vector<void*> found;
+    try {
+        tree.query(envs[0], found);
+        fail("IllegalStateException expected");
+    }
+    catch(const geos::util::IllegalStateException&) {}
+
+    tree.build();
+    try {
+        tree.insert(&envs[1], &values[1]);
+        fail("IllegalStateException expected");
+    }
+    catch(const geos::util::IllegalStateException&) {}
+}
+
+} // namespace tut
@@ -0,0 +1,235 @@
+//
+// Test Suite for geos::io::CompactGeometryWriter, CompactGeometryReader
+// and CompactGeometryView
+
+// tut
+#include <tut/tut.hpp>
+// geos
+#include <geos/io/CompactGeometryReader.h>
+#include <geos/io/CompactGeometryView.h>
+#include <geos/io/CompactGeometryWriter.h>
+#include <geos/io/ParseException.h>
+#include <geos/io/WKTReader.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/PackedCoordinateSequenceFactory.h>
+// std
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_compactgeometry_data {
+    typedef std::unique_ptr<geos::geom::Geometry> GeomPtr;
+
+    geos::geom::GeometryFactory::Ptr gf;
+    geos::io::WKTReader wktreader;
+    geos::io::CompactGeometryWriter writer;
+    geos::io::CompactGeometryReader reader;
+
+    test_compactgeometry_data()
+        :
+        gf(geos::geom::GeometryFactory::create()),
+        wktreader(gf.get()),
+        reader(*gf)
+    {}
+
+    // Aligned storage for records
+    std::vector<double>
+    toBuffer(const geos::geom::Geometry& g)
+    {
+        std::size_t size = writer.getSize(g);
+        ensure_equals(size % 8, 0u);
+        std::vector<double> buf(size / sizeof(double));
+        ensure_equals(writer.write(g, bytes(buf), size), size);
+        return buf;
+    }
+
+    static unsigned char*
+    bytes(std::vector<double>& buf)
+    {
+        return reinterpret_cast<unsigned char*>(buf.data());
+    }
+
+    void
+    checkRoundTrip(const std::string& wkt)
+    {
+        GeomPtr g(wktreader.read(wkt));
+        g->setSRID(4326);
+        std::vector<double> buf = toBuffer(*g);
+
+        GeomPtr g2 = reader.read(bytes(buf), buf.size() * sizeof(double));
+        ensure_equals(wkt, g2->getGeometryTypeId(), g->getGeometryTypeId());
+        ensure(wkt, g2->equalsExact(g.get()));
+        ensure_equals(wkt, g2->getCoordinateDimension(), g->getCoordinateDimension());
+        ensure_equals(wkt, g2->getSRID(), 4326);
+    }
+};
+
+typedef test_group<test_compactgeometry_data> group;
+typedef group::object object;
+
+group test_compactgeometry_group("geos::io::CompactGeometry");
+
+//
+// Test Cases
+//
+
+// Round trip of every geometry type
+template<>
+template<>
+void object::test<1>
+()
+{
+    checkRoundTrip("POINT (1 2)");
+    checkRoundTrip("POINT EMPTY");
+    checkRoundTrip("LINESTRING (0 0, 10 10, 20 0)");
+    checkRoundTrip("LINESTRING EMPTY");
+    checkRoundTrip("LINEARRING (0 0, 1 0, 1 1, 0 0)");
+    checkRoundTrip("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0), (1 1, 2 1, 2 2, 1 1), (5 5, 6 5, 6 6, 5 5))");
+    checkRoundTrip("POLYGON EMPTY");
+    checkRoundTrip("MULTIPOINT ((0 0), (1 1))");
+    checkRoundTrip("MULTILINESTRING ((0 0, 1 1), (2 2, 3 3))");
+    checkRoundTrip("MULTIPOLYGON (((0 0, 1 0, 1 1, 0 0)), ((5 5, 6 5, 6 6, 5 5), (5.1 5.1, 5.2 5.1, 5.2 5.2, 5.1 5.1)))");
+    checkRoundTrip("GEOMETRYCOLLECTION (POINT (5 5), GEOMETRYCOLLECTION (LINESTRING (1 1, 2 2), POLYGON EMPTY), POLYGON ((0 0, 1 0, 1 1, 0 0)))");
+    checkRoundTrip("GEOMETRYCOLLECTION EMPTY");
+    checkRoundTrip("LINESTRING Z (0 0 1, 10 10 2, 20 0 3)");
+    checkRoundTrip("MULTIPOINT Z ((0 0 5), (1 1 6))");
+}
+
+// Viewing a record in place
+template<>
+template<>
+void object::test<2>
+()
+{
+    GeomPtr g(wktreader.read("MULTIPOLYGON (((0 0, 10 0, 10 10, 0 0)), ((20 20, 30 20, 30 30, 20 20), (21 21, 22 21, 22 22, 21 21)))"));
+    std::vector<double> buf = toBuffer(*g);
+    geos::io::CompactGeometryView view(bytes(buf), buf.size() * sizeof(double));
+
+    ensure_equals(view.getSize(), buf.size() * sizeof(double));
+    ensure_equals(view.getGeometryTypeId(), geos::geom::GEOS_MULTIPOLYGON);
+    ensure_equals(view.getDimension(), 2u);
+    ensure_equals(view.getNumParts(), 6u);
+    ensure_equals(view.getNumCoordinates(), 12u);
+    ensure(view.getEnvelope() == *g->getEnvelopeInternal());
+
+    std::size_t poly = view.getChild(0, 1);
+    ensure_equals(view.getGeometryTypeId(poly), geos::geom::GEOS_POLYGON);
+    ensure_equals(view.getPart(poly).count, 2u);
+
+    std::size_t hole = view.getChild(poly, 1);
+    ensure_equals(view.getGeometryTypeId(hole), geos::geom::GEOS_LINEARRING);
+    ensure_equals(view.getPart(hole).count, 4u);
+    const double* coords = view.getCoordinates(hole);
+    ensure_equals(coords[0], 21.0);
+    ensure_equals(coords[3], 21.0);
+    ensure_equals(coords[4], 22.0);
+
+    // the coordinates are used in place
+    ensure(reinterpret_cast<const unsigned char*>(view.getCoordinates()) > bytes(buf));
+    ensure(reinterpret_cast<const unsigned char*>(view.getCoordinates()) < bytes(buf) + view.getSize());
+}
+
+// Concatenated records written to a stream, read back unaligned
+// and into a PackedCoordinateSequence factory
+template<>
+template<>
+void object::test<3>
+()
+{
+    std::vector<std::string> wkts;
+    wkts.push_back("POINT (1 2)");
+    wkts.push_back("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))");
+    wkts.push_back("LINESTRING Z (0 0 1, 10 10 2)");
+
+    std::stringstream ss;
+    ss << "x";
+    for(const std::string& wkt : wkts) {
+        GeomPtr g(wktreader.read(wkt));
+        writer.write(*g, ss);
+    }
+    std::string stream = ss.str();
+
+    geos::geom::GeometryFactory::Ptr packedFactory = geos::geom::GeometryFactory::create(
+                const_cast<geos::geom::CoordinateSequenceFactory*>(
+                    geos::geom::PackedCoordinateSequenceFactory::instance()));
+    geos::io::CompactGeometryReader packedReader(*packedFactory);
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(stream.data()) + 1;
+    std::size_t size = stream.size() - 1;
+    for(const std::string& wkt : wkts) {
+        GeomPtr expected(wktreader.read(wkt));
+        GeomPtr g = packedReader.read(data, size);
+        ensure(wkt, g->equalsExact(expected.get()));
+
+        std::vector<double> aligned(writer.getSize(*g) / sizeof(double));
+        std::memcpy(aligned.data(), data, aligned.size() * sizeof(double));
+        std::size_t recordSize = geos::io::CompactGeometryView(bytes(aligned), aligned.size() * sizeof(double)).getSize();
+        data += recordSize;
+        size -= recordSize;
+    }
+    ensure_equals(size, 0u);
+
+    GeomPtr g(wktreader.read("LINESTRING (0 0, 1 1)"));
+    std::vector<double> buf = toBuffer(*g);
+    GeomPtr g2 = packedReader.read(bytes(buf), buf.size() * sizeof(double));
+    const geos::geom::LineString* ls = dynamic_cast<const geos::geom::LineString*>(g2.get());
+    ensure(dynamic_cast<const geos::geom::PackedCoordinateSequence*>(ls->getCoordinatesRO()) != nullptr);
+}
+
+// Invalid records are rejected
+template<>
+template<>
+void object::test<4>
+()
+{
+    GeomPtr g(wktreader.read("GEOMETRYCOLLECTION (POINT (5 5), LINESTRING (1 1, 2 2))"));
+    std::vector<double> buf = toBuffer(*g);
+    std::size_t size = buf.size() * sizeof(double);
+
+    // truncated
+    try {
+        reader.read(bytes(buf), size - 8);
+        fail("ParseException expected");
+    }
+    catch(const geos::io::ParseException&) {
+    }
+
+    // bad magic
+    std::vector<double> badMagic = buf;
+    bytes(badMagic)[0] = 'X';
+    try {
+        reader.read(bytes(badMagic), size);
+        fail("ParseException expected");
+    }
+    catch(const geos::io::ParseException&) {
+    }
+
+    // the linestring claims more coordinates than there are
+    std::vector<double> badCount = buf;
+    geos::io::CompactGeometryView::Part part;
+    unsigned char* linePart = bytes(badCount) + sizeof(geos::io::CompactGeometryView::Header)
+                              + 2 * sizeof(part);
+    std::memcpy(&part, linePart, sizeof(part));
+    ensure_equals(part.type, std::uint32_t(geos::geom::GEOS_LINESTRING));
+    part.count = 1000;
+    std::memcpy(linePart, &part, sizeof(part));
+    try {
+        reader.read(bytes(badCount), size);
+        fail("ParseException expected");
+    }
+    catch(const geos::io::ParseException&) {
+    }
+}
+
+} // namespace tut
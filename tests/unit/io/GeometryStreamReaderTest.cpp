@@ -0,0 +1,254 @@
+//
+// Test Suite for geos::io::GeometryStreamReader
+
+// tut
+#include <tut/tut.hpp>
+// geos
+#include <geos/io/GeometryStreamReader.h>
+#include <geos/io/WKBWriter.h>
+#include <geos/io/WKTReader.h>
+#include <geos/io/ParseException.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/util/Arena.h>
+// std
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_geometrystreamreader_data {
+    typedef std::unique_ptr<geos::geom::Geometry> GeomPtr;
+    typedef geos::io::GeometryStreamReader StreamReader;
+
+    geos::geom::GeometryFactory::Ptr gf;
+    geos::io::WKTReader wktreader;
+    std::vector<std::string> wkts;
+
+    test_geometrystreamreader_data()
+        :
+        gf(geos::geom::GeometryFactory::create()),
+        wktreader(gf.get())
+    {
+        wkts.push_back("POINT (1 2)");
+        wkts.push_back("LINESTRING (0 0, 10 10, 20 0)");
+        wkts.push_back("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))");
+        wkts.push_back("MULTIPOINT ((0 0), (1 1))");
+        wkts.push_back("GEOMETRYCOLLECTION (POINT (5 5), LINESTRING (1 1, 2 2))");
+    }
+
+    // Length prefixed WKB records of the test geometries
+    std::string
+    wkbStream()
+    {
+        geos::io::WKBWriter writer;
+        std::string stream;
+        for(const std::string& wkt : wkts) {
+            GeomPtr g(wktreader.read(wkt));
+            std::stringstream ss;
+            writer.write(*g, ss);
+            std::string wkb = ss.str();
+            for(int i = 0; i < 4; ++i) {
+                stream.push_back(static_cast<char>((wkb.size() >> (8 * i)) & 0xFF));
+            }
+            stream += wkb;
+        }
+        return stream;
+    }
+
+    void
+    ensureGeoms(const std::vector<GeomPtr>& geoms)
+    {
+        ensure_equals(geoms.size(), wkts.size());
+        for(std::size_t i = 0; i < geoms.size(); ++i) {
+            GeomPtr expected(wktreader.read(wkts[i]));
+            ensure(wkts[i], geoms[i]->equalsExact(expected.get()));
+        }
+    }
+
+    static const unsigned char*
+    bytes(const std::string& s)
+    {
+        return reinterpret_cast<const unsigned char*>(s.data());
+    }
+};
+
+typedef test_group<test_geometrystreamreader_data> group;
+typedef group::object object;
+
+group test_geometrystreamreader_group("geos::io::GeometryStreamReader");
+
+//
+// Test Cases
+//
+
+// Read length prefixed WKB from a single block
+template<>
+template<>
+void object::test<1>
+()
+{
+    std::string stream = wkbStream();
+    StreamReader reader(*gf, StreamReader::WKB);
+    reader.setInput(bytes(stream), stream.size());
+
+    std::vector<GeomPtr> geoms;
+    while(GeomPtr g = reader.next()) {
+        geoms.push_back(std::move(g));
+    }
+    ensureGeoms(geoms);
+    ensure_equals(reader.getRecordCount(), wkts.size());
+}
+
+// Read WKB added one byte at a time, records spanning chunks
+template<>
+template<>
+void object::test<2>
+()
+{
+    std::string stream = wkbStream();
+    StreamReader reader(*gf, StreamReader::WKB);
+
+    std::vector<GeomPtr> geoms;
+    for(char c : stream) {
+        reader.addChunk(reinterpret_cast<const unsigned char*>(&c), 1);
+        while(GeomPtr g = reader.next()) {
+            geoms.push_back(std::move(g));
+        }
+    }
+    reader.finish();
+    ensure(reader.next() == nullptr);
+    ensureGeoms(geoms);
+}
+
+// Read newline delimited WKT, with blank lines and CRLF line ends
+template<>
+template<>
+void object::test<3>
+()
+{
+    std::string stream;
+    for(const std::string& wkt : wkts) {
+        stream += wkt + "\r\n\n";
+    }
+    // last line without a line end
+    stream.erase(stream.size() - 3);
+
+    StreamReader reader(*gf, StreamReader::WKT);
+    std::size_t half = stream.size() / 2;
+    reader.addChunk(bytes(stream), half);
+
+    std::vector<GeomPtr> geoms;
+    reader.nextBatch(geoms, 100);
+    ensure(geoms.size() < wkts.size());
+
+    reader.addChunk(bytes(stream) + half, stream.size() - half);
+    reader.nextBatch(geoms, 100);
+    ensure(geoms.size() < wkts.size());
+
+    reader.finish();
+    reader.nextBatch(geoms, 100);
+    ensureGeoms(geoms);
+}
+
+// Decode HEXWKB in parallel, keeping input order
+template<>
+template<>
+void object::test<4>
+()
+{
+    geos::io::WKBWriter writer;
+    std::vector<std::string> hex;
+    std::string stream;
+    for(int i = 0; i < 200; ++i) {
+        GeomPtr g(wktreader.read(wkts[static_cast<std::size_t>(i) % wkts.size()]));
+        std::stringstream ss;
+        writer.writeHEX(*g, ss);
+        stream += ss.str() + "\n";
+    }
+
+    StreamReader reader(*gf, StreamReader::HEXWKB);
+    reader.setInput(bytes(stream), stream.size());
+
+    std::vector<GeomPtr> geoms;
+    ensure_equals(reader.nextBatch(geoms, 150, 4), 150u);
+    ensure_equals(reader.nextBatch(geoms, 150, 4), 50u);
+    ensure_equals(reader.nextBatch(geoms, 150, 4), 0u);
+
+    for(std::size_t i = 0; i < geoms.size(); ++i) {
+        GeomPtr expected(wktreader.read(wkts[i % wkts.size()]));
+        ensure(geoms[i]->equalsExact(expected.get()));
+    }
+}
+
+// Malformed and truncated records are reported
+template<>
+template<>
+void object::test<5>
+()
+{
+    std::string wktStream = "POINT (1 1)\nPOINT (1 BAD)\nPOINT (3 3)\n";
+    StreamReader wktReader(*gf, StreamReader::WKT);
+    wktReader.setInput(bytes(wktStream), wktStream.size());
+
+    std::vector<GeomPtr> geoms;
+    try {
+        wktReader.nextBatch(geoms, 10, 2);
+        fail("ParseException expected");
+    }
+    catch(const geos::io::ParseException& e) {
+        ensure(std::string(e.what()).find("Record 2") != std::string::npos);
+    }
+    ensure(geoms.empty());
+    ensure_equals(wktReader.getRecordCount(), 3u);
+
+    std::string stream = wkbStream();
+    StreamReader wkbReader(*gf, StreamReader::WKB);
+    wkbReader.setInput(bytes(stream), stream.size() - 1);
+    for(std::size_t i = 0; i + 1 < wkts.size(); ++i) {
+        ensure(wkbReader.next() != nullptr);
+    }
+    try {
+        wkbReader.next();
+        fail("ParseException expected");
+    }
+    catch(const geos::io::ParseException&) {
+    }
+}
+
+// Batches of an arena factory are decoded on the calling thread only
+template<>
+template<>
+void object::test<6>
+()
+{
+    geos::util::Arena arena;
+    geos::geom::PrecisionModel pm;
+    geos::geom::GeometryFactory::Ptr arenaFactory(
+        geos::geom::GeometryFactory::create(&pm, 0, arena));
+
+    std::string stream;
+    for(int i = 0; i < 20; ++i) {
+        stream += wkbStream();
+    }
+    StreamReader reader(*arenaFactory, StreamReader::WKB);
+    reader.setInput(bytes(stream), stream.size());
+
+    std::vector<GeomPtr> geoms;
+    ensure_equals(reader.nextBatch(geoms, 1000, 4), 20 * wkts.size());
+    for(std::size_t i = 0; i < geoms.size(); ++i) {
+        GeomPtr expected(wktreader.read(wkts[i % wkts.size()]));
+        ensure(geoms[i]->equalsExact(expected.get()));
+        ensure(geoms[i]->getFactory() == arenaFactory.get());
+    }
+    geoms.clear();
+    ensure_equals(arena.getNumLiveObjects(), 0u);
+}
+
+} // namespace tut
@@ -12,6 +12,7 @@
 #include <geos/io/WKBConstants.h>
 #include <geos/io/WKBWriter.h>
 #include <geos/io/WKTReader.h>
+#include <geos/io/ParseException.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h>
@@ -20,6 +21,7 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace tut {
 //
@@ -49,6 +51,17 @@ struct test_wkbreader_data {
         wktreader(gf.get())
     {}
 
+    std::vector<unsigned char>
+    hexToBytes(const std::string& hex)
+    {
+        std::vector<unsigned char> bytes;
+        for(std::size_t i = 0; i + 1 < hex.size(); i += 2) {
+            bytes.push_back(static_cast<unsigned char>(
+                                std::stoi(hex.substr(i, 2), nullptr, 16)));
+        }
+        return bytes;
+    }
+
     void
     testInputNdr(const std::string& WKT,
                  const std::string& ndrWKB)
@@ -381,5 +394,169 @@ void object::test<15>
     );
 }
 
-} // namespace tut
+// 16 - Read from a memory buffer, rounding to the factory precision
+template<>
+template<>
+void object::test<16>
+()
+{
+    // LINESTRING(1.4 2.6, 3 4), NDR
+    std::vector<unsigned char> wkb = hexToBytes(
+        "010200000002000000666666666666F63FCDCCCCCCCCCC044000000000000008400000000000001040");
+    GeomPtr g(wkbreader.read(wkb.data(), wkb.size()));
+    GeomPtr expected(wktreader.read("LINESTRING(1 3, 3 4)"));
+    ensure(g->equalsExact(expected.get()));
+}
+
+// 17 - Read a 3D linestring from a memory buffer in XDR
+template<>
+template<>
+void object::test<17>
+()
+{
+    std::vector<unsigned char> wkb = hexToBytes(
+        "0080000002000000023FF000000000000040000000000000004008000000000000"
+        "401000000000000040140000000000004018000000000000");
+    GeomPtr g(wkbreader.read(wkb.data(), wkb.size()));
+    ensure_equals(g->getCoordinateDimension(), 3);
+    GeomPtr expected(wktreader.read("LINESTRING Z(1 2 3, 4 5 6)"));
+    ensure(g->equalsExact(expected.get()));
+    ensure_equals(g->getCoordinates()->getAt(1).z, 6.0);
+}
+
+// 18 - Truncated buffers and bogus counts are rejected
+template<>
+template<>
+void object::test<18>
+()
+{
+    std::vector<unsigned char> wkb = hexToBytes(
+        "010200000002000000666666666666F63FCDCCCCCCCCCC044000000000000008400000000000001040");
+
+    for(std::size_t len = 0; len < wkb.size(); ++len) {
+        try {
+            GeomPtr g(wkbreader.read(wkb.data(), len));
+            fail("truncated WKB was accepted");
+        }
+        catch(const geos::io::ParseException&) {
+        }
+    }
+
+    // LINESTRING claiming 2^31-1 points, with no coordinates following
+    std::vector<unsigned char> huge = hexToBytes("0102000000FFFFFF7F");
+    try {
+        GeomPtr g(wkbreader.read(huge.data(), huge.size()));
+        fail("bogus point count was accepted");
+    }
+    catch(const geos::io::ParseException& e) {
+        std::string msg(e.what());
+        ensure(msg.find("exceeds") != std::string::npos);
+    }
+}
 
+// 19 - Geometries missing the filter envelope are skipped
+template<>
+template<>
+void object::test<19>
+()
+{
+    geos::io::WKBReader reader;
+    geos::geom::Envelope window(0, 10, 0, 10);
+    reader.setFilterEnvelope(&window);
+
+    struct Case {
+        const char* wkt;
+        bool kept;
+    } cases[] = {
+        { "POINT (5 5)", true },
+        { "POINT (50 5)", false },
+        { "LINESTRING (-5 5, 15 5)", true },
+        { "LINESTRING (20 20, 30 30)", false },
+        { "POLYGON ((-10 -10, 20 -10, 20 20, -10 20, -10 -10))", true },
+        { "MULTIPOINT ((50 50), (60 60))", false },
+        { "GEOMETRYCOLLECTION (POINT (50 50), LINESTRING (11 11, 9 9))", true },
+        { "LINESTRING EMPTY", false },
+    };
+
+    for(const Case& c : cases) {
+        GeomPtr g(wktreader.read(c.wkt));
+        std::stringstream ss;
+        ndrwkbwriter.write(*g, ss);
+        std::string wkb = ss.str();
+        GeomPtr r(reader.read(reinterpret_cast<const unsigned char*>(wkb.data()), wkb.size()));
+        ensure_equals(c.wkt, r != nullptr, c.kept);
+    }
+
+    reader.setFilterEnvelope(nullptr);
+    std::stringstream ss;
+    GeomPtr far(wktreader.read("POINT (50 5)"));
+    ndrwkbwriter.write(*far, ss);
+    ss.seekg(0);
+    GeomPtr r(reader.read(ss));
+    ensure(r != nullptr);
+}
+
+// 20 - Coordinates reduced to a target precision while reading
+template<>
+template<>
+void object::test<20>
+()
+{
+    geos::io::WKBReader reader;
+    geos::geom::PrecisionModel pm10(10.0);
+    reader.setTargetPrecisionModel(&pm10);
+
+    // the first two points become equal once reduced
+    std::vector<unsigned char> wkb = hexToBytes(
+        "0102000000030000009A9999999999F13F9A9999999999F13F"
+        "EC51B81E85EBF13F9A9999999999F13F0000000000002440000000000000F03F");
+    GeomPtr g(reader.read(wkb.data(), wkb.size()));
+    ensure_equals(g->getNumPoints(), 2u);
+    ensure_equals(g->getCoordinates()->getAt(0).x, 1.1);
+    ensure_equals(g->getCoordinates()->getAt(1).x, 10.0);
+
+    // a collapsing line keeps all its points
+    std::vector<unsigned char> collapsing = hexToBytes(
+        "0102000000020000009A9999999999F13F9A9999999999F13F"
+        "EC51B81E85EBF13F9A9999999999F13F");
+    g.reset(reader.read(collapsing.data(), collapsing.size()));
+    ensure_equals(g->getNumPoints(), 2u);
+    ensure(g->getCoordinates()->getAt(0).equals2D(g->getCoordinates()->getAt(1)));
+}
+
+// 21 - Reading from a stream consumes one geometry at a time
+template<>
+template<>
+void object::test<21>
+()
+{
+    GeomPtr g1(wktreader.read("POLYGON ((0 0, 10 0, 10 10, 0 0))"));
+    GeomPtr g2(wktreader.read("POINT (50 5)"));
+    GeomPtr g3(wktreader.read("LINESTRING (1 2, 3 4)"));
+    std::stringstream ss;
+    ndrwkbwriter.write(*g1, ss);
+    xdrwkbwriter.write(*g2, ss);
+    ndrwkbwriter.write(*g3, ss);
+
+    GeomPtr r(wkbreader.read(ss));
+    ensure(r->equalsExact(g1.get()));
+
+    // a geometry missing the filter is still consumed
+    geos::geom::Envelope window(0, 10, 0, 10);
+    wkbreader.setFilterEnvelope(&window);
+    r.reset(wkbreader.read(ss));
+    ensure(r == nullptr);
+    wkbreader.setFilterEnvelope(nullptr);
+
+    r.reset(wkbreader.read(ss));
+    ensure(r->equalsExact(g3.get()));
+
+    try {
+        r.reset(wkbreader.read(ss));
+        fail("read past the last geometry");
+    }
+    catch(const geos::io::ParseException&) {
+    }
+}
+
+} // namespace tut
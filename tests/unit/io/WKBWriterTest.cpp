@@ -11,11 +11,13 @@
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h>
+#include <geos/util/IllegalArgumentException.h>
 // std
 #include <sstream>
 #include <string>
 #include <memory>
 #include <cmath>
+#include <vector>
 
 namespace tut {
 //
@@ -188,5 +190,76 @@ void object::test<5>
     delete geom2;
 }
 
-} // namespace tut
+// 6 - Writing to a buffer matches the stream output and its exact size
+template<>
+template<>
+void object::test<6>
+()
+{
+    const char* wkts[] = {
+        "POINT(-117 33)",
+        "POINT(1 2 3)",
+        "LINESTRING(0 0, 1 1, 2 3)",
+        "POLYGON((0 0, 10 0, 10 10, 0 0), (1 1, 2 1, 2 2, 1 1))",
+        "POLYGON EMPTY",
+        "MULTIPOINT(0 0 1, 1 1 2)",
+        "GEOMETRYCOLLECTION(POINT(1 2), LINESTRING(0 0 0, 1 1 1), MULTIPOLYGON(((0 0, 1 0, 1 1, 0 0))))"
+    };
+
+    for(const char* wkt : wkts) {
+        std::unique_ptr<geos::geom::Geometry> geom(wktreader.read(wkt));
+        geom->setSRID(4326);
+
+        for(int dims = 2; dims <= 3; dims++) {
+            for(int srid = 0; srid <= 1; srid++) {
+                wkbwriter.setOutputDimension(dims);
+                wkbwriter.setIncludeSRID(srid);
+
+                std::stringstream stream;
+                wkbwriter.write(*geom, stream);
+                std::string expected = stream.str();
+
+                std::size_t size = wkbwriter.getWKBSize(*geom);
+                ensure_equals(wkt, size, expected.size());
+
+                std::vector<unsigned char> buf(size + 4, 0xAA);
+                std::size_t written = wkbwriter.write(*geom, buf.data(), buf.size());
+                ensure_equals(wkt, written, size);
+                ensure(wkt, std::equal(expected.begin(), expected.end(), buf.begin(),
+                [](char a, unsigned char b) {
+                    return static_cast<unsigned char>(a) == b;
+                }));
+                ensure_equals(buf[size], 0xAA);
+            }
+        }
+    }
+}
 
+// 7 - A buffer that is too small is rejected before anything is written
+template<>
+template<>
+void object::test<7>
+()
+{
+    std::unique_ptr<geos::geom::Geometry> geom(wktreader.read("LINESTRING(0 0, 1 1)"));
+    std::size_t size = wkbwriter.getWKBSize(*geom);
+    std::vector<unsigned char> buf(size - 1, 0xAA);
+
+    try {
+        wkbwriter.write(*geom, buf.data(), buf.size());
+        fail("IllegalArgumentException expected");
+    }
+    catch(const geos::util::IllegalArgumentException&) {
+    }
+    ensure_equals(buf[0], 0xAA);
+
+    std::unique_ptr<geos::geom::Geometry> empty(wktreader.read("POINT EMPTY"));
+    try {
+        wkbwriter.getWKBSize(*empty);
+        fail("IllegalArgumentException expected");
+    }
+    catch(const geos::util::IllegalArgumentException&) {
+    }
+}
+
+} // namespace tut
@@ -12,6 +12,9 @@
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/util/IllegalArgumentException.h>
 // std
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 #include <memory>
@@ -193,4 +196,69 @@ void object::test<8>
     }
 }
 
+// 9 - Numbers are read exactly, including those that need more
+// than a double multiplication to convert
+template<>
+template<>
+void object::test<9>
+()
+{
+    geos::geom::GeometryFactory::Ptr floatGf = geos::geom::GeometryFactory::create();
+    geos::io::WKTReader reader(*floatGf);
+
+    const char* numbers[] = {
+        "0", "-0.5", "1e-7", "+12.5E3", "123456789012.123456",
+        "-122.4194154999999995", "37.1234566999999984",
+        "9007199254740993", "1.7976931348623157e308",
+        "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "1e23", "12e25", "0.000000000000000000000000000123",
+        "12345678901234567890123456789"
+    };
+    for(const char* n : numbers) {
+        std::string wkt = std::string("POINT(") + n + " 0)";
+        GeomPtr geom(reader.read(wkt));
+        double expected = std::strtod(n, nullptr);
+        ensure_equals(wkt, geom->getCoordinate()->x, expected);
+    }
+
+    GeomPtr geom(reader.read("POINT(inf -inf)"));
+    ensure(std::isinf(geom->getCoordinate()->x));
+    ensure(geom->getCoordinate()->y < 0);
+}
+
+// 10 - Reading does not depend on the C locale decimal separator
+template<>
+template<>
+void object::test<10>
+()
+{
+    geos::geom::GeometryFactory::Ptr floatGf = geos::geom::GeometryFactory::create();
+    geos::io::WKTReader reader(*floatGf);
+
+    std::string saved = std::setlocale(LC_NUMERIC, nullptr);
+    const char* locales[] = { "de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR" };
+    for(const char* l : locales) {
+        if(std::setlocale(LC_NUMERIC, l)) {
+            break;
+        }
+    }
+
+    // If none of the locales is installed this runs in the C locale
+    GeomPtr geom;
+    try {
+        geom.reset(reader.read("LINESTRING(1.5 2.25, 123456.789012345678 -0.1)"));
+    }
+    catch(...) {
+        std::setlocale(LC_NUMERIC, saved.c_str());
+        throw;
+    }
+    std::setlocale(LC_NUMERIC, saved.c_str());
+
+    auto coords = geom->getCoordinates();
+    ensure_equals(coords->getX(0), 1.5);
+    ensure_equals(coords->getY(0), 2.25);
+    ensure_equals(coords->getX(1), 123456.789012345678);
+    ensure_equals(coords->getY(1), -0.1);
+}
+
 } // namespace tut
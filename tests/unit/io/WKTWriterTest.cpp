@@ -9,7 +9,10 @@
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Coordinate.h>
 // std
+#include <clocale>
 #include <sstream>
 #include <string>
 #include <memory>
@@ -149,5 +152,74 @@ void object::test<5>
     ensure_equals(result, std::string("POINT (123000 654000)"));
 }
 
-} // namespace tut
+// 6 - Test number formatting: rounding, trimming and exponents
+template<>
+template<>
+void object::test<6>
+()
+{
+    GeometryFactory::Ptr floatGf = GeometryFactory::create();
+    geos::geom::Coordinate c(0.125, -2.5);
+    std::unique_ptr<geos::geom::Point> pt(floatGf->createPoint(c));
+
+    WKTWriter writer;
+    writer.setRoundingPrecision(2);
+    writer.setTrim(false);
+    // halfway cases round to even, as with printf
+    ensure_equals(writer.write(pt.get()), std::string("POINT (0.12 -2.50)"));
+
+    writer.setRoundingPrecision(0);
+    ensure_equals(writer.write(pt.get()), std::string("POINT (0 -2)"));
+
+    writer.setTrim(true);
+    writer.setRoundingPrecision(3);
+    ensure_equals(writer.write(pt.get()), std::string("POINT (0.125 -2.5)"));
+
+    c = geos::geom::Coordinate(1e-7, 123456789.0);
+    pt.reset(floatGf->createPoint(c));
+    writer.setRoundingPrecision(4);
+    ensure_equals(writer.write(pt.get()), std::string("POINT (1e-07 1.235e+08)"));
+
+    writer.setRoundingPrecision(-1);
+    c = geos::geom::Coordinate(0.1, 1.0 / 3.0);
+    pt.reset(floatGf->createPoint(c));
+    ensure_equals(writer.write(pt.get()),
+                  std::string("POINT (0.1 0.3333333333333333)"));
+}
 
+// 7 - Test output does not depend on the C locale
+template<>
+template<>
+void object::test<7>
+()
+{
+    GeometryFactory::Ptr floatGf = GeometryFactory::create();
+    WKTReader reader(*floatGf);
+    GeomPtr geom(reader.read("LINESTRING(1.5 2.25, 1e300 -0.1)"));
+
+    WKTWriter writer;
+    writer.setTrim(true);
+
+    std::string saved = std::setlocale(LC_NUMERIC, nullptr);
+    const char* locales[] = { "de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR" };
+    for(const char* l : locales) {
+        if(std::setlocale(LC_NUMERIC, l)) {
+            break;
+        }
+    }
+
+    // If none of the locales is installed this runs in the C locale
+    std::string result;
+    try {
+        result = writer.write(geom.get());
+    }
+    catch(...) {
+        std::setlocale(LC_NUMERIC, saved.c_str());
+        throw;
+    }
+    std::setlocale(LC_NUMERIC, saved.c_str());
+
+    ensure_equals(result, std::string("LINESTRING (1.5 2.25, 1e+300 -0.1)"));
+}
+
+} // namespace tut
@@ -0,0 +1,122 @@
+//
+// Test Suite for geos::math::DD
+// Ported from JTS junit/math/DDBasicTest.java
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/math/DD.h>
+// std
+#include <cmath>
+
+using geos::math::DD;
+
+namespace tut {
+//
+// Test Group
+//
+struct test_dd_data {
+    test_dd_data() {}
+
+    void
+    checkAddMult2(const DD& dd)
+    {
+        DD sum = dd + dd;
+        DD prod = dd * DD(2.0);
+        ensure_equals(prod.getHi(), sum.getHi());
+        ensure_equals(prod.getLo(), sum.getLo());
+    }
+
+    void
+    checkMultiplyDivide(const DD& a, const DD& b, double errBound)
+    {
+        DD a2 = (a * b) / b;
+        ensure("multiply/divide", std::fabs((a - a2).doubleValue()) <= errBound * std::fabs(a.doubleValue()));
+    }
+};
+
+typedef test_group<test_dd_data> group;
+typedef group::object object;
+
+group test_dd_group("geos::math::DD");
+
+//
+// Test Cases
+//
+
+// Values not exactly representable in double precision are kept
+template<>
+template<>
+void object::test<1>
+()
+{
+    DD one(1.0);
+    DD tiny(1e-20);
+    DD sum = one + tiny;
+
+    ensure_equals(sum.getHi(), 1.0);
+    ensure_equals(sum.getLo(), 1e-20);
+    ensure_equals((sum - one).doubleValue(), 1e-20);
+    ensure_equals(sum.doubleValue(), 1.0);
+}
+
+// Basic arithmetic identities
+template<>
+template<>
+void object::test<2>
+()
+{
+    checkAddMult2(DD(3.0));
+    checkAddMult2(DD(1.0) / DD(3.0));
+
+    checkMultiplyDivide(DD(1.0) / DD(3.0), DD(7.0), 1e-30);
+    checkMultiplyDivide(DD(123456789.0) / DD(11.0), DD(0.1), 1e-30);
+}
+
+// Reciprocal
+template<>
+template<>
+void object::test<3>
+()
+{
+    DD third = DD(3.0).reciprocal();
+    DD one = third * DD(3.0);
+    ensure(std::fabs((one - DD(1.0)).doubleValue()) < 1e-30);
+}
+
+// Sign and comparison
+template<>
+template<>
+void object::test<4>
+()
+{
+    DD a(1.0, 1e-20);
+    DD b(1.0, -1e-20);
+
+    ensure(b < a);
+    ensure(a > b);
+    ensure(a != b);
+    ensure_equals((a - b).signum(), 1);
+    ensure_equals((b - a).signum(), -1);
+    ensure_equals((a - a).signum(), 0);
+    ensure((a - a).isZero());
+    ensure((b - a).isNegative());
+}
+
+// Determinant of nearly-singular matrix is not lost to rounding
+template<>
+template<>
+void object::test<5>
+()
+{
+    double x = 1.0 + std::ldexp(1.0, -30);
+    double y = 1.0 - std::ldexp(1.0, -30);
+
+    // x * x - y * y == 2^-28, computed exactly
+    DD det = DD::determinant(x, y, y, x);
+    ensure_equals(det.doubleValue(), std::ldexp(1.0, -28));
+
+    // x * y - y * x is exactly zero
+    ensure(DD::determinant(x, y, x, y).isZero());
+}
+
+} // namespace tut
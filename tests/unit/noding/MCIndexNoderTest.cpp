@@ -0,0 +1,241 @@
+//
+// Test Suite for geos::noding::MCIndexNoder class.
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/PackedCoordinateSequence.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/IteratedNoder.h>
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/SegmentIntersectionDetector.h>
+#include <geos/noding/SegmentNode.h>
+#include <geos/noding/SegmentNodeList.h>
+// std
+#include <memory>
+#include <random>
+#include <vector>
+
+using geos::geom::Coordinate;
+using geos::noding::NodedSegmentString;
+using geos::noding::SegmentString;
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used by tests
+struct test_mcindexnoder_data {
+
+    std::vector<std::vector<Coordinate>> lines;
+
+    test_mcindexnoder_data()
+    {
+        std::default_random_engine e(4321);
+        std::uniform_real_distribution<> pos(0, 100);
+        for(int i = 0; i < 300; ++i) {
+            std::vector<Coordinate> pts;
+            for(int j = 0; j < 8; ++j) {
+                pts.emplace_back(pos(e), pos(e));
+            }
+            lines.push_back(pts);
+        }
+    }
+
+    // Segment strings over packed sequences, which build their
+    // Coordinate mirror on the first reference access
+    std::vector<std::unique_ptr<NodedSegmentString>>
+    makeSegmentStrings(std::size_t count = 0) const
+    {
+        if(count == 0 || count > lines.size()) {
+            count = lines.size();
+        }
+        std::vector<std::unique_ptr<NodedSegmentString>> ret;
+        for(std::size_t i = 0; i < count; ++i) {
+            ret.emplace_back(new NodedSegmentString(
+                                 new geos::geom::PackedCoordinateSequence(lines[i]), nullptr));
+        }
+        return ret;
+    }
+
+    static SegmentString::NonConstVect
+    toVect(const std::vector<std::unique_ptr<NodedSegmentString>>& ss)
+    {
+        SegmentString::NonConstVect ret;
+        for(const auto& s : ss) {
+            ret.push_back(s.get());
+        }
+        return ret;
+    }
+
+    static void
+    ensureSameNodes(const std::vector<std::unique_ptr<NodedSegmentString>>& a,
+                    const std::vector<std::unique_ptr<NodedSegmentString>>& b)
+    {
+        ensure_equals(a.size(), b.size());
+        for(std::size_t i = 0; i < a.size(); ++i) {
+            const geos::noding::SegmentNodeList& na = a[i]->getNodeList();
+            const geos::noding::SegmentNodeList& nb = b[i]->getNodeList();
+            ensure_equals(na.size(), nb.size());
+            auto ib = nb.begin();
+            for(auto ia = na.begin(); ia != na.end(); ++ia, ++ib) {
+                ensure_equals(ia->segmentIndex, ib->segmentIndex);
+                ensure(ia->coord.equals2D(ib->coord));
+            }
+        }
+    }
+
+    static void
+    deleteAll(SegmentString::NonConstVect* ss)
+    {
+        for(SegmentString* s : *ss) {
+            delete s;
+        }
+        delete ss;
+    }
+};
+
+typedef test_group<test_mcindexnoder_data> group;
+typedef group::object object;
+
+group test_mcindexnoder_group("geos::noding::MCIndexNoder");
+
+//
+// Test Cases
+//
+
+// Parallel noding finds the nodes of the serial noding
+template<>
+template<>
+void object::test<1>
+()
+{
+    geos::geom::PrecisionModel pm;
+
+    auto serial = makeSegmentStrings();
+    SegmentString::NonConstVect serialVect = toVect(serial);
+    geos::algorithm::LineIntersector li(&pm);
+    geos::noding::IntersectionAdder adder(li);
+    geos::noding::MCIndexNoder serialNoder;
+    serialNoder.setSegmentIntersector(&adder);
+    serialNoder.computeNodes(&serialVect);
+    ensure(adder.numInteriorIntersections > 0);
+
+    auto parallel = makeSegmentStrings();
+    SegmentString::NonConstVect parallelVect = toVect(parallel);
+    std::vector<std::unique_ptr<geos::algorithm::LineIntersector>> lis;
+    std::vector<std::unique_ptr<geos::noding::IntersectionAdder>> adders;
+    std::vector<geos::noding::SegmentIntersector*> intersectors;
+    for(int t = 0; t < 4; ++t) {
+        lis.emplace_back(new geos::algorithm::LineIntersector(&pm));
+        adders.emplace_back(new geos::noding::IntersectionAdder(*lis.back()));
+        intersectors.push_back(adders.back().get());
+    }
+    geos::noding::MCIndexNoder parallelNoder;
+    parallelNoder.setSegmentIntersectors(intersectors);
+    parallelNoder.computeNodes(&parallelVect);
+
+    int numInterior = 0;
+    for(const auto& a : adders) {
+        numInterior += a->numInteriorIntersections;
+    }
+    ensure_equals(numInterior, adder.numInteriorIntersections);
+    ensureSameNodes(serial, parallel);
+}
+
+// An intersector reporting isDone() stops the parallel noding early
+template<>
+template<>
+void object::test<2>
+()
+{
+    geos::geom::PrecisionModel pm;
+
+    auto crossing = makeSegmentStrings();
+    SegmentString::NonConstVect crossingVect = toVect(crossing);
+    std::vector<std::unique_ptr<geos::algorithm::LineIntersector>> lis;
+    std::vector<std::unique_ptr<geos::noding::SegmentIntersectionDetector>> detectors;
+    std::vector<geos::noding::SegmentIntersector*> intersectors;
+    for(int t = 0; t < 4; ++t) {
+        lis.emplace_back(new geos::algorithm::LineIntersector(&pm));
+        detectors.emplace_back(new geos::noding::SegmentIntersectionDetector(lis.back().get()));
+        intersectors.push_back(detectors.back().get());
+    }
+    geos::noding::MCIndexNoder noder;
+    noder.setSegmentIntersectors(intersectors);
+    noder.computeNodes(&crossingVect);
+
+    bool found = false;
+    for(const auto& d : detectors) {
+        found = found || d->hasIntersection();
+    }
+    ensure(found);
+
+    // disjoint lines: no intersector is ever done
+    std::vector<std::unique_ptr<NodedSegmentString>> disjoint;
+    for(int i = 0; i < 100; ++i) {
+        std::vector<Coordinate> pts;
+        pts.emplace_back(0, i);
+        pts.emplace_back(10, i);
+        pts.emplace_back(20, i + 0.5);
+        disjoint.emplace_back(new NodedSegmentString(
+                                  new geos::geom::CoordinateArraySequence(
+                                      new std::vector<Coordinate>(pts)), nullptr));
+    }
+    SegmentString::NonConstVect disjointVect = toVect(disjoint);
+    std::vector<std::unique_ptr<geos::noding::SegmentIntersectionDetector>> detectors2;
+    intersectors.clear();
+    for(int t = 0; t < 4; ++t) {
+        detectors2.emplace_back(new geos::noding::SegmentIntersectionDetector(lis[t].get()));
+        intersectors.push_back(detectors2.back().get());
+    }
+    geos::noding::MCIndexNoder noder2;
+    noder2.setSegmentIntersectors(intersectors);
+    noder2.computeNodes(&disjointVect);
+    for(const auto& d : detectors2) {
+        ensure(!d->hasIntersection());
+    }
+}
+
+// IteratedNoder gives the same noded substrings with several threads.
+// Twenty lines keep the iterations short.
+template<>
+template<>
+void object::test<3>
+()
+{
+    geos::geom::PrecisionModel pm;
+
+    auto serial = makeSegmentStrings(20);
+    SegmentString::NonConstVect serialVect = toVect(serial);
+    geos::noding::IteratedNoder serialNoder(&pm);
+    serialNoder.computeNodes(&serialVect);
+    SegmentString::NonConstVect* serialResult = serialNoder.getNodedSubstrings();
+
+    auto parallel = makeSegmentStrings(20);
+    SegmentString::NonConstVect parallelVect = toVect(parallel);
+    geos::noding::IteratedNoder parallelNoder(&pm);
+    parallelNoder.setNumThreads(4);
+    parallelNoder.computeNodes(&parallelVect);
+    SegmentString::NonConstVect* parallelResult = parallelNoder.getNodedSubstrings();
+
+    ensure_equals(parallelResult->size(), serialResult->size());
+    for(std::size_t i = 0; i < serialResult->size(); ++i) {
+        const geos::geom::CoordinateSequence* a = (*serialResult)[i]->getCoordinates();
+        const geos::geom::CoordinateSequence* b = (*parallelResult)[i]->getCoordinates();
+        ensure_equals(a->size(), b->size());
+        for(std::size_t j = 0; j < a->size(); ++j) {
+            ensure(a->getAt(j).equals2D(b->getAt(j)));
+        }
+    }
+
+    deleteAll(serialResult);
+    deleteAll(parallelResult);
+}
+
+} // namespace tut
@@ -235,6 +235,68 @@ void object::test<5>
 
 }
 
+// nodes added out of order are iterated in order along the string
+template<>
+template<>
+void object::test<6>
+()
+{
+    geos::geom::Coordinate p0(0, 0);
+    geos::geom::Coordinate p1(10, 0);
+    geos::geom::Coordinate p2(20, 0);
+
+    CoordinateSequenceAutoPtr cs(csFactory->create((size_t)0, 2));
+    cs->add(p0);
+    cs->add(p1);
+    cs->add(p2);
+
+    SegmentStringAutoPtr ss(makeSegmentString(cs.release()));
+
+    ss->addIntersection(geos::geom::Coordinate(15, 0), 1);
+    ss->addIntersection(geos::geom::Coordinate(5, 0), 0);
+    ss->addIntersection(geos::geom::Coordinate(2, 0), 0);
+    ss->addIntersection(geos::geom::Coordinate(5, 0), 0);
+
+    const geos::noding::SegmentNodeList& nodes = ss->getNodeList();
+    ensure_equals(nodes.size(), 3u);
+
+    geos::noding::SegmentNodeList::const_iterator it = nodes.begin();
+    ensure_equals(it->coord.x, 2.0);
+    ++it;
+    ensure_equals(it->coord.x, 5.0);
+    ++it;
+    ensure_equals(it->coord.x, 15.0);
+
+    // adding after an ordered access sorts again
+    ss->addIntersection(geos::geom::Coordinate(12, 0), 1);
+    ensure_equals(nodes.size(), 4u);
+    ensure_equals((nodes.begin() + 3)->coord.x, 15.0);
+}
+
+// repeated nodes, in a row or not, leave one node each
+template<>
+template<>
+void object::test<7>
+()
+{
+    CoordinateSequenceAutoPtr cs(csFactory->create((size_t)0, 2));
+    cs->add(geos::geom::Coordinate(0, 0));
+    cs->add(geos::geom::Coordinate(10, 0));
+
+    SegmentStringAutoPtr ss(makeSegmentString(cs.release()));
+
+    for(int i = 0; i < 1000; ++i) {
+        ss->addIntersection(geos::geom::Coordinate(7, 0), 0);
+        ss->addIntersection(geos::geom::Coordinate(7, 0), 0);
+        ss->addIntersection(geos::geom::Coordinate(3, 0), 0);
+    }
+
+    const geos::noding::SegmentNodeList& nodes = ss->getNodeList();
+    ensure_equals(nodes.size(), 2u);
+    ensure_equals(nodes.begin()->coord.x, 3.0);
+    ensure_equals((nodes.begin() + 1)->coord.x, 7.0);
+}
+
 // TODO: test getting noded substrings
 //  template<>
 //  template<>
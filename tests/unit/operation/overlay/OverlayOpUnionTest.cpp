@@ -10,6 +10,7 @@
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTReader.h>
 // std
+#include <cmath>
 #include <string>
 #include <memory>
 
@@ -62,4 +63,35 @@ void object::test<1>
     // See LineMergerTest where the test triangle is generated as a single LineString.
 }
 
+// 2 - Z is only computed when an input has Z
+template<>
+template<>
+void object::test<2>
+()
+{
+    GeometryFactoryPtr factory = geos::geom::GeometryFactory::create();
+    geos::io::WKTReader reader(*factory);
+    GeometryPtr line2d(reader.read("LINESTRING(5 -5, 5 5)"));
+    GeometryPtr other2d(reader.read("LINESTRING(0 0, 10 0)"));
+    GeometryPtr other3d(reader.read("LINESTRING(0 0 10, 10 0 20)"));
+
+    GeometryPtr result2d(line2d->Union(other2d.get()));
+    ensure_equals(result2d->getNumPoints(), 8u);
+    auto cs2d = result2d->getCoordinates();
+    for(size_t i = 0; i < cs2d->size(); ++i) {
+        ensure(std::isnan(cs2d->getAt(i).z));
+    }
+
+    GeometryPtr result3d(line2d->Union(other3d.get()));
+    ensure_equals(result3d->getNumPoints(), 8u);
+    auto cs3d = result3d->getCoordinates();
+    for(size_t i = 0; i < cs3d->size(); ++i) {
+        const Coordinate& c = cs3d->getAt(i);
+        ensure(!std::isnan(c.z));
+        if(c.x == 5 && c.y == 0) {
+            ensure_equals(c.z, 15.0);
+        }
+    }
+}
+
 } // namespace tut
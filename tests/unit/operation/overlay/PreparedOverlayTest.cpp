@@ -0,0 +1,141 @@
+//
+// Test Suite for geos::operation::overlay::PreparedOverlay class
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/operation/overlay/PreparedOverlay.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <string>
+#include <memory>
+
+using geos::operation::overlay::PreparedOverlay;
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_preparedoverlay_data {
+    typedef geos::geom::Geometry::Ptr GeometryPtr;
+
+    geos::geom::GeometryFactory::Ptr factory;
+    geos::io::WKTReader reader;
+
+    test_preparedoverlay_data()
+        : factory(geos::geom::GeometryFactory::create())
+        , reader(*factory)
+    {}
+
+    void
+    ensure_same(GeometryPtr result, GeometryPtr expected)
+    {
+        result->normalize();
+        expected->normalize();
+        ensure(result->toString() + " != " + expected->toString(),
+               result->equalsExact(expected.get()));
+    }
+};
+
+typedef test_group<test_preparedoverlay_data> group;
+typedef group::object object;
+
+group test_preparedoverlay_group("geos::operation::overlay::PreparedOverlay");
+
+//
+// Test Cases
+//
+
+// 1 - Repeated intersections and differences with a polygon with a hole
+template<>
+template<>
+void object::test<1>
+()
+{
+    GeometryPtr base(reader.read(
+                         "POLYGON ((0 0, 100 0, 100 100, 0 100, 0 0), (40 40, 60 40, 60 60, 40 60, 40 40))"));
+    PreparedOverlay prep(*base);
+
+    const char* others[] = {
+        "POLYGON ((-10 -10, 10 -10, 10 10, -10 10, -10 -10))",
+        "POLYGON ((30 30, 70 30, 70 70, 30 70, 30 30))",
+        "POLYGON ((45 45, 55 45, 55 55, 45 55, 45 45))",
+        "LINESTRING (-10 50, 110 50)",
+        "POLYGON ((200 200, 210 200, 210 210, 200 200))",
+        "MULTIPOINT ((50 50), (20 20), (0 50))"
+    };
+
+    for(const char* wkt : others) {
+        GeometryPtr other(reader.read(wkt));
+        ensure_same(prep.intersection(*other), base->intersection(other.get()));
+        ensure_same(prep.difference(*other), base->difference(other.get()));
+    }
+}
+
+// 2 - Self-intersecting lines are noded once and reused
+template<>
+template<>
+void object::test<2>
+()
+{
+    GeometryPtr base(reader.read(
+                         "MULTILINESTRING ((0 0, 10 10, 10 0, 0 10), (5 -5, 5 15))"));
+    PreparedOverlay prep(*base);
+
+    const char* others[] = {
+        "POLYGON ((2 2, 8 2, 8 8, 2 8, 2 2))",
+        "LINESTRING (0 5, 10 5)",
+        "POLYGON ((4 -10, 6 -10, 6 20, 4 20, 4 -10))"
+    };
+
+    for(int i = 0; i < 2; ++i) {
+        for(const char* wkt : others) {
+            GeometryPtr other(reader.read(wkt));
+            ensure_same(prep.intersection(*other), base->intersection(other.get()));
+            ensure_same(prep.difference(*other), base->difference(other.get()));
+            ensure_same(prep.overlay(*other, geos::operation::overlay::OverlayOp::opUNION),
+                        base->Union(other.get()));
+        }
+    }
+}
+
+// 3 - A more precise other operand is still overlaid correctly
+template<>
+template<>
+void object::test<3>
+()
+{
+    geos::geom::PrecisionModel pm(1.0);
+    geos::geom::GeometryFactory::Ptr fixedFactory =
+        geos::geom::GeometryFactory::create(&pm);
+    geos::io::WKTReader fixedReader(*fixedFactory);
+
+    GeometryPtr base(fixedReader.read("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))"));
+    PreparedOverlay prep(*base);
+
+    GeometryPtr other(reader.read("POLYGON ((5.5 5.5, 15.5 5.5, 15.5 15.5, 5.5 15.5, 5.5 5.5))"));
+    ensure_same(prep.intersection(*other), base->intersection(other.get()));
+}
+
+// 4 - Empty operands
+template<>
+template<>
+void object::test<4>
+()
+{
+    GeometryPtr base(reader.read("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))"));
+    PreparedOverlay prep(*base);
+
+    GeometryPtr empty(reader.read("POLYGON EMPTY"));
+    ensure(prep.intersection(*empty)->isEmpty());
+    ensure(prep.difference(*empty)->equalsExact(base.get()));
+
+    PreparedOverlay emptyPrep(*empty);
+    ensure(emptyPrep.intersection(*base)->isEmpty());
+    ensure(emptyPrep.difference(*base)->isEmpty());
+}
+
+} // namespace tut
@@ -0,0 +1,192 @@
+//
+// Test Suite for geos::operation::overlay::snap::SnapRoundingOverlayOp class
+
+#include <tut/tut.hpp>
+// geos
+#include <geos/operation/overlay/snap/SnapRoundingOverlayOp.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <cmath>
+#include <string>
+#include <memory>
+
+using geos::operation::overlay::OverlayOp;
+using geos::operation::overlay::snap::SnapRoundingOverlayOp;
+
+namespace tut {
+//
+// Test Group
+//
+
+struct test_snaproundingoverlayop_data {
+    typedef geos::geom::Geometry::Ptr GeometryPtr;
+
+    geos::geom::GeometryFactory::Ptr factory;
+    geos::io::WKTReader reader;
+
+    test_snaproundingoverlayop_data()
+        : factory(geos::geom::GeometryFactory::create())
+        , reader(*factory)
+    {}
+
+    static void
+    ensure_on_grid(const geos::geom::Geometry& g)
+    {
+        std::unique_ptr<geos::geom::CoordinateSequence> pts(g.getCoordinates());
+        for(std::size_t i = 0; i < pts->size(); ++i) {
+            ensure_equals(pts->getX(i), std::round(pts->getX(i)));
+            ensure_equals(pts->getY(i), std::round(pts->getY(i)));
+        }
+    }
+
+    void
+    ensure_same(GeometryPtr result, const std::string& expectedWKT)
+    {
+        GeometryPtr expected(reader.read(expectedWKT));
+        result->normalize();
+        expected->normalize();
+        ensure(result->toString() + " != " + expected->toString(),
+               result->equalsExact(expected.get()));
+    }
+};
+
+typedef test_group<test_snaproundingoverlayop_data> group;
+typedef group::object object;
+
+group test_snaproundingoverlayop_group("geos::operation::overlay::snap::SnapRoundingOverlayOp");
+
+//
+// Test Cases
+//
+
+// 1 - Overlays of polygons off the grid are computed on the grid
+template<>
+template<>
+void object::test<1>
+()
+{
+    geos::geom::PrecisionModel pm(1.0);
+    GeometryPtr a(reader.read("POLYGON ((0.2 0.1, 10.1 -0.2, 9.8 10.3, -0.1 9.9, 0.2 0.1))"));
+    GeometryPtr b(reader.read("POLYGON ((5.1 4.8, 15.3 5.2, 14.9 15.1, 4.9 14.7, 5.1 4.8))"));
+
+    ensure_same(a->intersection(b.get(), pm),
+                "POLYGON ((5 5, 5 10, 10 10, 10 5, 5 5))");
+    ensure_same(a->Union(b.get(), pm),
+                "POLYGON ((0 0, 0 10, 5 10, 5 15, 15 15, 15 5, 10 5, 10 0, 0 0))");
+    ensure_same(a->difference(b.get(), pm),
+                "POLYGON ((0 0, 0 10, 5 10, 5 5, 10 5, 10 0, 0 0))");
+    ensure_same(a->symDifference(b.get(), pm),
+                "MULTIPOLYGON (((0 0, 0 10, 5 10, 5 5, 10 5, 10 0, 0 0)), ((10 5, 10 10, 5 10, 5 15, 15 15, 15 5, 10 5)))");
+}
+
+// 2 - Intersections off the grid are snapped to it
+template<>
+template<>
+void object::test<2>
+()
+{
+    geos::geom::PrecisionModel pm(10.0);
+    GeometryPtr a(reader.read("LINESTRING (0 0, 10 3)"));
+    GeometryPtr b(reader.read("LINESTRING (0 3, 10 0)"));
+
+    ensure_same(a->Union(b.get(), pm),
+                "MULTILINESTRING ((0 0, 5 1.5), (5 1.5, 10 3), (0 3, 5 1.5), (5 1.5, 10 0))");
+}
+
+// 3 - Polygons collapsing on a coarse grid are dropped
+template<>
+template<>
+void object::test<3>
+()
+{
+    geos::geom::PrecisionModel pm(1.0);
+    GeometryPtr a(reader.read("POLYGON ((0 0, 10 0, 10 0.2, 0 0.2, 0 0))"));
+    GeometryPtr b(reader.read("POLYGON ((4.1 -5, 6 -5, 6 5, 3.9 5, 4.1 -5))"));
+
+    ensure(a->intersection(b.get(), pm)->isEmpty());
+    ensure(a->difference(b.get(), pm)->isEmpty());
+    ensure_same(a->Union(b.get(), pm), "POLYGON ((4 -5, 4 5, 6 5, 6 -5, 4 -5))");
+
+    GeometryPtr c(reader.read("POLYGON ((20 20, 20.3 20, 20.3 20.3, 20 20))"));
+    ensure_same(b->symDifference(c.get(), pm), "POLYGON ((4 -5, 4 5, 6 5, 6 -5, 4 -5))");
+}
+
+// 4 - Nearly coincident edges, which need snapping heuristics
+//     in floating precision
+template<>
+template<>
+void object::test<4>
+()
+{
+    geos::geom::PrecisionModel pm(1000.0);
+    GeometryPtr a(reader.read(
+                      "POLYGON ((0 0, 1 0.0000000001, 2 0, 2 1, 0 1, 0 0))"));
+    GeometryPtr b(reader.read(
+                      "POLYGON ((0.5 -1, 1.5 -1, 1.5 0.0000000002, 1 0, 0.5 0.0000000001, 0.5 -1))"));
+
+    ensure_same(a->intersection(b.get(), pm),
+                "MULTILINESTRING ((0.5 0, 1 0), (1 0, 1.5 0))");
+    ensure_same(a->Union(b.get(), pm),
+                "POLYGON ((0 0, 0 1, 2 1, 2 0, 1.5 0, 1.5 -1, 0.5 -1, 0.5 0, 0 0))");
+}
+
+// 5 - A floating precision model is rejected
+template<>
+template<>
+void object::test<5>
+()
+{
+    geos::geom::PrecisionModel pm;
+    GeometryPtr a(reader.read("POLYGON ((0 0, 1 0, 1 1, 0 0))"));
+    try {
+        a->intersection(a.get(), pm);
+        fail("IllegalArgumentException expected");
+    }
+    catch(const geos::util::IllegalArgumentException&) {
+    }
+}
+
+// 6 - Inputs whose noding does not settle on the grid still
+//     give valid results on it
+template<>
+template<>
+void object::test<6>
+()
+{
+    geos::geom::PrecisionModel pm(1.0);
+    GeometryPtr a(reader.read(
+                      "POLYGON ((5.8 5, 5.3 7.4, 3.4 5.9, 1.2 5, 2.5 2.6, 4 4.8, 5.8 5))"));
+    GeometryPtr b(reader.read(
+                      "POLYGON ((1 4, 1.7 5.8, 0 5.2, -1.8 4, -0.7 1.6, 1.6 2.4, 1 4))"));
+
+    for(int op = OverlayOp::opINTERSECTION; op <= OverlayOp::opSYMDIFFERENCE; ++op) {
+        GeometryPtr result = SnapRoundingOverlayOp::overlayOp(
+                                 *a, *b, static_cast<OverlayOp::OpCode>(op), pm);
+        ensure(result->isValid());
+        ensure_on_grid(*result);
+    }
+}
+
+// 7 - A collapsed shell drops its holes without the noded rings
+//     of the later polygons being shifted onto other rings
+template<>
+template<>
+void object::test<7>
+()
+{
+    geos::geom::PrecisionModel pm(1.0);
+    GeometryPtr a(reader.read(
+                      "MULTIPOLYGON (((0 0, 10 0, 5 0.4, 0 0), (4 0.1, 6 0.1, 5 0.3, 4 0.1)), "
+                      "((20 20, 30 20, 30 30, 20 30, 20 20)))"));
+    GeometryPtr b(reader.read("POLYGON ((50 50, 60 50, 60 60, 50 60, 50 50))"));
+
+    ensure_same(SnapRoundingOverlayOp::overlayOp(*a, *b, OverlayOp::opUNION, pm),
+                "MULTIPOLYGON (((20 20, 20 30, 30 30, 30 20, 20 20)), ((50 50, 50 60, 60 60, 60 50, 50 50)))");
+}
+
+} // namespace tut
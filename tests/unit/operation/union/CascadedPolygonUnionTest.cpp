@@ -12,6 +12,7 @@
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKTWriter.h>
 // std
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -119,7 +120,7 @@ void object::test<1>
 }
 
 void
-create_discs(geos::geom::GeometryFactory& gf, int num, double radius,
+create_discs(const geos::geom::GeometryFactory& gf, int num, double radius,
              std::vector<geos::geom::Polygon*>* g)
 {
     for(int i = 0; i < num; ++i) {
@@ -160,5 +161,49 @@ create_discs(geos::geom::GeometryFactory& gf, int num, double radius,
 //         std::for_each(g.begin(), g.end(), delete_geometry);
 //     }
 
+// Parallel union gives the same result as the sequential one
+template<>
+template<>
+void object::test<4>
+()
+{
+    using geos::operation::geounion::CascadedPolygonUnion;
+
+    std::vector<geos::geom::Polygon*> g;
+    create_discs(gf, 20, 0.7, &g);
+
+    std::unique_ptr<geos::geom::Geometry> sequential(CascadedPolygonUnion::Union(&g));
+    const std::size_t threadCounts[] = {2, 4, 16};
+    for(std::size_t numThreads : threadCounts) {
+        std::unique_ptr<geos::geom::Geometry> parallel(
+            CascadedPolygonUnion::Union(&g, numThreads));
+        ensure(parallel->equalsExact(sequential.get()));
+    }
+
+    std::for_each(g.begin(), g.end(), delete_geometry);
+}
+
+// Parallel union of a single polygon and of disjoint polygons
+template<>
+template<>
+void object::test<5>
+()
+{
+    using geos::operation::geounion::CascadedPolygonUnion;
+
+    std::vector<geos::geom::Polygon*> g;
+    create_discs(gf, 1, 0.5, &g);
+
+    std::unique_ptr<geos::geom::Geometry> u(CascadedPolygonUnion::Union(&g, 4));
+    ensure(u->equalsExact(g[0]));
+
+    create_discs(gf, 3, 0.25, &g);
+    u.reset(CascadedPolygonUnion::Union(&g, 4));
+    std::unique_ptr<geos::geom::Geometry> expected(CascadedPolygonUnion::Union(&g));
+    ensure(u->equalsExact(expected.get()));
+
+    std::for_each(g.begin(), g.end(), delete_geometry);
+}
+
 } // namespace tut
 
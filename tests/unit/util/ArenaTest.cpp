@@ -0,0 +1,267 @@
+//
+// Test Suite for geos::util::Arena class.
+
+// tut
+#include <tut/tut.hpp>
+// geos
+#include <geos/util/Arena.h>
+#include <geos/geom/ArenaCoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tut {
+//
+// Test Group
+//
+
+// Common data used in test cases.
+struct test_arena_data {
+    typedef std::unique_ptr<geos::geom::Geometry> GeometryPtr;
+    typedef geos::geom::GeometryFactory GeometryFactory;
+
+    geos::util::Arena arena_;
+    geos::geom::PrecisionModel pm_;
+    GeometryFactory::Ptr factory_;
+    geos::io::WKTReader reader_;
+
+    test_arena_data()
+        : arena_(1024)
+        , factory_(GeometryFactory::create(&pm_, 0, arena_))
+        , reader_(factory_.get())
+    {}
+};
+
+typedef test_group<test_arena_data> group;
+typedef group::object object;
+
+group test_arena_group("geos::util::Arena");
+
+//
+// Test Cases
+//
+
+// Raw allocations are aligned and spill over into new blocks
+template<>
+template<>
+void object::test<1>
+()
+{
+    geos::util::Arena arena(64);
+
+    void* a = arena.allocate(1);
+    void* b = arena.allocate(100);
+    void* c = arena.allocate(8);
+
+    ensure_equals(reinterpret_cast<std::size_t>(a) % alignof(std::max_align_t), 0u);
+    ensure_equals(reinterpret_cast<std::size_t>(b) % alignof(std::max_align_t), 0u);
+    ensure_equals(reinterpret_cast<std::size_t>(c) % alignof(std::max_align_t), 0u);
+    ensure(arena.getBytesUsed() >= 109);
+
+    std::size_t reserved = arena.getBytesReserved();
+    arena.release();
+    ensure_equals(arena.getBytesUsed(), 0u);
+
+    // released memory is reused
+    arena.allocate(1);
+    arena.allocate(100);
+    ensure_equals(arena.getBytesReserved(), reserved);
+}
+
+// Geometries read and computed through an arena factory live in the arena
+template<>
+template<>
+void object::test<2>
+()
+{
+    {
+        GeometryPtr a(reader_.read("POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0))"));
+        GeometryPtr b(reader_.read("POLYGON ((5 5, 15 5, 15 15, 5 15, 5 5))"));
+        ensure(arena_.getNumLiveObjects() >= 6);
+
+        std::size_t live = arena_.getNumLiveObjects();
+        GeometryPtr isect(a->intersection(b.get()));
+        ensure_equals(isect->getArea(), 25.0);
+        ensure(arena_.getNumLiveObjects() > live);
+
+        // clones go to the heap and are freed normally
+        GeometryPtr copy(isect->clone());
+        ensure(copy->equals(isect.get()));
+    }
+    ensure_equals(arena_.getNumLiveObjects(), 0u);
+    ensure(arena_.getBytesUsed() > 0);
+
+    arena_.release();
+    ensure_equals(arena_.getBytesUsed(), 0u);
+}
+
+// Releasing with live objects abandons them
+template<>
+template<>
+void object::test<3>
+()
+{
+    std::unique_ptr<geos::geom::Point> pt(
+        factory_->createPoint(geos::geom::Coordinate(1, 2)));
+    GeometryPtr line(reader_.read("LINESTRING (0 0, 1 1, 2 0)"));
+    ensure_equals(factory_->getArena(), &arena_);
+
+    // a heap clone does not depend on the arena
+    GeometryPtr copy(line->clone());
+
+    arena_.release();
+    ensure_equals(arena_.getNumLiveObjects(), 0u);
+    ensure_equals(arena_.getBytesUsed(), 0u);
+    pt.release();
+    line.release();
+
+    ensure_equals(copy->getLength(), 2 * std::sqrt(2.0));
+    GeometryPtr again(reader_.read("POINT (3 4)"));
+    ensure_equals(arena_.getNumLiveObjects(), 2u);
+}
+
+// The memory of deleted objects is reused for objects of the same size
+template<>
+template<>
+void object::test<4>
+()
+{
+    GeometryPtr a(reader_.read("LINESTRING (0 0, 1 1)"));
+    const void* addr = a.get();
+    a.reset();
+    std::size_t used = arena_.getBytesUsed();
+
+    for(int i = 0; i < 10; ++i) {
+        GeometryPtr b(reader_.read("LINESTRING (0 0, 1 1)"));
+        ensure(b.get() == addr);
+    }
+    ensure_equals(arena_.getBytesUsed(), used);
+    ensure_equals(arena_.getNumLiveObjects(), 0u);
+}
+
+// Coordinates of arena geometries are in the arena too
+template<>
+template<>
+void object::test<5>
+()
+{
+    GeometryPtr line(reader_.read("LINESTRING (0 0, 1 1, 2 0, 3 1, 4 0)"));
+    std::unique_ptr<geos::geom::CoordinateSequence> heapCopy(line->getCoordinates());
+    ensure(dynamic_cast<const geos::geom::CoordinateArraySequence*>(heapCopy.get()) != nullptr);
+
+    std::unique_ptr<geos::geom::CoordinateSequence> seq(
+        factory_->getCoordinateSequenceFactory()->create(*heapCopy));
+    ensure(dynamic_cast<geos::geom::ArenaCoordinateSequence*>(seq.get()) != nullptr);
+
+    std::size_t used = arena_.getBytesUsed();
+    for(int i = 0; i < 100; ++i) {
+        seq->add(geos::geom::Coordinate(i, i));
+    }
+    ensure(arena_.getBytesUsed() >= used + 100 * sizeof(geos::geom::Coordinate));
+    ensure_equals(seq->size(), 105u);
+    ensure_equals(seq->getAt(104), geos::geom::Coordinate(99, 99));
+    ensure_equals(seq->getDimension(), 2u);
+
+    seq->add(0, geos::geom::Coordinate(-1, -1), false);
+    ensure_equals(seq->getAt(0), geos::geom::Coordinate(-1, -1));
+    ensure_equals(seq->getAt(1), geos::geom::Coordinate(0, 0));
+
+    std::vector<geos::geom::Coordinate> out;
+    seq->toVector(out);
+    ensure_equals(out.size(), 106u);
+
+    // geometries from the heap have no arena header in front of them
+    std::unique_ptr<geos::geom::Point> heapPt(
+        GeometryFactory::getDefaultInstance()->createPoint(geos::geom::Coordinate(1, 2)));
+    ensure(reinterpret_cast<std::size_t>(heapPt.get()) % (2 * geos::util::Arena::OBJECT_ALIGNMENT) == 0);
+    ensure(reinterpret_cast<std::size_t>(line.get()) % (2 * geos::util::Arena::OBJECT_ALIGNMENT) != 0);
+}
+
+// Copies of geometries from another factory are built with the arena
+// factory, down to their coordinates
+template<>
+template<>
+void object::test<6>
+()
+{
+    GeometryFactory::Ptr heapFactory(GeometryFactory::create());
+    geos::io::WKTReader heapReader(heapFactory.get());
+    GeometryPtr line(heapReader.read("LINESTRING (0 0, 1 1, 2 0)"));
+    GeometryPtr poly(heapReader.read("POLYGON ((0 0, 9 0, 9 9, 0 0), (1 1, 2 1, 2 2, 1 1))"));
+    std::vector<geos::geom::Geometry*> lines(1, line.get());
+    std::vector<geos::geom::Geometry*> polys(1, poly.get());
+
+    std::unique_ptr<geos::geom::LineString> ls(
+        factory_->createLineString(dynamic_cast<const geos::geom::LineString&>(*line)));
+    ensure(ls->getFactory() == factory_.get());
+    ensure(ls->equalsExact(line.get()));
+    ensure_equals(arena_.getNumLiveObjects(), 2u);
+
+    GeometryPtr mls(factory_->createMultiLineString(lines));
+    ensure(mls->getGeometryN(0)->getFactory() == factory_.get());
+    ensure_equals(arena_.getNumLiveObjects(), 5u);
+
+    GeometryPtr mp(factory_->createMultiPolygon(polys));
+    ensure(mp->getGeometryN(0)->equalsExact(poly.get()));
+    ensure_equals(arena_.getNumLiveObjects(), 5u + 6u);
+
+    // nothing of the copies is left on the heap
+    ls.release();
+    mls.release();
+    mp.release();
+    arena_.release();
+    ensure_equals(arena_.getNumLiveObjects(), 0u);
+}
+
+// Owned objects are destroyed by release(), with what they hold
+// outside the arena, such as the component lists of geometries
+template<>
+template<>
+void object::test<7>
+()
+{
+    struct Counted {
+        int* destroyed;
+        ~Counted()
+        {
+            ++*destroyed;
+        }
+    };
+    int destroyed = 0;
+    Counted* a = arena_.newOwned<Counted>(Counted{&destroyed});
+    arena_.newOwned<Counted>(Counted{&destroyed});
+    arena_.newOwned<Counted>(Counted{&destroyed});
+    destroyed = 0;
+    arena_.deleteOwned(a);
+    ensure_equals(destroyed, 1);
+    arena_.release();
+    ensure_equals(destroyed, 3);
+
+    const std::string wkt =
+        "MULTIPOLYGON (((0 0, 9 0, 9 9, 0 0), (1 1, 2 1, 2 2, 1 1)), "
+        "((20 20, 30 20, 30 30, 20 20)))";
+    GeometryPtr mp(reader_.read(wkt));
+    GeometryPtr copy(mp->clone());
+
+    // abandoned geometries leave nothing behind, clones are unaffected
+    mp.release();
+    arena_.release();
+    GeometryPtr again(reader_.read(wkt));
+    ensure(copy->equalsExact(again.get()));
+    again.reset();
+    ensure_equals(arena_.getNumLiveObjects(), 0u);
+}
+
+} // namespace tut